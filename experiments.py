@@ -6,6 +6,7 @@ import errno
 import subprocess
 import shlex
 import json
+import struct
 import pandas as pd
 import numpy as np
 import matplotlib
@@ -90,7 +91,7 @@ def generateConfig(buildDir, experiment, robots, targets, i):
             "targets" : targets,
             "log" : {
                 "path" : buildDir + "/results/" + experiment,
-                "name" : "r" + str(robots) + "t" + str(targets) + "_" + str(i) + ".json"
+                "name" : "r" + str(robots) + "t" + str(targets) + "_" + str(i) + ".log"
                 }
             }
 
@@ -130,11 +131,126 @@ def runExperiment(cmake, config, debugMode, verbose):
     sys.stdout.write("\033[F")
 
 
+RUN_LOG_MAGIC = b"CSRL"
+RUN_LOG_TARGET = 1
+RUN_LOG_THRESHOLD = 2
+RUN_LOG_CLOSEST = 3
+
+
+def readRunLog(data):
+    """Decodes a binary run log into the dictionary the JSON logs used to hold"""
+    _, sections = struct.unpack_from("<HH", data, 4)
+    closest, thresholds, targets = [], [], {}
+    offset = 8
+    while offset + 9 <= len(data):
+        size, step, eventType = struct.unpack_from("<IIB", data, offset)
+        offset += 9
+        if offset + size > len(data):
+            break
+        if eventType == RUN_LOG_TARGET:
+            id, x, y, z = struct.unpack_from("<iddd", data, offset)
+            if id not in targets:
+                targets[id] = {"id": id, "step": step, "position": [x, y, z]}
+        elif eventType == RUN_LOG_THRESHOLD:
+            coverage, = struct.unpack_from("<d", data, offset)
+            thresholds.append({"step": step, "coverage": round(coverage, 2)})
+        elif eventType == RUN_LOG_CLOSEST:
+            distance, = struct.unpack_from("<d", data, offset)
+            if closest and closest[-1]["step"] == step:
+                closest[-1]["distance"] = distance
+            else:
+                closest.append({"step": step, "distance": distance})
+        offset += size
+    logData = {}
+    if sections & (1 << RUN_LOG_CLOSEST):
+        logData["closest"] = closest
+    if sections & (1 << RUN_LOG_THRESHOLD):
+        logData["thresholds"] = thresholds
+    if sections & (1 << RUN_LOG_TARGET):
+        logData["targets"] = [targets[id] for id in sorted(targets)]
+    return logData
+
+
 def getLogData(logConfig):
     file = logConfig["path"] + "/" + logConfig["name"]
-    with open(file, mode='r') as jsonFile:
-        jsonData = json.load(jsonFile)
-    return jsonData
+    with open(file, mode='rb') as logFile:
+        data = logFile.read()
+    if data[:4] == RUN_LOG_MAGIC:
+        return readRunLog(data)
+    return json.loads(data.decode())
+
+
+SUMMARY_MAGIC = b"CSSM"
+SUMMARY_UINT32 = 1
+SUMMARY_DOUBLE = 2
+SUMMARY_STRING = 3
+
+
+def readSummary(file):
+    """Loads the columnar summary written by the aggregate_results tool"""
+    with open(file, mode='rb') as summaryFile:
+        data = summaryFile.read()
+    if data[:4] != SUMMARY_MAGIC:
+        raise ValueError(file + " is not a results summary")
+    _, columns, rows = struct.unpack_from("<HHI", data, 4)
+    offset = 12
+    names = []
+    frame = {}
+    for _ in range(columns):
+        columnType, nameSize = struct.unpack_from("<BB", data, offset)
+        offset += 2
+        name = data[offset:offset + nameSize].decode()
+        offset += nameSize
+        if columnType == SUMMARY_UINT32:
+            frame[name] = np.frombuffer(data, dtype="<u4", count=rows, offset=offset)
+            offset += 4 * rows
+        elif columnType == SUMMARY_DOUBLE:
+            frame[name] = np.frombuffer(data, dtype="<f8", count=rows, offset=offset)
+            offset += 8 * rows
+        elif columnType == SUMMARY_STRING:
+            dictionarySize, = struct.unpack_from("<H", data, offset)
+            offset += 2
+            dictionary = []
+            for _ in range(dictionarySize):
+                size, = struct.unpack_from("<B", data, offset)
+                dictionary.append(data[offset + 1:offset + 1 + size].decode())
+                offset += 1 + size
+            codes = np.frombuffer(data, dtype="<u2", count=rows, offset=offset)
+            offset += 2 * rows
+            frame[name] = np.array(dictionary, dtype=object)[codes]
+        else:
+            raise ValueError("Unknown column type in " + file)
+        names.append(name)
+    return pd.DataFrame(frame, columns=names)
+
+
+def aggregateResults(cmake):
+    cmake.build("aggregate_results")
+    resultsDir = cmake.buildDir + "/results"
+    aggregateCmd = [cmake.buildDir + "/bin/tools/aggregate_results", resultsDir]
+    proc = subprocess.Popen(aggregateCmd, stdout=cmake.stdout, stderr=cmake.stderr)
+    outs, errs = proc.communicate()
+    if proc.returncode:
+        print "Error!"
+        print errs
+        exit(-1)
+    return readSummary(resultsDir + "/summary.bin")
+
+
+def getSummaryRows(summary, experiment, robots, targets, metric):
+    rows = summary[(summary["experiment"] == experiment) &
+                   (summary["robots"] == robots) &
+                   (summary["targets"] == targets) &
+                   (summary["metric"] == metric)]
+    return rows.sort_values("index")
+
+
+def plotMean(x, rows, dataLabel):
+    ma = rows["mean"].values
+    msem = rows["sem"].values
+    baseline, = plt.plot(x, ma, 'o')
+    plt.plot(x, ma, color=baseline.get_color(), label=dataLabel)
+    plt.fill_between(x, ma-msem, ma+msem, color=baseline.get_color(), alpha=0.2)
 
 
 def joinPlot(dataLabel, x, y):
@@ -250,15 +366,14 @@ def plotFoundTargets(buildDir, config, figNumber = 1):
         figNumber += 1
     return figNumber
 
-def plotTargetsAccuracy(buildDir, config, figNumber = 1):
+def plotTargetsAccuracy(summary, config, figNumber = 1):
     for experiment in config["experiments"]:
         for targets in config["targets"]:
             df = pd.DataFrame()
             for robots in config["robots"]:
-                robotsDf = getExperimentDataFrame(buildDir, experiment, robots, targets, config["repetitions"])
-                df[str(robots) + " robots"] = robotsDf.count()
-                print robotsDf.describe()
-            df.index += 1
+                rows = getSummaryRows(summary, experiment, robots, targets, "target")
+                df[str(robots) + " robots"] = pd.Series(rows["successes"].values, index=rows["index"].values)
+                print rows
             print df
             df.plot(kind="bar", rot=0, figsize=(11,6), alpha=.7)
             plt.grid()
@@ -279,22 +394,14 @@ def plotBoxTargets(buildDir, config, figNumber = 1):
                 print df.sem()
     return figNumber
 
-def plotTargetsMean(buildDir, config, figNumber = 1):
+def plotTargetsMean(summary, config, figNumber = 1):
     for experiment in config["experiments"]:
         for targets in config["targets"]:
             plt.figure(figNumber, figsize=(10,5))
             for robots in config["robots"]:
-                robotsDf = getExperimentDataFrame(buildDir, experiment, robots, targets, config["repetitions"])
-                robotsDf.columns += 1
-                #print robotsDf
-                #print robotsDf.count()
-                ma = robotsDf.mean()
-                msem = robotsDf.sem()
-                print ma
-                print msem
-                baseline, = plt.plot(ma.index, ma, 'o')
-                plt.plot(ma.index, ma, color=baseline.get_color(), label=str(robots)+" robots")
-                plt.fill_between(msem.index, ma-msem, ma+msem, color=baseline.get_color(), alpha=0.2)
+                rows = getSummaryRows(summary, experiment, robots, targets, "target")
+                print rows[["index", "successes", "mean", "sem"]]
+                plotMean(rows["index"].values, rows, str(robots)+" robots")
             plt.grid()
             configureSubplot(plt.gca(), experiment+", "+str(targets)+" targets", ["Found targets", "Algorithm steps"], ["int", "default"])
             figNumber += 1
@@ -325,26 +432,9 @@ def getCoverageData(buildDir, experiment, robots, targetsArray, repetitions):
     coverageArray = [x / coverageArrayUpdates[index] for index, x in enumerate(coverageArray)]
     return timeArray, coverageArray
 
-def getCoverageDataFrame(buildDir, experiment, robots, targets, repetitions):
-    df = pd.DataFrame()
-    for i in range(0, repetitions):
-        config = generateConfig(buildDir, experiment, robots, targets, i)
-        data = getLogData(config["log"])
-        timeArray = [0]
-        coverageArray = [0]
-        for threshold in data["thresholds"]:
-            timeArray.append(threshold["step"])
-            coverageArray.append(threshold["coverage"])
-        timeArray.sort()
-        df[i] = pd.Series(np.full(len(coverageArray), np.nan))
-        for j, time in enumerate(timeArray):
-            df[i][j] = time
-    df.index = coverageArray
-    return df.transpose()
-
 def plotCoverage(buildDir, config, figNumber = 1):
     for experiment in config["experiments"]:
-        if experiment == "pso" or experiment == "cellular_decomposition":
+        if experiment == "pso":
             continue
         fig = plt.figure(figNumber)
         fig.canvas.set_window_title(experiment + "_coverage")
@@ -357,19 +447,15 @@ def plotCoverage(buildDir, config, figNumber = 1):
         figNumber += 1
     return figNumber
 
-def plotCoverageMean(buildDir, config, figNumber = 1):
+def plotCoverageMean(summary, config, figNumber = 1):
     for experiment in config["experiments"]:
-        if experiment == "pso" or experiment == "cellular_decomposition":
+        if experiment == "pso":
             continue
         plt.figure(figNumber, figsize=(10,5))
         for robots in config["robots"]:
-            robotsDf = getCoverageDataFrame(buildDir, experiment, robots, config["targets"][-1], config["repetitions"])
-            print robotsDf.mean()
-            ma = robotsDf.mean()
-            msem = robotsDf.sem()
-            baseline, = plt.plot(ma.index, ma, 'o')
-            plt.plot(ma.index, ma, color=baseline.get_color(), label=str(robots)+" robots")
-            plt.fill_between(msem.index, ma-msem, ma+msem, color=baseline.get_color(), alpha=0.2)
+            rows = getSummaryRows(summary, experiment, robots, config["targets"][-1], "threshold")
+            print rows[["level", "successes", "mean", "sem"]]
+            plotMean(rows["level"].values, rows, str(robots)+" robots")
         plt.grid()
         configureSubplot(plt.gca(), experiment+", "+str(config["targets"][-1])+" targets", ["Coverage [%]", "Algorithm steps"])
         figNumber += 1
@@ -383,7 +469,7 @@ def plotCompareCoverage(buildDir, config, figNumber = 1):
     for robots in config["robots"]:
         plt.subplot(subplotNumber)
         for experiment in config["experiments"]:
-            if experiment == "pso" or experiment == "cellular_decomposition":
+            if experiment == "pso":
                 continue
             timeArray, coverageArray = getCoverageData(buildDir, experiment, robots, config["targets"], config["repetitions"])
             joinPlot(experiment, coverageArray, timeArray)
@@ -392,19 +478,15 @@ def plotCompareCoverage(buildDir, config, figNumber = 1):
         subplotNumber += 1
     return figNumber
 
-def plotCompareCoverageMean(buildDir, config, figNumber = 1):
+def plotCompareCoverageMean(summary, config, figNumber = 1):
     for robots in config["robots"]:
         plt.figure(figNumber, figsize=(10,5))
         for experiment in config["experiments"]:
-            if experiment == "pso" or experiment == "cellular_decomposition":
+            if experiment == "pso":
                 continue
-            robotsDf = getCoverageDataFrame(buildDir, experiment, robots, config["targets"][-1], config["repetitions"])
-            print robotsDf.mean()
-            ma = robotsDf.mean()
-            msem = robotsDf.sem()
-            baseline, = plt.plot(ma.index, ma, 'o')
-            plt.plot(ma.index, ma, color=baseline.get_color(), label=experiment)
-            plt.fill_between(msem.index, ma-msem, ma+msem, color=baseline.get_color(), alpha=0.2)
+            rows = getSummaryRows(summary, experiment, robots, config["targets"][-1], "threshold")
+            print rows[["level", "successes", "mean", "sem"]]
+            plotMean(rows["level"].values, rows, experiment)
         plt.grid()
         configureSubplot(plt.gca(), str(config["targets"][-1])+" targets, "+str(robots)+" robots", ["Coverage [%]", "Algorithm steps"])
         figNumber += 1
@@ -426,18 +508,13 @@ def plotCompareTargets(buildDir, config, figNumber = 1):
         subplotNumber += 1
     return figNumber
 
-def plotCompareTargetsMean(buildDir, config, figNumber = 1):
+def plotCompareTargetsMean(summary, config, figNumber = 1):
     for robots in config["robots"]:
         plt.figure(figNumber, figsize=(10,5))
         for experiment in config["experiments"]:
-            robotsDf = getExperimentDataFrame(buildDir, experiment, robots, config["targets"][-1], config["repetitions"])
-            robotsDf.columns += 1
-            print robotsDf.mean()
-            ma = robotsDf.mean()
-            msem = robotsDf.sem()
-            baseline, = plt.plot(ma.index, ma, 'o')
-            plt.plot(ma.index, ma, color=baseline.get_color(), label=experiment)
-            plt.fill_between(msem.index, ma-msem, ma+msem, color=baseline.get_color(), alpha=0.2)
+            rows = getSummaryRows(summary, experiment, robots, config["targets"][-1], "target")
+            print rows[["index", "successes", "mean", "sem"]]
+            plotMean(rows["index"].values, rows, experiment)
         plt.grid()
         configureSubplot(plt.gca(), str(config["targets"][-1])+" targets, "+str(robots)+" robots", ["Found targets", "Algorithm steps"])
         figNumber += 1
@@ -454,6 +531,7 @@ def main():
     parser.add_argument("--verbose", action="store_true", help="print verbose log")
     parser.add_argument("--plot", nargs="+", choices=plotTypes, default=[], type=str, help="plot given plot-type")
     parser.add_argument("--custom", action="store_true", help="give custom experiments configuration")
+    parser.add_argument("--headless", action="store_true", help="build without Qt/OpenGL and run without visualization")
     args = parser.parse_args()
 
     sourceDir = os.getcwd()
@@ -481,29 +559,37 @@ def main():
         configuration["targets"] = [int(x) for x in raw_input("Number of targets: ").split(" ")]
         configuration["repetitions"] = int(raw_input("Repetitions: "))
         
+    if args.headless:
+        buildDir += "-headless"
+
     print "Configuration:", 
     print configuration
     print "Build dir:",
     print buildDir
 
     cmake = CmakeCommand(sourceDir, buildDir)
+    if args.headless:
+        cmake.setFlag("COVERAGE_SEARCH_HEADLESS", "ON")
     figNumber = 1
     if not args.no_exe:
         runExperiments(cmake, configuration, args.verbose)
+    summaryPlots = ["targets", "coverage", "coverage-compare", "targets-compare", "targets-accuracy"]
+    if any(plot in summaryPlots for plot in args.plot):
+        summary = aggregateResults(cmake)
     if "light" in args.plot:
         figNumber = plotLightDistance(buildDir, configuration, figNumber)
     if "targets" in args.plot:
-        figNumber = plotTargetsMean(buildDir, configuration, figNumber)
+        figNumber = plotTargetsMean(summary, configuration, figNumber)
     if "coverage" in args.plot:
-        figNumber = plotCoverageMean(buildDir, configuration, figNumber)
+        figNumber = plotCoverageMean(summary, configuration, figNumber)
     if "coverage-compare" in args.plot:
-        figNumber = plotCompareCoverageMean(buildDir, configuration, figNumber)
+        figNumber = plotCompareCoverageMean(summary, configuration, figNumber)
     if "targets-compare" in args.plot:
-        figNumber = plotCompareTargetsMean(buildDir, configuration, figNumber)
+        figNumber = plotCompareTargetsMean(summary, configuration, figNumber)
     if "targets-box" in args.plot:
         figNumber = plotBoxTargets(buildDir, configuration, figNumber)
     if "targets-accuracy" in args.plot:
-        figNumber = plotTargetsAccuracy(buildDir, configuration, figNumber)
+        figNumber = plotTargetsAccuracy(summary, configuration, figNumber)
 
     plt.show()
 
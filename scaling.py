@@ -0,0 +1,400 @@
+#!/usr/bin/python
+"""
+Swarm-scale benchmark of the coverage algorithms.
+
+Builds the headless profile (COVERAGE_SEARCH_HEADLESS) and generates a scenario
+for every combination of algorithm, robots number, arena side and threads
+number from the configurations in src/configurations. Each scenario runs for
+a fixed number of steps and reports:
+
+    ms/step     wall time of the steps, without the setup, measured as the
+                difference to a run of the same scenario that stops after one step
+    phases      time per step of every profiled phase (COVERAGE_SEARCH_PROFILING)
+    peak RSS    maximal resident set size of the simulator process
+    efficiency  speedup over the smallest threads number divided by the
+                threads ratio, ARGoS runs threads="0" on the main thread only
+
+The results are printed as a table and written to JSON. Every scenario runs
+on each of the --engines, kinematics2d is the fast-forward engine in
+src/physics_engines for parameter sweeps.
+
+With --validate the scenarios keep the thresholds of their configuration and
+run until they are all reached, or for --steps. The steps at which each
+threshold is reached are read from the run logs, and the coverage curve of
+every engine is compared with the one of the first engine.
+
+    ./scaling.py --algorithms mbfo pso --robots 10 100 1000 --threads 0 4 8
+    ./scaling.py --algorithms mbfo --robots 500 --threads 0 --engines dynamics2d kinematics2d
+    ./scaling.py --validate --algorithms mbfo pso --robots 50 --threads 0 --steps 20000 \\
+        --engines dynamics2d kinematics2d
+"""
+from __future__ import print_function
+import argparse
+import csv
+import json
+import math
+import os
+import re
+import struct
+import subprocess
+import sys
+import time
+import xml.etree.ElementTree as ElementTree
+
+ALGORITHMS = {
+    "random": {
+        "config": "random/random.argos",
+        "targets": ["random_controller"],
+        "wall": 0.1,
+    },
+    "mbfo": {
+        "config": "mbfo/mbfo.argos",
+        "targets": ["mbfo_controller", "mbfo_loop_function", "target_robot"],
+        "wall": 0.01,
+    },
+    "dynamic_mbfo": {
+        "config": "dynamic_mbfo/dynamic_mbfo.argos",
+        "targets": ["mbfo_controller", "mbfo_loop_function", "target_robot"],
+        "wall": 0.01,
+    },
+    "pso": {
+        "config": "pso/pso.argos",
+        "targets": ["pso", "pso_loop_function", "target_robot"],
+        "wall": 0.01,
+    },
+    "cellular": {
+        "config": "cellular_decomposition/cellular_decomposition.argos",
+        "targets": ["cellular_decomposition_controller", "cellular_loop_function", "target_robot"],
+        "wall": 0.02,
+    },
+}
+
+ENGINES = {
+    "dynamics2d": {"targets": []},
+    "kinematics2d": {"targets": ["kinematics2d_engine"]},
+}
+
+# See src/utils/log/RunLog.h
+RUN_LOG_MAGIC = b"CSRL"
+RUN_LOG_HEADER_SIZE = 8
+RUN_LOG_RECORD_HEADER = struct.Struct("<IIB")
+RUN_LOG_THRESHOLD = 2
+
+# Coverage the runs never reach, so the loop functions do not end them early
+UNREACHABLE_THRESHOLD = "101"
+
+
+def mkdir(path):
+    if not os.path.isdir(path):
+        os.makedirs(path)
+
+
+def build(sourceDir, buildDir, algorithms, engines, jobs):
+    mkdir(buildDir)
+    flags = ["-DCMAKE_BUILD_TYPE=Release", "-DCOVERAGE_SEARCH_PROFILING=ON", "-DCOVERAGE_SEARCH_HEADLESS=ON"]
+    subprocess.check_call(["cmake"] + flags + [sourceDir], cwd=buildDir)
+    targets = ["all"]
+    for algorithm in algorithms:
+        targets += [t for t in ALGORITHMS[algorithm]["targets"] if t not in targets]
+    for engine in engines:
+        targets += [t for t in ENGINES[engine]["targets"] if t not in targets]
+    subprocess.check_call(["make", "-j" + str(jobs)] + targets, cwd=buildDir)
+
+
+def templateVariables(sourceDir, scenario, steps, runDir):
+    half = scenario["side"] / 2.0
+    return {
+        "ARGOS_ROBOTS_NUMBER": scenario["robots"],
+        "ARGOS_TARGETS_NUMBER": scenario["targets"],
+        "ARGOS_AREA_SIDE_IN_M": scenario["side"],
+        "ARGOS_AREA_HALF_SIDE_IN_M": half,
+        "ARGOS_ROBOTS_HALF_AREA_SIDE_IN_M": half - 0.2,
+        "ARGOS_ROBOTS_HALF_AREA_SIDE_BEGINNIG_IN_M": half - 0.4,
+        "ARGOS_TARGET_HALF_AREA_SIDE_BEGINNIG_IN_M": half - 0.8,
+        "ARGOS_TARGET_HALF_AREA_SIDE_IN_M": half - 0.6,
+        "ARGOS_WALL_THICKNESS_IN_M": ALGORITHMS[scenario["algorithm"]]["wall"],
+        "ARGOS_CAMERA_1": scenario["side"] * 2,
+        "ARGOS_EXPERIMENT_LENGTH": steps,
+        "ARGOS_TICKS_PER_SEC": 10,
+        "ARGOS_RANDOM_SEED": 'random_seed="%d"' % scenario["seed"],
+        "ARGOS_TEXTURES_DIR": os.path.join(sourceDir, "src", "textures"),
+        "ARGOS_LOG": os.path.join(runDir, "run.log"),
+    }
+
+
+def generateConfig(sourceDir, scenario, steps, runDir, profile, validate=False):
+    template = os.path.join(sourceDir, "src", "configurations", ALGORITHMS[scenario["algorithm"]]["config"])
+    with open(template) as f:
+        text = f.read()
+    variables = templateVariables(sourceDir, scenario, steps, runDir)
+    text = re.sub(r"@(\w+)@", lambda m: str(variables.get(m.group(1), m.group(0))), text)
+
+    root = ElementTree.fromstring(text)
+    root.find("framework/system").set("threads", str(scenario["threads"]))
+    root.find("framework/experiment").set("length", str(steps))
+    physicsEngines = root.find("physics_engines")
+    for engine in list(physicsEngines):
+        physicsEngines.remove(engine)
+    ElementTree.SubElement(physicsEngines, scenario["engine"], id="physics")
+    loopFunctions = root.find("loop_functions")
+    if loopFunctions is not None:
+        log = loopFunctions.find("log")
+        if log is not None and not validate:
+            for threshold in log.findall("threshold"):
+                log.remove(threshold)
+            ElementTree.SubElement(log, "threshold", value=UNREACHABLE_THRESHOLD)
+        if profile:
+            ElementTree.SubElement(loopFunctions, "profiling", histograms=os.path.join(runDir, "phases.csv"))
+
+    path = os.path.join(runDir, "scenario.argos" if profile else "setup.argos")
+    ElementTree.ElementTree(root).write(path)
+    return path
+
+
+def runArgos(binDir, config, output):
+    env = dict(os.environ, HOME=binDir, ARGOS_PLUGIN_PATH=binDir)
+    with open(output, "w") as log:
+        start = time.time()
+        proc = subprocess.Popen(["./argos3", "-z", "-c", config], cwd=binDir, env=env, stdout=log, stderr=log)
+        _, status, usage = os.wait4(proc.pid, 0)
+        duration = time.time() - start
+    proc.returncode = status
+    if status != 0:
+        raise RuntimeError("ARGoS failed on %s, see %s" % (config, output))
+    # ru_maxrss is in kilobytes on Linux
+    return duration, usage.ru_maxrss / 1024.0
+
+
+def readPhases(path):
+    phases = {}
+    if not os.path.exists(path):
+        return phases
+    with open(path) as f:
+        for row in csv.DictReader(f):
+            phases[row["phase"]] = {
+                "calls": int(row["calls"]),
+                "total_us": float(row["total_us"]),
+                "mean_us": float(row["mean_us"]),
+                "max_us": float(row["max_us"]),
+            }
+    return phases
+
+
+def readConfiguredThresholds(config):
+    """Returns the coverage thresholds of a generated configuration, in the order the loop functions log them"""
+    log = ElementTree.parse(config).getroot().find("loop_functions/log")
+    if log is None:
+        return []
+    return [float(threshold.get("value")) for threshold in log.findall("threshold")]
+
+
+def readThresholds(path, configured):
+    """Returns the step at which each configured threshold was reached
+
+    A Threshold record holds the coverage reached, not the threshold, so the
+    records are paired in order with the configured thresholds: the loop
+    functions log one record per threshold, in the order of the configuration.
+    """
+    thresholds = {}
+    if not os.path.exists(path):
+        return thresholds
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:len(RUN_LOG_MAGIC)] != RUN_LOG_MAGIC:
+        raise RuntimeError("%s is not a run log" % path)
+    offset = RUN_LOG_HEADER_SIZE
+    # An incomplete record at the end is skipped
+    while offset + RUN_LOG_RECORD_HEADER.size <= len(data):
+        size, step, eventType = RUN_LOG_RECORD_HEADER.unpack_from(data, offset)
+        offset += RUN_LOG_RECORD_HEADER.size
+        if offset + size > len(data):
+            break
+        if eventType == RUN_LOG_THRESHOLD and len(thresholds) < len(configured):
+            thresholds[configured[len(thresholds)]] = step
+        offset += size
+    return thresholds
+
+
+def scenarioDir(resultsDir, scenario):
+    return os.path.join(resultsDir, "%(algorithm)s_%(engine)s_r%(robots)d_s%(side)g_t%(threads)d" % scenario)
+
+
+def runScenario(sourceDir, binDir, resultsDir, scenario, steps):
+    runDir = scenarioDir(resultsDir, scenario)
+    mkdir(runDir)
+
+    setupTime, _ = runArgos(binDir, generateConfig(sourceDir, scenario, 1, runDir, False),
+                            os.path.join(runDir, "setup.out"))
+    runTime, peakRss = runArgos(binDir, generateConfig(sourceDir, scenario, steps, runDir, True),
+                                os.path.join(runDir, "scenario.out"))
+
+    phases = readPhases(os.path.join(runDir, "phases.csv"))
+    # Runs also end when all targets are found, the robots' control steps tell how many steps were done
+    stepsDone = steps
+    if "control step" in phases:
+        stepsDone = max(1, phases["control step"]["calls"] // scenario["robots"])
+    for phase in phases.values():
+        phase["ms_per_step"] = phase["total_us"] / 1000.0 / stepsDone
+
+    result = dict(scenario)
+    result.update({
+        "steps": stepsDone,
+        "setup_s": setupTime,
+        "ms_per_step": max(0.0, runTime - setupTime) * 1000.0 / max(1, stepsDone - 1),
+        "peak_rss_mb": peakRss,
+        "phases": phases,
+    })
+    return result
+
+
+def validateScenario(sourceDir, binDir, resultsDir, scenario, steps):
+    runDir = scenarioDir(resultsDir, scenario)
+    mkdir(runDir)
+    config = generateConfig(sourceDir, scenario, steps, runDir, False, True)
+    runTime, _ = runArgos(binDir, config, os.path.join(runDir, "validation.out"))
+    result = dict(scenario)
+    result.update({
+        "run_s": runTime,
+        "thresholds": readThresholds(os.path.join(runDir, "run.log"), readConfiguredThresholds(config)),
+    })
+    return result
+
+
+def compareCoverageCurves(results, engines):
+    """Pairs every run with the run of the reference engine, the first of engines"""
+    reference = {}
+    for r in results:
+        if r["engine"] == engines[0]:
+            reference[(r["algorithm"], r["robots"], r["side"], r["threads"])] = r
+    for r in results:
+        base = reference.get((r["algorithm"], r["robots"], r["side"], r["threads"]))
+        if base is None or r is base:
+            continue
+        differences = {}
+        for threshold, step in base["thresholds"].items():
+            if threshold in r["thresholds"]:
+                differences[threshold] = r["thresholds"][threshold] - step
+        r["reference"] = engines[0]
+        r["step_differences"] = differences
+        r["speedup"] = base["run_s"] / r["run_s"] if r["run_s"] > 0 else 0.0
+
+
+def printValidation(results):
+    header = "%-14s %-13s %7s %7s %8s %8s  %s" % (
+        "algorithm", "engine", "robots", "side", "run [s]", "speedup", "steps to threshold (difference)")
+    print(header)
+    print("-" * len(header))
+    for r in results:
+        differences = r.get("step_differences", {})
+        curve = ", ".join("%g%% %d%s" % (threshold, step,
+                                         " (%+d)" % differences[threshold] if threshold in differences else "")
+                          for threshold, step in sorted(r["thresholds"].items()))
+        print("%-14s %-13s %7d %7g %8.1f %8s  %s" % (
+            r["algorithm"], r["engine"], r["robots"], r["side"], r["run_s"],
+            "%.2f" % r["speedup"] if "speedup" in r else "-", curve))
+
+
+def addParallelEfficiency(results):
+    groups = {}
+    for r in results:
+        groups.setdefault((r["algorithm"], r["engine"], r["robots"], r["side"]), []).append(r)
+    for group in groups.values():
+        base = min(group, key=lambda r: r["threads"])
+        baseThreads = max(1, base["threads"])
+        for r in group:
+            threads = max(1, r["threads"])
+            if r["ms_per_step"] > 0 and threads != baseThreads:
+                r["parallel_efficiency"] = (base["ms_per_step"] * baseThreads) / (r["ms_per_step"] * threads)
+            else:
+                r["parallel_efficiency"] = 1.0
+
+
+def printTable(results):
+    header = "%-14s %-13s %7s %7s %7s %6s %10s %9s %6s  %s" % (
+        "algorithm", "engine", "robots", "side", "threads", "steps", "ms/step", "RSS [MB]", "eff",
+        "phases [ms/step]")
+    print(header)
+    print("-" * len(header))
+    for r in results:
+        phases = sorted(r["phases"].items(), key=lambda p: -p[1]["ms_per_step"])
+        print("%-14s %-13s %7d %7g %7d %6d %10.3f %9.1f %6.2f  %s" % (
+            r["algorithm"], r["engine"], r["robots"], r["side"], r["threads"], r["steps"], r["ms_per_step"],
+            r["peak_rss_mb"], r["parallel_efficiency"],
+            ", ".join("%s %.3f" % (name, p["ms_per_step"]) for name, p in phases)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure how the coverage algorithms scale with the swarm size")
+    parser.add_argument("--algorithms", nargs="+", choices=sorted(ALGORITHMS.keys()), default=sorted(ALGORITHMS.keys()))
+    parser.add_argument("--robots", nargs="+", type=int, default=[10, 50, 100, 200, 500, 1000, 2000, 5000])
+    parser.add_argument("--sides", nargs="+", type=float, default=[],
+                        help="arena sides in meters, by default derived from --density")
+    parser.add_argument("--density", type=float, default=5 / 36.0,
+                        help="robots per square meter used without --sides, defaults to the shipped configurations")
+    parser.add_argument("--threads", nargs="+", type=int, default=[0, 1, 2, 4, 8])
+    parser.add_argument("--engines", nargs="+", choices=sorted(ENGINES.keys()), default=["dynamics2d"],
+                        help="physics engines to run every scenario on, the first is the reference of --validate")
+    parser.add_argument("--validate", action="store_true",
+                        help="compare the coverage curves of the engines instead of measuring the step time")
+    parser.add_argument("--targets", type=int, default=5)
+    parser.add_argument("--steps", type=int, default=200)
+    parser.add_argument("--seed", type=int, default=123)
+    parser.add_argument("--build-dir", default=None, help="defaults to build/scaling")
+    parser.add_argument("--no-build", action="store_true", help="use the binaries already in the build directory")
+    parser.add_argument("--jobs", type=int, default=4)
+    parser.add_argument("--output", default="scaling.json")
+    args = parser.parse_args()
+
+    sourceDir = os.path.dirname(os.path.abspath(__file__))
+    buildDir = os.path.abspath(args.build_dir or os.path.join(sourceDir, "build", "scaling"))
+    binDir = os.path.join(buildDir, "bin")
+    resultsDir = os.path.join(buildDir, "results", "scaling")
+
+    if not args.no_build:
+        build(sourceDir, buildDir, args.algorithms, args.engines, args.jobs)
+
+    scenarios = []
+    for algorithm in args.algorithms:
+        for robots in args.robots:
+            sides = args.sides or [round(math.sqrt(robots / args.density), 1)]
+            for side in sides:
+                for threads in args.threads:
+                    for engine in args.engines:
+                        scenarios.append({"algorithm": algorithm, "engine": engine, "robots": robots,
+                                          "side": side, "threads": threads, "targets": args.targets,
+                                          "seed": args.seed})
+
+    results = []
+    for i, scenario in enumerate(scenarios):
+        print("[%d/%d] %s on %s with %d robots, %g m arena, %d threads" % (
+            i + 1, len(scenarios), scenario["algorithm"], scenario["engine"], scenario["robots"], scenario["side"],
+            scenario["threads"]))
+        sys.stdout.flush()
+        try:
+            if args.validate:
+                results.append(validateScenario(sourceDir, binDir, resultsDir, scenario, args.steps))
+            else:
+                results.append(runScenario(sourceDir, binDir, resultsDir, scenario, args.steps))
+        except RuntimeError as e:
+            print("\t" + str(e))
+
+    print()
+    if args.validate:
+        compareCoverageCurves(results, args.engines)
+        printValidation(results)
+        # JSON keys have to be strings
+        for r in results:
+            for key in ("thresholds", "step_differences"):
+                if key in r:
+                    r[key] = dict(("%g" % k, v) for k, v in r[key].items())
+    else:
+        addParallelEfficiency(results)
+        printTable(results)
+    with open(args.output, "w") as f:
+        json.dump({"steps": args.steps, "validate": args.validate, "results": results}, f, indent=2,
+                  sort_keys=True)
+    print("\nResults written to " + args.output)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,122 @@
+#include "Benchmark.h"
+#include "BenchmarkMocks.h"
+#include <utils/task/behaviors/AvoidObstacleBehavior.h>
+#include <algorithm>
+#include <list>
+#include <random>
+
+using namespace std;
+using namespace argos;
+
+/* Footbot dimensions */
+static const Real BODY_RADIUS = 0.085036758f;
+
+/*
+ * Histogram computation as it was before the fixed-size rewrite,
+ * kept as the reference for the bit-identity check and the speed comparison.
+ */
+static vector<bool> referenceObstacleHistogram(const CCI_FootBotProximitySensor::TReadings& readings,
+                                               CDegrees histogramAlpha) {
+    const CRange<Real> histogramThresholdHysteresis(0.12f, 0.2f);
+    vector<bool> obstacleHistogram(static_cast<size_t>(CDegrees(360)/histogramAlpha), false);
+    vector<list<Real>> magnitudeHistogramVariables(obstacleHistogram.size());
+
+    for (auto r : readings) {
+        if (r.Value == 0)
+            continue;
+        auto distance = (0.0100527 / r.Value) - 0.000163144 + BODY_RADIUS;
+        const auto clearance = 0.01f;
+        auto enlargementAngle = ASin((BODY_RADIUS + clearance) / distance);
+        auto lowerAngleBoundary = (r.Angle - enlargementAngle).UnsignedNormalize();
+        auto upperAngleBoundary = (r.Angle + enlargementAngle).UnsignedNormalize();
+        function<bool(const CRadians&)> isInBoundary;
+        if (lowerAngleBoundary < upperAngleBoundary)
+            isInBoundary = [=](const CRadians& a) { return a >= lowerAngleBoundary && a <= upperAngleBoundary; };
+        else
+            isInBoundary = [=](const CRadians& a) { return a >= lowerAngleBoundary || a <= upperAngleBoundary; };
+
+        for (size_t i = 0; i < obstacleHistogram.size(); i++) {
+            auto angle = i * ToRadians(histogramAlpha);
+            if (isInBoundary(angle))
+                magnitudeHistogramVariables.at(i).push_back(r.Value * r.Value);
+        }
+    }
+
+    vector<Real> magnitudeHistogram(magnitudeHistogramVariables.size());
+    for (size_t i = 0; i < magnitudeHistogramVariables.size(); i++) {
+        auto& l = magnitudeHistogramVariables.at(i);
+        auto maxEl = max_element(l.begin(), l.end());
+        if (maxEl != l.end())
+            magnitudeHistogram.at(i) = *maxEl;
+    }
+
+    for (size_t i = 0; i < obstacleHistogram.size(); i++) {
+        if (magnitudeHistogram.at(i) > histogramThresholdHysteresis.GetMax())
+            obstacleHistogram.at(i) = true;
+        else if (magnitudeHistogram.at(i) < histogramThresholdHysteresis.GetMin())
+            obstacleHistogram.at(i) = false;
+        else if (i > 0)
+            obstacleHistogram.at(i) = obstacleHistogram.at(i - 1);
+    }
+    return obstacleHistogram;
+}
+
+static vector<vector<Real>> generateFrames(size_t framesNumber, size_t sensorsNumber) {
+    mt19937 generator(42);
+    uniform_real_distribution<Real> value(0, 1);
+    bernoulli_distribution isFree(0.6);
+    vector<vector<Real>> frames(framesNumber, vector<Real>(sensorsNumber));
+    for (auto& frame : frames)
+        for (auto& v : frame)
+            v = isFree(generator) ? 0 : value(generator);
+    return frames;
+}
+
+static void loadFrame(benchmark::MockRobot& robot, const vector<Real>& frame) {
+    for (size_t i = 0; i < frame.size(); i++)
+        robot.proximity.setValue(i, frame[i]);
+}
+
+static size_t countMismatches(benchmark::MockRobot& robot, AvoidObstacleBehavior& behavior,
+                              const vector<vector<Real>>& frames, CDegrees histogramAlpha) {
+    size_t mismatches = 0;
+    for (auto& frame : frames) {
+        loadFrame(robot, frame);
+        behavior.isRoadClear(CVector2(1, 0));
+        auto reference = referenceObstacleHistogram(robot.proximity.GetReadings(), histogramAlpha);
+        for (size_t i = 0; i < reference.size(); i++)
+            if (reference[i] != behavior.isObstacleInSector(i))
+                mismatches++;
+    }
+    return mismatches;
+}
+
+int main() {
+    benchmark::MockRobot robot;
+    auto frames = generateFrames(1024, robot.proximity.size());
+
+    for (auto alpha : {1.0, 2.0, 5.0, 10.0}) {
+        CDegrees histogramAlpha(alpha);
+        AvoidObstacleBehavior behavior(robot.getSensors(), robot.getActuators(), histogramAlpha);
+
+        auto mismatches = countMismatches(robot, behavior, frames, histogramAlpha);
+        cout << "{ \"name\" : \"obstacle_histogram_check\", \"parameters\" : { \"alpha\" : " << alpha
+             << " }, \"mismatches\" : " << mismatches << " }" << endl;
+
+        benchmark::run("obstacle_histogram_reference", [&](unsigned long i) {
+            auto& frame = frames[i % frames.size()];
+            loadFrame(robot, frame);
+            benchmark::doNotOptimize(referenceObstacleHistogram(robot.proximity.GetReadings(), histogramAlpha));
+        }, {{"alpha", alpha}});
+
+        benchmark::run("obstacle_histogram", [&](unsigned long i) {
+            auto& frame = frames[i % frames.size()];
+            loadFrame(robot, frame);
+            benchmark::doNotOptimize(behavior.isRoadClear(CVector2(1, 0)));
+        }, {{"alpha", alpha}});
+
+        if (mismatches != 0)
+            return 1;
+    }
+    return 0;
+}
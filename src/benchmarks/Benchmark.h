@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Minimal benchmark harness: runs a callable until a time budget is spent and
+ * prints one JSON object per result, so the output can be collected by scripts.
+ */
+namespace benchmark {
+
+struct Result {
+    std::string name;
+    std::vector<std::pair<std::string, double>> parameters;
+    unsigned long iterations;
+    double nsPerIteration;
+};
+
+inline std::ostream& operator<<(std::ostream& o, const Result& r) {
+    o << "{ \"name\" : \"" << r.name << "\", \"parameters\" : {";
+    for (std::size_t i = 0; i < r.parameters.size(); i++)
+        o << (i == 0 ? " " : ", ") << "\"" << r.parameters[i].first << "\" : " << r.parameters[i].second;
+    o << " }, \"iterations\" : " << r.iterations
+      << ", \"ns_per_iteration\" : " << r.nsPerIteration << " }";
+    return o;
+}
+
+/* Keeps the optimizer from discarding a computed value */
+template<class T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template<class F>
+Result run(const std::string& name, F&& f,
+           std::vector<std::pair<std::string, double>> parameters = {},
+           double minTimeInSeconds = 0.2) {
+    using Clock = std::chrono::steady_clock;
+    unsigned long iterations = 1;
+    while (true) {
+        auto begin = Clock::now();
+        for (unsigned long i = 0; i < iterations; i++)
+            f(i);
+        std::chrono::duration<double> elapsed = Clock::now() - begin;
+        if (elapsed.count() >= minTimeInSeconds || iterations >= (1ul << 40)) {
+            Result r{name, std::move(parameters), iterations, elapsed.count() * 1e9 / iterations};
+            std::cout << r << std::endl;
+            return r;
+        }
+        iterations *= 2;
+    }
+}
+
+}
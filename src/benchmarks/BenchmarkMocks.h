@@ -0,0 +1,97 @@
+#pragma once
+
+#include <utils/task/behaviors/ControllerBehavior.h>
+#include <utils/task/TaskHandler.h>
+
+/*
+ * Sensors and actuators that can be driven without the ARGoS simulator.
+ */
+namespace benchmark {
+
+class MockPositioningSensor : public argos::CCI_PositioningSensor {
+public:
+    void setPosition(const argos::CVector3& position) { m_sReading.Position = position; }
+};
+
+class MockProximitySensor : public argos::CCI_FootBotProximitySensor {
+public:
+    void setValue(std::size_t i, argos::Real value) { m_tReadings.at(i).Value = value; }
+    std::size_t size() const { return m_tReadings.size(); }
+};
+
+class MockBeacons : public argos::CCI_ColoredBeaconBearingSensor {
+public:
+    void addReading(const argos::CColor& color, const argos::CRadians& bearing, argos::Real range) {
+        m_tReadings.emplace_back(color, bearing, range);
+    }
+    void clear() { m_tReadings.clear(); }
+};
+
+class MockWheels : public argos::CCI_DifferentialSteeringActuator {
+public:
+    void SetLinearVelocity(argos::Real left, argos::Real right) override {
+        leftVelocity = left;
+        rightVelocity = right;
+    }
+    argos::Real leftVelocity = 0;
+    argos::Real rightVelocity = 0;
+};
+
+class MockLeds : public argos::CCI_LEDsActuator {};
+
+struct MockRobot {
+    MockPositioningSensor position;
+    MockProximitySensor proximity;
+    MockBeacons beacons;
+    MockWheels wheels;
+    MockLeds leds;
+
+    Sensors getSensors() { return { position, proximity, beacons }; }
+    Actuators getActuators() { return { wheels, leds }; }
+};
+
+/*
+ * Task handler that moves straight towards its goals with a fixed step.
+ * Explorers go down the arena and report a critical point at its bottom, so
+ * the task manager goes through the whole decomposition and sweeping cycle.
+ */
+class MockTaskHandler : public TaskHandler {
+public:
+    MockTaskHandler(const argos::CVector2& position, argos::Real bottom, argos::Real stepLength)
+        : position(position), bottom(bottom), stepLength(stepLength) {}
+
+    void step() {
+        auto task = getCurrentTask();
+        if (task.status == Task::Status::MoveToBegin)
+            moveTowards(task.begin);
+        else if (task.status == Task::Status::Proceed) {
+            if (task.behavior == Task::Behavior::Sweep)
+                moveTowards(task.end);
+            else
+                moveTowards(argos::CVector2(position.GetX(), bottom));
+        }
+        readyToProceed = task.status == Task::Status::Prepare;
+    }
+
+    argos::CVector2 getPosition() const override { return position; }
+    bool isCriticalPoint() const override { return position.GetY() <= bottom; }
+    bool isForwardConvexCP() const override { return false; }
+    bool isConcaveCP() const override { return false; }
+    bool isReadyToProceed() const override { return readyToProceed; }
+
+private:
+    argos::CVector2 position;
+    argos::Real bottom;
+    argos::Real stepLength;
+    bool readyToProceed = false;
+
+    void moveTowards(const argos::CVector2& goal) {
+        auto offset = goal - position;
+        if (offset.Length() <= stepLength)
+            position = goal;
+        else
+            position += offset.Normalize() * stepLength;
+    }
+};
+
+}
@@ -0,0 +1,167 @@
+#include "Benchmark.h"
+#include <utils/coverage/CoverageGrid.h>
+#include <utils/coverage/FootprintStamps.h>
+#include <cmath>
+#include <random>
+#include <set>
+
+using namespace std;
+using namespace argos;
+
+static CRange<CVector3> arenaLimits(Real arenaSize) {
+    return CRange<CVector3>(CVector3(-arenaSize / 2, -arenaSize / 2, 0), CVector3(arenaSize / 2, arenaSize / 2, 1));
+}
+
+static vector<CVector3> generatePositions(size_t positionsNumber, Real arenaSize) {
+    mt19937 generator(42);
+    uniform_real_distribution<Real> coordinate(-arenaSize / 2, arenaSize / 2);
+    vector<CVector3> positions(positionsNumber);
+    for (auto& p : positions)
+        p.Set(coordinate(generator), coordinate(generator), 0);
+    return positions;
+}
+
+static vector<Trajectory::Pose> generatePoses(size_t posesNumber, Real arenaSize) {
+    mt19937 generator(7);
+    uniform_real_distribution<double> coordinate(-arenaSize / 2, arenaSize / 2);
+    uniform_real_distribution<double> yaw(-ARGOS_PI, ARGOS_PI);
+    vector<Trajectory::Pose> poses(posesNumber);
+    for (auto& p : poses)
+        p = {coordinate(generator), coordinate(generator), yaw(generator)};
+    return poses;
+}
+
+/* Ends of the 24 foot-bot proximity rays in the robot frame */
+static vector<Trajectory::Point> footbotFootprint() {
+    vector<Trajectory::Point> footprint;
+    for (int i = 0; i < 24; i++) {
+        const double angle = ARGOS_PI / 24 + i * ARGOS_PI / 12;
+        footprint.push_back({{0.185 * cos(angle), 0.185 * sin(angle), 0.06}});
+    }
+    return footprint;
+}
+
+static vector<CRay3> getRays(const vector<Trajectory::Pose>& poses, const vector<Trajectory::Point>& footprint,
+                             const CRange<CVector3>& limits) {
+    vector<CRay3> rays;
+    for (auto& pose : poses) {
+        const CVector3 rayStart(pose.x, pose.y, 0);
+        for (auto& point : footprint) {
+            CVector3 rayEnd(point[0], point[1], point[2]);
+            rayEnd.RotateZ(CRadians(pose.yaw));
+            rayEnd += rayStart;
+            rayEnd.SetX(min(max(rayEnd.GetX(), limits.GetMin().GetX()), limits.GetMax().GetX()));
+            rayEnd.SetY(min(max(rayEnd.GetY(), limits.GetMin().GetY()), limits.GetMax().GetY()));
+            rays.emplace_back(rayStart, rayEnd);
+        }
+    }
+    return rays;
+}
+
+/* True if the cell or one of its 8 neighbours is in the set */
+static bool hasNeighbour(const set<CoverageGrid::CellIndex>& cells, const CoverageGrid::CellIndex& cell) {
+    for (int dx = -1; dx <= 1; dx++)
+        for (int dy = -1; dy <= 1; dy++)
+            if (cells.count({cell.first + dx, cell.second + dy}) != 0)
+                return true;
+    return false;
+}
+
+/* Cells the stamps and the ray sampling mark for a pose that are more than one cell away from all of the other's */
+static size_t countStampMismatches(const CoverageGrid& coverage, const FootprintStamps& stamps,
+                                   const vector<Trajectory::Point>& footprint, const vector<Trajectory::Pose>& poses,
+                                   const CRange<CVector3>& limits) {
+    size_t mismatches = 0;
+    vector<CoverageGrid::Span> spans;
+    for (auto& pose : poses) {
+        auto rayCellsList = coverage.getCellsOnRays(getRays({pose}, footprint, limits));
+        set<CoverageGrid::CellIndex> rayCells(rayCellsList.begin(), rayCellsList.end());
+        spans.clear();
+        stamps.addSpans(coverage, pose, spans);
+        set<CoverageGrid::CellIndex> stampCells;
+        for (auto& span : spans)
+            for (unsigned y = span.yBegin; y < span.yEnd; y++)
+                stampCells.insert({span.x, y});
+        for (auto& cell : rayCells)
+            if (!hasNeighbour(stampCells, cell))
+                mismatches++;
+        for (auto& cell : stampCells)
+            if (!hasNeighbour(rayCells, cell))
+                mismatches++;
+    }
+    return mismatches;
+}
+
+int main() {
+    const Real cellSize = 0.05;
+
+    /*
+     * Stamps must match the ray sampling they replace within one cell. The rays of the foot-bot are close enough to
+     * hide a wrong heading, so a single long ray is checked too. Poses stay away from the walls, where the rays are
+     * clamped to the arena and bend.
+     */
+    const vector<Trajectory::Point> singleRayFootprint = {{{0.5, 0.1, 0.06}}};
+    for (auto& footprint : {footbotFootprint(), singleRayFootprint}) {
+        const Real arenaSize = 5.0;
+        const auto limits = arenaLimits(arenaSize);
+        CoverageGrid coverage(5, cellSize);
+        coverage.initGrid(limits);
+        FootprintStamps stamps;
+        stamps.init(footprint, cellSize);
+        auto mismatches = countStampMismatches(coverage, stamps, footprint, generatePoses(10000, arenaSize - 2),
+                                               limits);
+        cout << "{ \"name\" : \"coverage_grid_stamps_check\", \"parameters\" : { \"arena_size\" : " << arenaSize
+             << ", \"cell_size\" : " << cellSize << ", \"rays\" : " << footprint.size()
+             << " }, \"mismatches\" : " << mismatches << " }" << endl;
+        if (mismatches != 0)
+            return 1;
+    }
+
+    for (auto arenaSize : {2.0, 5.0, 10.0, 20.0, 200.0}) {
+        const auto limits = arenaLimits(arenaSize);
+
+        benchmark::run("coverage_grid_init", [&](unsigned long) {
+            CoverageGrid coverage(5, cellSize);
+            coverage.initGrid(limits);
+            benchmark::doNotOptimize(coverage.getWidth());
+        }, {{"arena_size", arenaSize}, {"cell_size", cellSize}});
+
+        CoverageGrid coverage(5, cellSize);
+        coverage.initGrid(limits);
+        auto positions = generatePositions(4096, arenaSize);
+
+        benchmark::run("coverage_grid_cell_index", [&](unsigned long i) {
+            benchmark::doNotOptimize(coverage.getCellIndex(positions[i % positions.size()]));
+        }, {{"arena_size", arenaSize}, {"cell_size", cellSize}});
+
+        /* A partly covered grid, so the sum is not trivially the initial value */
+        for (auto& p : positions)
+            coverage.visitCell(coverage.getCellIndex(p));
+
+        benchmark::run("coverage_grid_coverage_value", [&](unsigned long) {
+            benchmark::doNotOptimize(coverage.getCoverageValue());
+        }, {{"arena_size", arenaSize}, {"cell_size", cellSize}});
+
+        /* One step of coverage marking, as in the loop functions' PostStep */
+        const auto footprint = footbotFootprint();
+        for (size_t robots : {10, 100, 1000}) {
+            auto poses = generatePoses(robots, arenaSize);
+
+            benchmark::run("coverage_grid_rays_step", [&](unsigned long) {
+                for (auto& cell : coverage.getCellsOnRays(getRays(poses, footprint, limits)))
+                    coverage.visitCell(cell);
+            }, {{"arena_size", arenaSize}, {"cell_size", cellSize}, {"robots", static_cast<double>(robots)}});
+
+            FootprintStamps stamps;
+            stamps.init(footprint, cellSize);
+            vector<CoverageGrid::Span> spans;
+            benchmark::run("coverage_grid_stamps_step", [&](unsigned long) {
+                spans.clear();
+                for (auto& pose : poses)
+                    stamps.addSpans(coverage, pose, spans);
+                coverage.visitSpans(spans);
+            }, {{"arena_size", arenaSize}, {"cell_size", cellSize}, {"robots", static_cast<double>(robots)}});
+        }
+    }
+    return 0;
+}
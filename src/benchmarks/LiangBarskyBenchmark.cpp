@@ -0,0 +1,86 @@
+#include "Benchmark.h"
+#include <utils/math/liang-barsky.h>
+#include <array>
+#include <random>
+
+using namespace std;
+
+struct Segment {
+    double x0, y0, x1, y1;
+};
+
+/* Segments of the given length, centered anywhere in a box twice as large as the clipping window */
+static vector<Segment> generateSegments(size_t segmentsNumber, double length) {
+    mt19937 generator(42);
+    uniform_real_distribution<double> coordinate(-2, 2);
+    uniform_real_distribution<double> angle(0, 2 * M_PI);
+    vector<Segment> segments(segmentsNumber);
+    for (auto& s : segments) {
+        auto x = coordinate(generator);
+        auto y = coordinate(generator);
+        auto a = angle(generator);
+        s = {x, y, x + length * cos(a), y + length * sin(a)};
+    }
+    return segments;
+}
+
+/* The same segments in structure-of-arrays layout, as LiangBarskyBatch takes them */
+struct Segments {
+    explicit Segments(const vector<Segment>& segments) {
+        for (auto& s : segments) {
+            x0.push_back(s.x0);
+            y0.push_back(s.y0);
+            x1.push_back(s.x1);
+            y1.push_back(s.y1);
+        }
+    }
+    vector<double> x0, y0, x1, y1;
+};
+
+int main() {
+    for (auto length : {0.1, 1.0, 10.0}) {
+        auto segments = generateSegments(4096, length);
+
+        size_t accepted = 0;
+        array<double, 4> clipped;
+        for (auto& s : segments)
+            if (LiangBarsky(-1, 1, -1, 1, s.x0, s.y0, s.x1, s.y1, clipped[0], clipped[1], clipped[2], clipped[3]))
+                accepted++;
+
+        benchmark::run("liang_barsky", [&](unsigned long i) {
+            auto& s = segments[i % segments.size()];
+            benchmark::doNotOptimize(LiangBarsky(-1, 1, -1, 1, s.x0, s.y0, s.x1, s.y1,
+                                                 clipped[0], clipped[1], clipped[2], clipped[3]));
+            benchmark::doNotOptimize(clipped);
+        }, {{"segment_length", length},
+            {"accepted_fraction", static_cast<double>(accepted) / segments.size()}});
+
+        /* Whole batches, the scalar function in a loop against the vectorized one */
+        const size_t batchSize = 1000000;
+        const Segments batch(generateSegments(batchSize, length));
+        Segments clippedBatch = batch;
+        vector<uint8_t> acceptedBatch(batchSize);
+
+        benchmark::run("liang_barsky_scalar_batch", [&](unsigned long) {
+            size_t acceptedNumber = 0;
+            for (size_t i = 0; i < batchSize; i++) {
+                bool isAccepted = LiangBarsky(-1, 1, -1, 1, batch.x0[i], batch.y0[i], batch.x1[i], batch.y1[i],
+                                              clippedBatch.x0[i], clippedBatch.y0[i],
+                                              clippedBatch.x1[i], clippedBatch.y1[i]);
+                acceptedBatch[i] = isAccepted;
+                acceptedNumber += isAccepted;
+            }
+            benchmark::doNotOptimize(acceptedNumber);
+        }, {{"segment_length", length}, {"segments", static_cast<double>(batchSize)}});
+
+        benchmark::run("liang_barsky_simd_batch", [&](unsigned long) {
+            benchmark::doNotOptimize(LiangBarskyBatch(-1, 1, -1, 1,
+                                                      batch.x0.data(), batch.y0.data(),
+                                                      batch.x1.data(), batch.y1.data(),
+                                                      clippedBatch.x0.data(), clippedBatch.y0.data(),
+                                                      clippedBatch.x1.data(), clippedBatch.y1.data(),
+                                                      acceptedBatch.data(), batchSize));
+        }, {{"segment_length", length}, {"segments", static_cast<double>(batchSize)}});
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "Benchmark.h"
+#include "BenchmarkMocks.h"
+#include <utils/task/TaskManager.h>
+#include <memory>
+
+using namespace std;
+using namespace argos;
+
+/*
+ * The decomposition and the sweeping of an empty square arena. One iteration
+ * is one control step: task assignment followed by a move of every handler.
+ * The manager starts over every episodeSteps steps, so all the phases of the
+ * cycle are included in the mean.
+ */
+struct Episode {
+    TaskManager manager;
+    vector<unique_ptr<benchmark::MockTaskHandler>> handlers;
+
+    Episode(size_t handlersNumber, Real arenaSize) {
+        const Real stepLength = 0.01;
+        const Real spacing = 0.3;
+        const size_t row = static_cast<size_t>((arenaSize - 1) / spacing);
+        manager.init(CRange<CVector2>(CVector2(-arenaSize / 2, -arenaSize / 2), CVector2(arenaSize / 2, arenaSize / 2)));
+        for (size_t i = 0; i < handlersNumber; i++) {
+            CVector2 position(-arenaSize / 2 + 0.5 + (i % row) * spacing, arenaSize / 2 - 0.5 - (i / row) * spacing);
+            handlers.emplace_back(new benchmark::MockTaskHandler(position, -arenaSize / 2 + 0.5, stepLength));
+            manager.registerHandler(handlers.back().get());
+        }
+    }
+
+    void step() {
+        manager.assignTasks();
+        for (auto& h : handlers)
+            h->step();
+    }
+};
+
+int main() {
+    const Real arenaSize = 10;
+    const unsigned long episodeSteps = 2000;
+    for (auto handlersNumber : {4, 10, 30, 100}) {
+        unique_ptr<Episode> episode;
+        benchmark::run("task_manager_assign_tasks", [&](unsigned long i) {
+            if (i % episodeSteps == 0)
+                episode.reset(new Episode(handlersNumber, arenaSize));
+            episode->step();
+        }, {{"handlers", handlersNumber}, {"arena_size", arenaSize}, {"episode_steps", episodeSteps}});
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "Benchmark.h"
+#include <utils/coverage/CoverageGrid.h>
+#include <utils/voronoi/VoronoiDiagram.h>
+#include <random>
+
+using namespace std;
+using namespace argos;
+
+using Positions = map<string, CVector3>;
+
+/* Robots spread over the arena, moving a little in every following frame */
+static vector<Positions> generateFrames(size_t framesNumber, size_t robotsNumber, Real arenaSize) {
+    mt19937 generator(42);
+    const Real margin = 0.1;
+    uniform_real_distribution<Real> coordinate(-arenaSize / 2 + margin, arenaSize / 2 - margin);
+    uniform_real_distribution<Real> move(-0.01, 0.01);
+
+    vector<Positions> frames(framesNumber);
+    for (size_t r = 0; r < robotsNumber; r++)
+        frames[0]["fb" + to_string(r)] = CVector3(coordinate(generator), coordinate(generator), 0);
+    for (size_t f = 1; f < framesNumber; f++) {
+        frames[f] = frames[f - 1];
+        for (auto& robot : frames[f]) {
+            CVector3 p = robot.second + CVector3(move(generator), move(generator), 0);
+            if (p.GetX() > -arenaSize / 2 + margin && p.GetX() < arenaSize / 2 - margin &&
+                p.GetY() > -arenaSize / 2 + margin && p.GetY() < arenaSize / 2 - margin)
+                robot.second = p;
+        }
+    }
+    return frames;
+}
+
+int main() {
+    const Real arenaSize = 10;
+    const CRange<CVector3> limits(CVector3(-arenaSize / 2, -arenaSize / 2, 0), CVector3(arenaSize / 2, arenaSize / 2, 1));
+
+    for (auto robotsNumber : {5, 20, 50, 100}) {
+        auto frames = generateFrames(64, robotsNumber, arenaSize);
+        VoronoiDiagram voronoi;
+        voronoi.setArenaLimits(limits);
+
+        benchmark::run("voronoi_calculate", [&](unsigned long i) {
+            voronoi.calculate(frames[i % frames.size()]);
+            benchmark::doNotOptimize(voronoi.getCells().size());
+        }, {{"robots", robotsNumber}, {"arena_size", arenaSize}});
+
+        for (auto cellSize : {0.1, 0.05}) {
+            CoverageGrid coverage(5, cellSize);
+            coverage.initGrid(limits);
+
+            benchmark::run("voronoi_calculate_with_grid", [&](unsigned long i) {
+                voronoi.calculate(frames[i % frames.size()], coverage);
+                benchmark::doNotOptimize(voronoi.getCells().size());
+            }, {{"robots", robotsNumber}, {"arena_size", arenaSize}, {"cell_size", cellSize}});
+        }
+    }
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "Cellular.h"
+#include <utils/profiling/Profiler.h>
 #include <argos3/core/utility/logging/argos_log.h>
 #include <sstream>
 
@@ -31,13 +32,12 @@ void Cellular::Init(TConfigurationNode& configuration) {
     proximitySensor = GetSensor<CCI_FootBotProximitySensor>("footbot_proximity");
     positioningSensor = GetSensor<CCI_PositioningSensor>("positioning");
     lightSensor = GetSensor<CCI_LightSensor>("light");
-    rabRx = GetSensor<CCI_RangeAndBearingSensor>("range_and_bearing");
+    targetSensor = GetSensor<CCI_TargetProximitySensor>("target_proximity");
     leds = GetActuator<CCI_LEDsActuator>("leds");
-    cameraLeft = GetSensor<CCI_ColoredBlobPerspectiveCameraSensor>("perspective_camera_left");
-    cameraRight = GetSensor<CCI_ColoredBlobPerspectiveCameraSensor>("perspective_camera_right");
-    cameraFront = GetSensor<CCI_ColoredBlobPerspectiveCameraSensor>("perspective_camera_front");
-    cameraBack = GetSensor<CCI_ColoredBlobPerspectiveCameraSensor>("perspective_camera_back");
+    beaconSensor = GetSensor<CCI_ColoredBeaconBearingSensor>("colored_beacon_bearing");
 
+    Real histogramResolution = 5;
+    GetNodeAttributeOrDefault(configuration, "histogram_resolution", histogramResolution, histogramResolution);
 //    GetNodeAttributeOrDefault(configuration, "velocity", velocity, velocity);
 //    GetNodeAttributeOrDefault(configuration, "min_distance", minDistanceFromObstacle,
 //                              minDistanceFromObstacle);
@@ -46,25 +46,24 @@ void Cellular::Init(TConfigurationNode& configuration) {
     assert(proximitySensor != nullptr);
     assert(positioningSensor != nullptr);
     assert(lightSensor != nullptr);
-    assert(rabRx != nullptr);
+    assert(targetSensor != nullptr);
     assert(leds != nullptr);
-    assert(cameraLeft != nullptr);
-    assert(cameraRight != nullptr);
-    assert(cameraFront != nullptr);
-    assert(cameraBack != nullptr);
+    assert(beaconSensor != nullptr);
 
 //    LOG << "Register me : " << this << endl;
     taskManager = loopFnc.getManager();
     taskManager->registerHandler(this);
 
-    Sensors s = { *positioningSensor, *proximitySensor, {*cameraLeft, *cameraRight, *cameraFront, *cameraBack} };
+    Sensors s = { *positioningSensor, *proximitySensor, *beaconSensor };
     Actuators a = { *wheelsEngine, *leds };
-    factory.reset( new BehaviorFactory(s,a));
-    behavior = factory->create(currentTask);
-    avoidBehavior = make_shared<AvoidObstacleBehavior>(s,a);
+    behaviors.reset(new BehaviorTable(s,a));
+    behavior = &behaviors->get(currentTask.behavior);
+    behavior->enter();
+    avoidBehavior = make_shared<AvoidObstacleBehavior>(s,a, CDegrees(histogramResolution));
 }
 
 void Cellular::Reset() {
+    switchBehavior(Task::Behavior::Idle);
     currentTask = Task();
 }
 
@@ -76,10 +75,20 @@ void Cellular::Destroy() {
 void Cellular::update(Task newTask) {
 //    LOG << "[update task]";
     if (currentTask.behavior != newTask.behavior)
-        behavior = factory->create(newTask);
+        switchBehavior(newTask.behavior);
+    behavior->setTask(newTask);
     TaskHandler::update(newTask);
 }
 
+void Cellular::switchBehavior(Task::Behavior newBehavior) {
+    auto& next = behaviors->get(newBehavior);
+    if (&next == behavior)
+        return;
+    behavior->exit();
+    behavior = &next;
+    behavior->enter();
+}
+
 CVector2 Cellular::getPosition() const {
     CVector2 position;
     positioningSensor->GetReading().Position.ProjectOntoXY(position);
@@ -103,7 +112,9 @@ bool Cellular::isReadyToProceed() const {
 }
 
 void Cellular::ControlStep() {
+    PROFILE_PHASE("control step");
 //    LOG << "[" << GetId() << "]: " << to_string(currentTask) << ", ";
+    behavior->updateSensors();
     if (currentTask.status == Task::Status::Wait)
         behavior->stop();
     else {
@@ -139,16 +150,8 @@ CVector2 Cellular::runBehavior() {
 }
 
 void Cellular::detectTargets() {
-    auto position = positioningSensor->GetReading().Position;
-    auto packets = rabRx->GetReadings();
-    for(auto& packet : packets) {
-        int id;
-        Real posX, posY, posZ;
-        packet.Data >> id >> posX >> posY >> posZ;
-        if (id == 0) continue; // Skip default message send by pso robots
-        CVector3 targetPosition(posX, posY, posZ);
-        loopFnc.addTargetPosition(id, targetPosition);
-    }
+    for (auto& reading : targetSensor->GetReadings())
+        loopFnc.addTargetPosition(reading.Id, reading.Position);
 }
 
 REGISTER_CONTROLLER(Cellular, "cellular_decomposition_controller")
@@ -6,13 +6,13 @@
 #include <plugins/robots/generic/control_interface/ci_positioning_sensor.h>
 #include <plugins/robots/foot-bot/control_interface/ci_footbot_proximity_sensor.h>
 #include <argos3/plugins/robots/generic/control_interface/ci_light_sensor.h>
-#include <argos3/plugins/robots/generic/control_interface/ci_range_and_bearing_sensor.h>
-#include <argos3/plugins/robots/generic/control_interface/ci_colored_blob_perspective_camera_sensor.h>
+#include <robots/target/ci_target_proximity_sensor.h>
+#include <robots/custom-foot-bot/control_interface/ci_colored_beacon_bearing_sensor.h>
 #include <argos3/plugins/robots/generic/control_interface/ci_leds_actuator.h>
 
 #include <loop_functions/cellular_decomposition/CellularDecomposition.h>
 #include <utils/task/TaskHandler.h>
-#include <utils/task/BehaviorFactory.h>
+#include <utils/task/BehaviorTable.h>
 #include <utils/task/behaviors/AvoidObstacleBehavior.h>
 
 
@@ -41,17 +41,14 @@ private:
     CCI_FootBotProximitySensor* proximitySensor = nullptr;
     CCI_PositioningSensor* positioningSensor = nullptr;
     CCI_LightSensor* lightSensor = nullptr;
-    CCI_RangeAndBearingSensor* rabRx = nullptr;
+    CCI_TargetProximitySensor* targetSensor = nullptr;
     CCI_LEDsActuator* leds = nullptr;
-    CCI_ColoredBlobPerspectiveCameraSensor* cameraLeft = nullptr;
-    CCI_ColoredBlobPerspectiveCameraSensor* cameraRight = nullptr;
-    CCI_ColoredBlobPerspectiveCameraSensor* cameraFront = nullptr;
-    CCI_ColoredBlobPerspectiveCameraSensor* cameraBack = nullptr;
+    CCI_ColoredBeaconBearingSensor* beaconSensor = nullptr;
 
     std::shared_ptr<TaskManager> taskManager;
     CellularDecomposition& loopFnc;
-    std::unique_ptr<BehaviorFactory> factory;
-    std::shared_ptr<ControllerBehavior> behavior;
+    std::unique_ptr<BehaviorTable> behaviors;
+    ControllerBehavior* behavior = nullptr;
     std::shared_ptr<AvoidObstacleBehavior> avoidBehavior;
 
     bool criticalPointDetected = false;
@@ -60,6 +57,7 @@ private:
     bool readyToProceed = false;
 
     void logCurrentTask() const;
+    void switchBehavior(Task::Behavior newBehavior);
     CVector2 runBehavior();
     void detectTargets();
 };
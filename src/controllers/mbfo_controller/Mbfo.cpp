@@ -1,4 +1,5 @@
 #include "Mbfo.h"
+#include <utils/profiling/Profiler.h>
 
 #include <assert.h>
 
@@ -33,7 +34,7 @@ void Mbfo::Init(TConfigurationNode& configuration) {
     proximitySensor = GetSensor<CCI_FootBotProximitySensor>("footbot_proximity");
     positioningSensor = GetSensor<CCI_PositioningSensor>("positioning");
     lightSensor = GetSensor<CCI_LightSensor>("light");
-    rabRx = GetSensor<CCI_RangeAndBearingSensor>("range_and_bearing");
+    targetSensor = GetSensor<CCI_TargetProximitySensor>("target_proximity");
 
     GetNodeAttributeOrDefault(configuration, "velocity", velocity, velocity);
     GetNodeAttributeOrDefault(configuration, "min_distance", minDistanceFromObstacle,
@@ -45,7 +46,7 @@ void Mbfo::Init(TConfigurationNode& configuration) {
     assert(proximitySensor != nullptr);
     assert(positioningSensor != nullptr);
     assert(lightSensor != nullptr);
-    assert(rabRx != nullptr);
+    assert(targetSensor != nullptr);
     assert(coverage != nullptr);
 }
 
@@ -54,6 +55,7 @@ void Mbfo::Reset() {
 }
 
 void Mbfo::ControlStep() {
+    PROFILE_PHASE("control step");
     if (!stopped) {
         CDegrees robotsOrientation = getOrientationOnXY();
         if (step % CHEMOTAXIS_LENGTH == 0)
@@ -78,14 +80,8 @@ void Mbfo::detectTarget() const {
     }
     averageReading /= lightReadings.size();*/
 
-    auto packets = rabRx->GetReadings();
-    for(auto& packet : packets) {
-        int id;
-        Real posX, posY, posZ;
-        packet.Data >> id >> posX >> posY >> posZ;
-        if (id == 0) continue; // Skip default message send by mbfo robots
-        loopFnc.addTargetPosition(id, CVector3(posX, posY, posZ));
-    }
+    for (auto& reading : targetSensor->GetReadings())
+        loopFnc.addTargetPosition(reading.Id, reading.Position);
 }
 
 CDegrees Mbfo::getOrientationOnXY() {
@@ -154,13 +150,14 @@ CVector3 Mbfo::calculateRobotsInteractionForce() const {
 }
 
 bool Mbfo::isCellDone(const VoronoiDiagram::Cell& cell) const {
-    int maxCellConcentration = 0;
     for (auto cellIndex : cell.coverageCells) {
-        int concentration = coverage->getGrid().at(cellIndex.x).at(cellIndex.y).concentration;
-        if (concentration > maxCellConcentration)
-            maxCellConcentration = concentration;
+        const CoverageGrid::CellIndex index(cellIndex.x, cellIndex.y);
+        /* Cells of covered tiles need no lookup */
+        if (coverage->getTileState(index) != CoverageGrid::TileState::covered &&
+            coverage->getConcentration(index) != 0)
+            return false;
     }
-    return maxCellConcentration == 0;
+    return true;
 }
 
 void Mbfo::chooseBestDirectionFromVector(vector<Mbfo::NextDirection>& nextBestDirections) {
@@ -203,14 +200,14 @@ std::vector<Mbfo::NextDirection> Mbfo::findNextBestDirectionsInVoronoiCell(const
     Real bestValue = 0;
     for (auto& i : cell.coverageCells) {
         CVector2 v(i.x, i.y);
-        auto& gridCell = getCoverageCell(v);
+        int concentration = coverage->getConcentration({i.x, i.y});
 
         // Take only cells that are better or same as current bestValue
-        if (bestValue <= gridCell.concentration) {
-            bestValue = gridCell.concentration;
+        if (bestValue <= concentration) {
+            bestValue = concentration;
             Real distance = calculateDistance(v, positionCellIndex);
-            CDegrees angle = getAngleBetweenPoints(realPosition, gridCell.center);
-            nextDirections.push_back(NextDirection{gridCell.concentration, distance, angle, v});
+            CDegrees angle = getAngleBetweenPoints(realPosition, coverage->getCellCenter({i.x, i.y}));
+            nextDirections.push_back(NextDirection{concentration, distance, angle, v});
         }
     }
 
@@ -232,11 +229,6 @@ std::vector<Mbfo::NextDirection> Mbfo::findNextBestDirectionsInVoronoiCell(const
     return nextDirections;
 }
 
-const CoverageGrid::Cell& Mbfo::getCoverageCell(CVector2 index) const {
-    assert(coverage != nullptr);
-    return coverage->getGrid().at(index.GetX()).at(index.GetY());
-}
-
 const VoronoiDiagram::Cell& Mbfo::getVoronoiCell(string cellId) {
     const auto cell = loopFnc.getVoronoiCell(cellId);
     assert(cell != nullptr);
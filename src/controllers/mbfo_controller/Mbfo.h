@@ -6,7 +6,7 @@
 #include <plugins/robots/generic/control_interface/ci_positioning_sensor.h>
 #include <plugins/robots/foot-bot/control_interface/ci_footbot_proximity_sensor.h>
 #include <argos3/plugins/robots/generic/control_interface/ci_light_sensor.h>
-#include <argos3/plugins/robots/generic/control_interface/ci_range_and_bearing_sensor.h>
+#include <robots/target/ci_target_proximity_sensor.h>
 
 #include <loop_functions/mbfo/MbfoLoopFunction.h>
 
@@ -41,7 +41,7 @@ private:
     CCI_FootBotProximitySensor* proximitySensor = nullptr;
     CCI_PositioningSensor* positioningSensor = nullptr;
     CCI_LightSensor* lightSensor = nullptr;
-    CCI_RangeAndBearingSensor* rabRx = nullptr;
+    CCI_TargetProximitySensor* targetSensor = nullptr;
 
     bool stopped;
     Real velocity;
@@ -63,7 +63,6 @@ private:
     }
     CDegrees getOrientationOnXY();
     bool isCellDone(const VoronoiDiagram::Cell& cell) const;
-    const CoverageGrid::Cell& getCoverageCell(CVector2 index) const;
     const VoronoiDiagram::Cell& getVoronoiCell(std::string cellId);
     CDegrees getAngleBetweenPoints(const CVector3 &a, const CVector3 &b) const;
 
@@ -2,6 +2,7 @@
 #include <assert.h>
 
 #include <iostream>
+#include <utils/profiling/Profiler.h>
 #include "PsoController.h"
 
 using namespace std;
@@ -29,7 +30,7 @@ void PsoController::Init(TConfigurationNode& configuration) {
     proximitySensor = GetSensor<CCI_FootBotProximitySensor>("footbot_proximity");
     positioningSensor = GetSensor<CCI_PositioningSensor>("positioning");
     lightSensor = GetSensor<CCI_LightSensor>("light");
-    rabRx = GetSensor<CCI_RangeAndBearingSensor>("range_and_bearing");
+    targetSensor = GetSensor<CCI_TargetProximitySensor>("target_proximity");
 
     std::string targetTypeStr;
     GetNodeAttribute(configuration, "target", targetTypeStr);
@@ -46,7 +47,7 @@ void PsoController::Init(TConfigurationNode& configuration) {
     assert(proximitySensor != nullptr);
     assert(positioningSensor != nullptr);
     assert(lightSensor != nullptr);
-    assert(rabRx != nullptr);
+    assert(targetSensor != nullptr);
 
     if (targetTypeStr == "light")
         targetType = TargetType::Light;
@@ -67,6 +68,7 @@ void PsoController::Init(TConfigurationNode& configuration) {
 }
 
 void PsoController::ControlStep() {
+    PROFILE_PHASE("control step");
     CVector2 obstacleProximity = getWeightedProximityReading();
     CCI_PositioningSensor::SReading positioningReading = positioningSensor->GetReading();
     updateUtilities(positioningReading);
@@ -117,16 +119,8 @@ double PsoController::getCurrentUtilityValue() {
 }
 
 void PsoController::detectTargets() {
-    auto position = positioningSensor->GetReading().Position;
-    auto packets = rabRx->GetReadings();
-    for(auto& packet : packets) {
-        int id;
-        Real posX, posY, posZ;
-        packet.Data >> id >> posX >> posY >> posZ;
-        if (id == 0) continue; // Skip default message send by pso robots
-        CVector3 targetPosition(posX, posY, posZ);
-        loopFnc.addTargetPosition(id, targetPosition);
-    }
+    for (auto& reading : targetSensor->GetReadings())
+        loopFnc.addTargetPosition(reading.Id, reading.Position);
 }
 
 double PsoController::getAverageLightValue() const {
@@ -9,7 +9,7 @@
 
 #include <loop_functions/pso/ClosestDistance.h>
 #include <random>
-#include <argos3/plugins/robots/generic/control_interface/ci_range_and_bearing_sensor.h>
+#include <robots/target/ci_target_proximity_sensor.h>
 
 
 namespace argos {
@@ -35,7 +35,7 @@ private:
     CCI_FootBotProximitySensor* proximitySensor = nullptr;
     CCI_PositioningSensor* positioningSensor = nullptr;
     CCI_LightSensor* lightSensor = nullptr;
-    CCI_RangeAndBearingSensor* rabRx = nullptr;
+    CCI_TargetProximitySensor* targetSensor = nullptr;
 
     ClosestDistance& loopFnc;
 
@@ -1,4 +1,5 @@
 #include "Target.h"
+#include <robots/target/target_index.h>
 #include <assert.h>
 
 namespace argos {
@@ -8,28 +9,18 @@ void Target::Init(TConfigurationNode& configuration) {
     positioningSensor = GetSensor<CCI_PositioningSensor>("positioning");
     assert(rabTx != nullptr);
     assert(positioningSensor != nullptr);
+    id = CTargetIndex::ParseId(GetId());
 }
 
 void Target::ControlStep() {
     CByteArray data;
-    data << getId();
+    data << id;
     data << positioningSensor->GetReading().Position.GetX();
     data << positioningSensor->GetReading().Position.GetY();
     data << positioningSensor->GetReading().Position.GetZ();
     rabTx->SetData(data);
 }
 
-int Target::getId() const {
-    auto strId = GetId();
-    size_t lastNotNumberCharacterIndex = strId.find_last_not_of("0123456789");
-
-    int id;
-    std::stringstream stream;
-    stream << strId.substr(lastNotNumberCharacterIndex + 1);
-    stream >> id;
-    return id + 1;
-}
-
 void Target::Reset() {
     rabTx->ClearData();
 }
@@ -20,7 +20,8 @@ private:
     CCI_RangeAndBearingActuator*  rabTx = nullptr;
     CCI_PositioningSensor* positioningSensor = nullptr;
 
-    int getId() const;
+    /* Number the robots report to the loop functions, parsed once from the string id */
+    UInt32 id = 0;
 };
 
 }
@@ -4,7 +4,8 @@ include(ARGoSCheckQTOpenGL)
 
 function(add_qt_loop_lib NAME)
     if(NOT ARGOS_COMPILE_QTOPENGL)
-        message(FATAL_ERROR "No QT libraries was found!")
+        message(STATUS "Skipping ${NAME}, Qt/OpenGL visualization is not compiled")
+        return()
     endif()
 
     set(options)
@@ -1,6 +1,5 @@
 #include "CellularDecomposition.h"
 #include <argos3/plugins/simulator/entities/proximity_sensor_equipped_entity.h>
-#include <cstdio>
 
 using namespace std;
 using namespace argos;
@@ -11,6 +10,10 @@ CellularDecomposition::CellularDecomposition()
 {}
 
 void CellularDecomposition::Init(TConfigurationNode& t_tree) {
+    parseCoverageConfig(t_tree);
+    parseHeatmapConfig(t_tree);
+    parseTrajectoryConfig(t_tree);
+    parseProfilingConfig(t_tree);
     Reset();
     parseLogConfig(t_tree);
     try {
@@ -23,18 +26,67 @@ void CellularDecomposition::Init(TConfigurationNode& t_tree) {
 
 void CellularDecomposition::parseLogConfig(TConfigurationNode& t_tree) {
     log.name = "pso.log";
+    UInt32 flushInterval = RunLogWriter::defaultFlushInterval;
     try {
         TConfigurationNode& conf = GetNode(t_tree, "log");
         GetNodeAttribute(conf, "path", log.name);
+        GetNodeAttributeOrDefault(conf, "flush_interval", flushInterval, flushInterval);
         LOG << "Log file: " << log.name << endl;
+        TConfigurationNodeIterator it("threshold");
+        it = it.begin(&conf);
+        double threshold = 0;
+        while (it != NULL) {
+            GetNodeAttribute(*it, "value", threshold);
+            thresholdsToLog.push_back(threshold);
+            it++;
+        }
     }
     catch (CARGoSException& e) {
         LOGERR << "Error parsing log config! " <<  e.what() << endl;
     }
+    log.file.open(log.name, {RunLog::EventType::Threshold, RunLog::EventType::Target}, flushInterval);
+}
+
+void CellularDecomposition::parseHeatmapConfig(TConfigurationNode& t_tree) {
+    if (!NodeExists(t_tree, "heatmap"))
+        return;
+    TConfigurationNode& conf = GetNode(t_tree, "heatmap");
+    GetNodeAttribute(conf, "path", heatmapConfig.path);
+    GetNodeAttributeOrDefault(conf, "interval", heatmapConfig.frameInterval, heatmapConfig.frameInterval);
+    GetNodeAttributeOrDefault(conf, "keyframe_interval", heatmapConfig.keyframeInterval, heatmapConfig.keyframeInterval);
+    LOG << "Heatmap file: " << heatmapConfig.path << endl;
+}
+
+void CellularDecomposition::parseTrajectoryConfig(TConfigurationNode& t_tree) {
+    if (!NodeExists(t_tree, "trajectory"))
+        return;
+    TConfigurationNode& conf = GetNode(t_tree, "trajectory");
+    GetNodeAttribute(conf, "path", trajectory.path);
+    GetNodeAttributeOrDefault(conf, "resolution", trajectory.resolution, trajectory.resolution);
+    LOG << "Trajectory file: " << trajectory.path << endl;
+}
+
+void CellularDecomposition::parseCoverageConfig(TConfigurationNode& t_tree) {
+    if (NodeExists(t_tree, "coverage"))
+        GetNodeAttributeOrDefault(GetNode(t_tree, "coverage"), "enabled", coverageEnabled, coverageEnabled);
+    LOG << "Coverage tracking " << (coverageEnabled ? "enabled" : "disabled") << endl;
+}
+
+void CellularDecomposition::parseProfilingConfig(TConfigurationNode& t_tree) {
+    if (!NodeExists(t_tree, "profiling"))
+        return;
+    TConfigurationNode& conf = GetNode(t_tree, "profiling");
+    GetNodeAttributeOrDefault(conf, "trace", profiling.trace, profiling.trace);
+    GetNodeAttributeOrDefault(conf, "histograms", profiling.histograms, profiling.histograms);
+    if (!Profiler::enabled)
+        LOGERR << "Profiling output requested, but the build has COVERAGE_SEARCH_PROFILING off" << endl;
 }
 
 void CellularDecomposition::Destroy() {
-    saveLog();
+    log.file.close();
+    heatmap.close();
+    trajectory.file.close();
+    Profiler::exportOutputs(profiling);
 }
 
 void CellularDecomposition::PreStep() {
@@ -44,56 +96,46 @@ void CellularDecomposition::PreStep() {
 }
 
 void CellularDecomposition::PostStep() {
-    taskManager->assignTasks();
-//    std::vector<CoverageGrid::CellIndex> affectedCells = getCellsCoveredByRobots();
-//    removeDuplicates(affectedCells);
-//    try {
-//        updateCoverageCells(affectedCells);
-//    }
-//    catch(std::exception& e) {
-//        THROW_ARGOSEXCEPTION_NESTED("Error during concentration update!", e)
-//    }
+    {
+        PROFILE_PHASE("ownership");
+        taskManager->assignTasks();
+    }
+    if (coverageEnabled) {
+        PROFILE_PHASE("coverage");
+        updateCoverageCells();
+        checkPercentageCoverage();
+    }
+    PROFILE_PHASE("log");
+    if (coverageEnabled)
+        heatmap.update(GetSpace().GetSimulationClock());
+    if (trajectory.file.isOpen())
+        trajectory.file.writeFrame(GetSpace().GetSimulationClock(), trajectory.poses);
+    log.file.update(GetSpace().GetSimulationClock());
 //    LOG << "=====================================" << endl;
 }
 
-std::vector<CoverageGrid::CellIndex> CellularDecomposition::getCellsCoveredByRobots() const {
-    std::vector<CoverageGrid::CellIndex> affectedCells;
-    auto delta = coverage.getCellSize() / 2;
-    for (auto ray : rays) {
-        auto rayLength = ray.GetLength();
-        while (rayLength > 0) {
-            try {
-                affectedCells.emplace_back(coverage.getCellIndex(ray.GetEnd()));
-            }
-            catch(std::exception& e) {
-                std::stringstream s;
-                s << "Error during concentration update for ray end (" << ray.GetEnd() << ")";
-                THROW_ARGOSEXCEPTION_NESTED(s.str(), e);
-            }
-            rayLength = ray.GetLength() - delta;
-            ray.SetLength(rayLength);
-        }
+void CellularDecomposition::checkPercentageCoverage() {
+    /* Several thresholds may be crossed in one step, each of them is logged */
+    const auto percentageCoverage = coverage.getVisitedCoverageValue();
+    while (thresholdsToLog.size() > 0 && percentageCoverage >= thresholdsToLog.front()) {
+        LOG << "Threshold " << thresholdsToLog.front() << "% achieved!" << endl;
+        log.file.writeThreshold(GetSpace().GetSimulationClock(), percentageCoverage);
+        thresholdsToLog.pop_front();
     }
-    return affectedCells;
-}
-
-void CellularDecomposition::removeDuplicates(std::vector<CoverageGrid::CellIndex>& cells) const {
-    std::sort(cells.begin(), cells.end());
-    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
 }
 
-void CellularDecomposition::updateCoverageCells(const std::vector<CoverageGrid::CellIndex>& affectedCells) {
-    for (auto &cell : affectedCells) {
-        unsigned x = cell.first;
-        unsigned y = cell.second;
-        coverage.getGrid()[x][y].concentration /= 2;
-    }
+void CellularDecomposition::updateCoverageCells() {
+    coveredSpans.clear();
+    for (auto& pose : trajectory.poses)
+        stamps.addSpans(coverage, pose, coveredSpans);
+    coverage.visitSpans(coveredSpans);
 }
 
 void CellularDecomposition::addTargetPosition(int id, const CVector3& position) {
+    PROFILE_PHASE("log");
     std::lock_guard<std::mutex> guard(tagetPositionUpdateMutex);
-    if (log.targets.find(id) == log.targets.end()) {
-        log.targets[id] = { GetSpace().GetSimulationClock(), position };
+    if (log.targets.insert(id).second) {
+        log.file.writeTarget(GetSpace().GetSimulationClock(), id, position.GetX(), position.GetY(), position.GetZ());
         LOG << "Target was found!" << endl;
     }
 }
@@ -107,31 +149,77 @@ void CellularDecomposition::Reset() {
     taskManager->init(CRange<CVector2>(limitsMin, limitsMax));
 
     coverage.initGrid(GetSpace().GetArenaLimits());
+    if (coverageEnabled && !heatmapConfig.path.empty())
+        heatmap.open(heatmapConfig, coverage);
     PreStep();
+    if (coverageEnabled || !trajectory.path.empty())
+        initFootprint(GetSpace().GetEntitiesByType("foot-bot"));
+    if (!trajectory.path.empty())
+        openTrajectory(GetSpace().GetEntitiesByType("foot-bot"));
 }
 
 void CellularDecomposition::updateRobotsPositions(const CSpace::TMapPerType &entities) {
-    rays.clear();
+    PROFILE_PHASE("positions");
+    trajectory.poses.clear();
     for (const auto& entity : entities) {
         auto& footbot = *(any_cast<CCustomFootBotEntity*>(entity.second));
         auto position = footbot.GetEmbodiedEntity().GetOriginAnchor().Position;
-        addRobotsRays(footbot);
         robotsPositions[footbot.GetId()] = position;
+        CRadians yaw, pitch, roll;
+        footbot.GetEmbodiedEntity().GetOriginAnchor().Orientation.ToEulerAngles(yaw, pitch, roll);
+        trajectory.poses.push_back({position.GetX(), position.GetY(), yaw.GetValue()});
     }
 }
 
-void CellularDecomposition::addRobotsRays(CCustomFootBotEntity& footbot) {
+void CellularDecomposition::initFootprint(const CSpace::TMapPerType& entities) {
+    if (entities.empty())
+        return;
+    /* All robots carry the same sensors */
+    footprint = getFootprint(*any_cast<CCustomFootBotEntity*>(entities.begin()->second));
+    stamps.init(footprint, coverage.getCellSize());
+}
+
+std::vector<CVector3> CellularDecomposition::getRaysEnds(CCustomFootBotEntity& footbot) const {
+    if (!footbot.HasComponents(CCustomFootBotEntity::COMPONENT_PROXIMITY))
+        THROW_ARGOSEXCEPTION("The coverage rays of " << footbot.GetId() << " need the proximity component");
+    std::vector<CVector3> ends;
     auto& proximityEntity = footbot.GetProximitySensorEquippedEntity();
     for(UInt32 i = 0; i < proximityEntity.GetNumSensors(); ++i) {
-        CVector3 cRayStart, cRayEnd;
-        cRayStart = footbot.GetEmbodiedEntity().GetOriginAnchor().Position;
+        CVector3 cRayEnd;
         cRayEnd = proximityEntity.GetSensor(i).Offset;
         cRayEnd += proximityEntity.GetSensor(i).Direction;
         cRayEnd.Rotate(proximityEntity.GetSensor(i).Anchor.Orientation);
         cRayEnd += proximityEntity.GetSensor(i).Anchor.Position;
-        wrapPointToArenaLimits(cRayEnd);
-        rays.emplace_back(cRayStart, cRayEnd);
+        ends.push_back(cRayEnd);
+    }
+    return ends;
+}
+
+std::vector<Trajectory::Point> CellularDecomposition::getFootprint(CCustomFootBotEntity& footbot) const {
+    auto& anchor = footbot.GetEmbodiedEntity().GetOriginAnchor();
+    CRadians yaw, pitch, roll;
+    anchor.Orientation.ToEulerAngles(yaw, pitch, roll);
+    std::vector<Trajectory::Point> footprint;
+    for (auto& rayEnd : getRaysEnds(footbot)) {
+        rayEnd -= anchor.Position;
+        rayEnd.RotateZ(-yaw);
+        footprint.push_back({{rayEnd.GetX(), rayEnd.GetY(), rayEnd.GetZ()}});
     }
+    return footprint;
+}
+
+void CellularDecomposition::openTrajectory(const CSpace::TMapPerType& entities) {
+    if (entities.empty())
+        THROW_ARGOSEXCEPTION("No robots to record the trajectory of!");
+    Trajectory::Header header;
+    auto limits = GetSpace().GetArenaLimits();
+    header.positionResolution = trajectory.resolution;
+    header.arenaMin = {{limits.GetMin().GetX(), limits.GetMin().GetY(), limits.GetMin().GetZ()}};
+    header.arenaMax = {{limits.GetMax().GetX(), limits.GetMax().GetY(), limits.GetMax().GetZ()}};
+    header.footprint = footprint;
+    for (const auto& entity : entities)
+        header.robots.push_back(entity.first);
+    trajectory.file.open(trajectory.path, header);
 }
 
 void CellularDecomposition::wrapPointToArenaLimits(CVector3 &point) {
@@ -155,6 +243,17 @@ const std::map<std::string, CVector3> CellularDecomposition::getRobotsPositions(
 }
 
 const std::vector<argos::CRay3> CellularDecomposition::getRays() {
+    std::vector<CRay3> rays;
+    for (auto& pose : trajectory.poses) {
+        const CVector3 rayStart(pose.x, pose.y, 0);
+        for (auto& point : footprint) {
+            CVector3 rayEnd(point[0], point[1], point[2]);
+            rayEnd.RotateZ(CRadians(pose.yaw));
+            rayEnd += rayStart;
+            wrapPointToArenaLimits(rayEnd);
+            rays.emplace_back(rayStart, rayEnd);
+        }
+    }
     return rays;
 }
 
@@ -162,25 +261,4 @@ bool CellularDecomposition::IsExperimentFinished() {
     return log.targets.size() >= targetsNumber;
 }
 
-void CellularDecomposition::saveLog() {
-    printf("Save logfile %s!\n", log.name.c_str());
-    log.file.open(log.name);
-    log.file << "{\n";
-
-    log.file << "\"targets\" : [\n";
-    for (auto& target : log.targets) {
-        log.file << "\t" "{ "
-        << "\"id\" : " << target.first << ", "
-        << "\"step\" : " << target.second.step << ", "
-        << "\"position\" : [" << target.second.position << "]"
-        << " },\n";
-    }
-    if (log.targets.size() != 0)
-        log.file.seekp(-2, ios_base::end);
-    log.file << "\n]\n";
-
-    log.file << "}";
-    log.file.close();
-}
-
 REGISTER_LOOP_FUNCTIONS(CellularDecomposition, "cellular_loop_fcn")
@@ -3,7 +3,14 @@
 #include <argos3/core/simulator/loop_functions.h>
 #include <robots/custom-foot-bot/simulator/footbot_entity.h>
 #include <utils/coverage/CoverageGrid.h>
+#include <utils/coverage/CoverageRecorder.h>
+#include <utils/coverage/FootprintStamps.h>
 #include <utils/task/TaskManager.h>
+#include <utils/log/RunLogWriter.h>
+#include <utils/log/TrajectoryWriter.h>
+#include <utils/profiling/Profiler.h>
+#include <list>
+#include <set>
 
 class CellularDecomposition : public argos::CLoopFunctions {
 public:
@@ -27,37 +34,52 @@ public:
     const std::vector<argos::CRay3> getRays();
 
 private:
-    struct Target {
-        using Id = int;
-        argos::UInt32 step;
-        argos::CVector3 position;
+    struct TrajectoryLog {
+        std::string path;
+        double resolution = TrajectoryWriter::defaultPositionResolution;
+        TrajectoryWriter file;
+        std::vector<Trajectory::Pose> poses;
     };
 
     struct CellularLog {
         std::string name;
-        std::ofstream file;
-        std::map<Target::Id, Target> targets;
+        RunLogWriter file;
+        std::set<int> targets;
     };
 
     std::shared_ptr<TaskManager> taskManager;
     CoverageGrid coverage;
+    CoverageRecorder::Config heatmapConfig;
+    CoverageRecorder heatmap;
     std::map<std::string, argos::CVector3> robotsPositions;
-    std::vector<argos::CRay3> rays;
+    /* Ray ends in the robot frame, the same for all robots */
+    std::vector<Trajectory::Point> footprint;
+    FootprintStamps stamps;
+    std::vector<CoverageGrid::Span> coveredSpans;
 
     std::mutex tagetPositionUpdateMutex;
     unsigned targetsNumber;
     argos::CVector2 position;
     CellularLog log;
+    TrajectoryLog trajectory;
+    Profiler::Outputs profiling;
+    std::list<double> thresholdsToLog;
+    bool coverageEnabled = true;
 
     void parseLogConfig(argos::TConfigurationNode& t_tree);
-    void saveLog();
+    void parseHeatmapConfig(argos::TConfigurationNode& t_tree);
+    void parseTrajectoryConfig(argos::TConfigurationNode& t_tree);
+    void parseCoverageConfig(argos::TConfigurationNode& t_tree);
+    void parseProfilingConfig(argos::TConfigurationNode& t_tree);
 
     void updateRobotsPositions(const argos::CSpace::TMapPerType& entities);
-    void addRobotsRays(argos::CCustomFootBotEntity& footbot);
+    std::vector<argos::CVector3> getRaysEnds(argos::CCustomFootBotEntity& footbot) const;
+    std::vector<Trajectory::Point> getFootprint(argos::CCustomFootBotEntity& footbot) const;
+    void openTrajectory(const argos::CSpace::TMapPerType& entities);
     void wrapPointToArenaLimits(argos::CVector3 &point);
-    std::vector<CoverageGrid::CellIndex> getCellsCoveredByRobots() const;
-    void removeDuplicates(std::vector<CoverageGrid::CellIndex>& cells) const;
-    void updateCoverageCells(const std::vector<CoverageGrid::CellIndex>& affectedCells);
+    void initFootprint(const argos::CSpace::TMapPerType& entities);
+    void updateCoverageCells();
+    void checkPercentageCoverage();
 };
 
 
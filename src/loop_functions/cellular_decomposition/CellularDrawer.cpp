@@ -5,59 +5,70 @@ using namespace argos;
 
 CellularDrawer::CellularDrawer()
     : loopFnc(dynamic_cast<CellularDecomposition&>(CSimulator::GetInstance().GetLoopFunctions()))
+    , coverageTexture(gridColor, CColor(0, 0, 0, 0))
+    , taskCellsOverlay(1.0f, taskCellPointSize)
 {}
 
 void CellularDrawer::DrawInWorld() {
-//    drawCoverageGrid();
-    drawTaskCells();
+    /* Camera moves redraw the scene without changing the coverage or the tasks */
+    const auto clock = CSimulator::GetInstance().GetSpace().GetSimulationClock();
+    const bool changed = clock != updateClock;
+    updateClock = clock;
+    drawCoverageGrid(changed);
+    drawTaskCells(changed);
 }
 
-void CellularDrawer::drawTaskCells() {
-    auto cells = loopFnc.getTaskCells();
-    Real liftOnZ = 0.011f;
-    for (auto& cell : cells)
-        drawCell(cell, liftOnZ);
+void CellularDrawer::drawTaskCells(bool changed) {
+    if (changed) {
+        taskCellsOverlay.clear();
+        Real liftOnZ = 0.011f;
+        for (auto& cell : loopFnc.getTaskCells())
+            addCell(cell, liftOnZ);
+    }
+    taskCellsOverlay.draw();
 }
 
-void CellularDrawer::drawCell(const TaskCell& cell, Real liftOnZ) {
-    DrawPoint(
-        CVector3(cell.getBeginning().GetX(), cell.getBeginning().GetY(), liftOnZ),
-        CColor::CYAN,
-        10
-    );
-    DrawPoint(
-        CVector3(cell.getEnd().GetX(), cell.getEnd().GetY(), liftOnZ),
-        CColor::CYAN,
-        10
-    );
+void CellularDrawer::addCell(const TaskCell& cell, Real liftOnZ) {
+    taskCellsOverlay.addPoint(CVector3(cell.getBeginning().GetX(), cell.getBeginning().GetY(), liftOnZ),
+                              taskCellColor);
+    taskCellsOverlay.addPoint(CVector3(cell.getEnd().GetX(), cell.getEnd().GetY(), liftOnZ), taskCellColor);
 }
 
-void CellularDrawer::drawCoverageGrid() {
-    auto grid = loopFnc.getCoverageGrid();
-    for (int i = 0; i < grid.getGrid().size(); i++)
-        for (int j = 0; j < grid.getGrid().size(); j++)
-            drawCoverageCell(grid.getGrid().at(i).at(j));
+void CellularDrawer::drawCoverageGrid(bool changed) {
+    if (changed) {
+        const auto& grid = loopFnc.getCoverageGrid();
+        coverageTexture.updateConcentrations(grid);
+        coverageTexture.updateOwners(getCellsOwners(grid));
+    }
+    coverageTexture.draw();
 }
 
-void CellularDrawer::drawCoverageCell(const CoverageGrid::Cell& cell) {
-    std::vector<CVector2> points;
-    const auto& start = cell.edges.front().GetStart();
-    points.emplace_back(start.GetX(), start.GetY());
-    for (auto& edge : cell.edges)
-        points.emplace_back(edge.GetEnd().GetX(), edge.GetEnd().GetY());
-    points.pop_back();
-    auto maxConcentration = loopFnc.maxCellConcentration;
-    CColor color;
-    auto colorValue
-        = gridFloorDiff * (static_cast<double>(cell.concentration) / maxConcentration);
-    colorValue += gridColor;
-    color = CColor(colorValue, colorValue, colorValue);
-    DrawPolygon(
-            CVector3(0,0,start.GetZ()),
-            CQuaternion(CRadians::ZERO, CVector3(1,0,0)),
-            points,
-            color,
-            true);
+vector<int> CellularDrawer::getCellsOwners(const CoverageGrid& grid) {
+    const size_t width = grid.getWidth();
+    const size_t height = grid.getHeight();
+    vector<int> owners(width * height, CoverageTexture::noOwner);
+    if (owners.empty())
+        return owners;
+
+    /* Task cells own the grid cells inside the area they have explored so far */
+    const auto origin = grid.getExtent().GetMin();
+    const auto cellSize = grid.getCellSize();
+    auto getIndex = [&](Real position, Real min, size_t size) {
+        const auto index = floor((position - min) / cellSize);
+        return static_cast<size_t>(std::max<Real>(0, std::min<Real>(index, size - 1)));
+    };
+    int owner = 0;
+    for (const TaskCell& taskCell : loopFnc.getTaskCells()) {
+        const auto& limits = taskCell.getLimits();
+        const auto minX = getIndex(limits.GetMin().GetX(), origin.GetX(), width);
+        const auto maxX = getIndex(limits.GetMax().GetX(), origin.GetX(), width);
+        const auto minY = getIndex(limits.GetMin().GetY(), origin.GetY(), height);
+        const auto maxY = getIndex(limits.GetMax().GetY(), origin.GetY(), height);
+        for (auto x = minX; x <= maxX; x++)
+            fill_n(owners.begin() + x * height + minY, maxY - minY + 1, owner);
+        owner++;
+    }
+    return owners;
 }
 
 REGISTER_QTOPENGL_USER_FUNCTIONS(CellularDrawer, "cellular_loop_function_qt")
@@ -2,6 +2,8 @@
 
 #include <argos3/plugins/simulator/visualizations/qt-opengl/qtopengl_user_functions.h>
 #include <argos3/plugins/robots/foot-bot/simulator/footbot_entity.h>
+#include <loop_functions/visualization/CoverageTexture.h>
+#include <loop_functions/visualization/LineOverlay.h>
 #include "CellularDecomposition.h"
 
 class CellularDrawer : public argos::CQTOpenGLUserFunctions {
@@ -11,12 +13,17 @@ public:
     void DrawInWorld() override;
 private:
     const argos::UInt8 gridColor = 40;
-    const argos::UInt8 gridFloorDiff = 255 - gridColor;
+    const argos::CColor taskCellColor = argos::CColor::CYAN;
+    const argos::Real taskCellPointSize = 10.0f;
     CellularDecomposition& loopFnc;
+    CoverageTexture coverageTexture;
+    LineOverlay taskCellsOverlay;
+    /* Simulation step the texture and the overlay were last updated for */
+    argos::UInt32 updateClock = std::numeric_limits<argos::UInt32>::max();
 
-    void drawCoverageGrid();
-    void drawCoverageCell(const CoverageGrid::Cell& cell);
+    void drawCoverageGrid(bool changed);
+    std::vector<int> getCellsOwners(const CoverageGrid& grid);
 
-    void drawTaskCells();
-    void drawCell(const TaskCell& cell, argos::Real liftOnZ);
+    void drawTaskCells(bool changed);
+    void addCell(const TaskCell& cell, argos::Real liftOnZ);
 };
@@ -11,7 +11,7 @@ public:
     virtual ~CoverageCalculator() {}
     virtual void Init(argos::TConfigurationNode& t_tree) override;
 
-    std::vector<argos::CRay3> getGrid();
+    const CoverageGrid& getCoverageGrid() const { return coverage; }
 private:
     CoverageGrid coverage;
 };
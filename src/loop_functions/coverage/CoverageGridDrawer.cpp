@@ -7,9 +7,29 @@ CoverageGridDrawer::CoverageGridDrawer()
         : coverage(dynamic_cast<CoverageCalculator&>(CSimulator::GetInstance().GetLoopFunctions())) {}
 
 void CoverageGridDrawer::DrawInWorld() {
-    auto grid = coverage.getGrid();
-    for(const auto& edge : grid)
-        DrawRay(edge, CColor::BLACK);
+    /* The grid is created once in Init */
+    if (overlay.isEmpty())
+        addGridLines(coverage.getCoverageGrid());
+    overlay.draw();
+}
+
+/* Neighbouring cells share edges, so the grid is drawn as full rows and columns */
+void CoverageGridDrawer::addGridLines(const CoverageGrid& grid) {
+    if (grid.getWidth() == 0 || grid.getHeight() == 0)
+        return;
+    const auto min = grid.getExtent().GetMin();
+    const auto max = grid.getExtent().GetMax();
+    const auto z = min.GetZ();
+    for (unsigned i = 0; i < grid.getWidth(); i++) {
+        const auto x = min.GetX() + i * grid.getCellSize();
+        overlay.addLine(CVector3(x, min.GetY(), z), CVector3(x, max.GetY(), z), CColor::BLACK);
+    }
+    overlay.addLine(CVector3(max.GetX(), min.GetY(), z), CVector3(max.GetX(), max.GetY(), z), CColor::BLACK);
+    for (unsigned i = 0; i < grid.getHeight(); i++) {
+        const auto y = min.GetY() + i * grid.getCellSize();
+        overlay.addLine(CVector3(min.GetX(), y, z), CVector3(max.GetX(), y, z), CColor::BLACK);
+    }
+    overlay.addLine(CVector3(min.GetX(), max.GetY(), z), CVector3(max.GetX(), max.GetY(), z), CColor::BLACK);
 }
 
 REGISTER_QTOPENGL_USER_FUNCTIONS(CoverageGridDrawer, "draw_coverage")
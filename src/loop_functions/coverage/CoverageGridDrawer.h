@@ -1,6 +1,7 @@
 #pragma once
 
 #include <argos3/plugins/simulator/visualizations/qt-opengl/qtopengl_user_functions.h>
+#include <loop_functions/visualization/LineOverlay.h>
 #include "CoverageCalculator.h"
 
 class CoverageGridDrawer : public argos::CQTOpenGLUserFunctions {
@@ -10,6 +11,9 @@ public:
     void DrawInWorld() override;
 private:
     CoverageCalculator& coverage;
+    LineOverlay overlay;
+
+    void addGridLines(const CoverageGrid& grid);
 };
 
 
@@ -5,6 +5,8 @@ using namespace argos;
 
 MbfoDrawer::MbfoDrawer()
     : mbfo(dynamic_cast<MbfoLoopFunction&>(CSimulator::GetInstance().GetLoopFunctions()))
+    , voronoiOverlay(edgeWidth, vertexSize)
+    , coverageTexture(gridColor)
 {}
 
 void MbfoDrawer::DrawInWorld() {
@@ -13,14 +15,18 @@ void MbfoDrawer::DrawInWorld() {
 }
 
 void MbfoDrawer::drawVoronoi() {
-    auto voronoiCells = mbfo.getVoronoiCells();
-    for (auto& cell : voronoiCells) {
-//        drawCellId(cell);
-        for (auto& edge : cell.getEdges()) {
-            drawEdge(edge);
-            drawVertex(edge);
-        }
+    if (mbfo.getVoronoiGeneration() != voronoiGeneration) {
+        voronoiOverlay.clear();
+        for (auto& cell : mbfo.getVoronoiCells())
+            for (auto& edge : cell.getEdges()) {
+                voronoiOverlay.addRay(edge, CColor::RED);
+                voronoiOverlay.addPoint(edge.GetStart(), voronoiVertexColor);
+            }
+        voronoiGeneration = mbfo.getVoronoiGeneration();
     }
+    voronoiOverlay.draw();
+//    for (auto& cell : mbfo.getVoronoiCells())
+//        drawCellId(cell);
 }
 
 void MbfoDrawer::drawCellId(const VoronoiDiagram::Cell& cell) {
@@ -30,51 +36,30 @@ void MbfoDrawer::drawCellId(const VoronoiDiagram::Cell& cell) {
     DrawText(textPosition, cell.seed.id, CColor::WHITE);
 }
 
-void MbfoDrawer::drawEdge(const CRay3& edge) { DrawRay(edge, CColor::RED, 3.0f); }
-
-void MbfoDrawer::drawVertex(const CRay3& edge) {
-    auto &vertex = edge.GetStart();
-    DrawPoint(vertex, voronoiVertexColor, vertexSize);
-}
-
 void MbfoDrawer::drawGrid() {
-    auto grid = mbfo.getCoverageGrid();
-    for (int i = 0; i < grid.getGrid().size(); i++)
-        for (int j = 0; j < grid.getGrid().size(); j++) {
-            bool found = false;
-            for (auto& voronoiCell : mbfo.getVoronoiCells()) {
-                auto it = find_if(voronoiCell.coverageCells.begin(), voronoiCell.coverageCells.end(), [i, j]
-                    (const VoronoiCell::CoverageCell& a) { return a.x == i && a.y == j; });
-                if (it != voronoiCell.coverageCells.end())
-                    found = true;
-            }
-            drawCell(grid.getGrid().at(i).at(j), !found);
-        }
+    /* Camera moves redraw the scene without changing the coverage */
+    const auto clock = CSimulator::GetInstance().GetSpace().GetSimulationClock();
+    if (clock != textureClock) {
+        const auto& grid = mbfo.getCoverageGrid();
+        coverageTexture.updateConcentrations(grid);
+        coverageTexture.updateOwners(getCellsOwners(grid));
+        textureClock = clock;
+    }
+    coverageTexture.draw();
 }
 
-void MbfoDrawer::drawCell(const CoverageGrid::Cell &cell, bool faulty) {
-    std::vector<CVector2> points;
-    const auto& start = cell.edges.front().GetStart();
-    points.emplace_back(start.GetX(), start.GetY());
-    for (auto& edge : cell.edges)
-        points.emplace_back(edge.GetEnd().GetX(), edge.GetEnd().GetY());
-    points.pop_back();
-    auto maxConcentration = mbfo.maxCellConcentration;
-    CColor color;
-    if (!faulty) {
-        auto colorValue
-            = gridFloorDiff * (static_cast<double>(cell.concentration) / maxConcentration);
-        colorValue += gridColor;
-        color = CColor(colorValue, colorValue, colorValue);
+vector<int> MbfoDrawer::getCellsOwners(const CoverageGrid& grid) {
+    const size_t width = grid.getWidth();
+    const size_t height = grid.getHeight();
+    vector<int> owners(width * height, CoverageTexture::noOwner);
+    int owner = 0;
+    for (auto& voronoiCell : mbfo.getVoronoiCells()) {
+        for (auto& cell : voronoiCell.coverageCells)
+            if (cell.x >= 0 && static_cast<size_t>(cell.x) < width && cell.y >= 0 && static_cast<size_t>(cell.y) < height)
+                owners[cell.x * height + cell.y] = owner;
+        owner++;
     }
-    else
-        color = CColor::RED;
-    DrawPolygon(
-            CVector3(0,0,start.GetZ()),
-            CQuaternion(CRadians::ZERO, CVector3(1,0,0)),
-            points,
-            color,
-            true);
+    return owners;
 }
 
 REGISTER_QTOPENGL_USER_FUNCTIONS(MbfoDrawer, "draw_mbfo")
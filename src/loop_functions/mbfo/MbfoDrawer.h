@@ -2,6 +2,8 @@
 
 #include <argos3/plugins/simulator/visualizations/qt-opengl/qtopengl_user_functions.h>
 #include <argos3/plugins/robots/foot-bot/simulator/footbot_entity.h>
+#include <loop_functions/visualization/CoverageTexture.h>
+#include <loop_functions/visualization/LineOverlay.h>
 #include "MbfoLoopFunction.h"
 
 class MbfoDrawer : public argos::CQTOpenGLUserFunctions {
@@ -11,18 +13,21 @@ public:
     void DrawInWorld() override;
 private:
     const argos::UInt8 gridColor = 40;
-    const argos::UInt8 gridFloorDiff = 255 - gridColor;
     const argos::CColor voronoiVertexColor = argos::CColor::RED;
     const argos::Real vertexSize = 5.0f;
+    const argos::Real edgeWidth = 3.0f;
     MbfoLoopFunction& mbfo;
+    LineOverlay voronoiOverlay;
+    /* Voronoi diagram generation the overlay was built for */
+    std::size_t voronoiGeneration = std::numeric_limits<std::size_t>::max();
+    CoverageTexture coverageTexture;
+    /* Simulation step the texture was last updated for */
+    argos::UInt32 textureClock = std::numeric_limits<argos::UInt32>::max();
 
     void drawGrid();
     void drawVoronoi();
 
-    void drawCell(const CoverageGrid::Cell &cell, bool faulty = false);
-
-    void drawVertex(const argos::CRay3& edge);
-    void drawEdge(const argos::CRay3& edge);
+    std::vector<int> getCellsOwners(const CoverageGrid& grid);
 
     void drawCellId(const VoronoiDiagram::Cell& cell);
 };
@@ -9,6 +9,9 @@ using namespace boost::polygon;
 void MbfoLoopFunction::Init(TConfigurationNode& t_tree) {
     parseLogConfig(t_tree);
     parseVoronoiConfig(t_tree);
+    parseHeatmapConfig(t_tree);
+    parseTrajectoryConfig(t_tree);
+    parseProfilingConfig(t_tree);
     targetsNumber = this->GetSpace().GetEntitiesByType("target").size();
     LOG << targetsNumber << " targets to found!" << endl;
     Reset();
@@ -26,9 +29,11 @@ void MbfoLoopFunction::parseVoronoiConfig(TConfigurationNode& t_tree) {
 
 void MbfoLoopFunction::parseLogConfig(TConfigurationNode& t_tree) {
     log.name = "mbfo.log";
+    UInt32 flushInterval = RunLogWriter::defaultFlushInterval;
     try {
         TConfigurationNode& conf = GetNode(t_tree, "log");
         GetNodeAttribute(conf, "path", log.name);
+        GetNodeAttributeOrDefault(conf, "flush_interval", flushInterval, flushInterval);
         LOG << "Log file: " << log.name << endl;
         TConfigurationNodeIterator it("threshold");
         it = it.begin(&conf);
@@ -43,6 +48,36 @@ void MbfoLoopFunction::parseLogConfig(TConfigurationNode& t_tree) {
     catch (CARGoSException& e) {
         LOGERR << "Error parsing log config! " <<  e.what();
     }
+    log.file.open(log.name, {RunLog::EventType::Threshold, RunLog::EventType::Target}, flushInterval);
+}
+
+void MbfoLoopFunction::parseHeatmapConfig(TConfigurationNode& t_tree) {
+    if (!NodeExists(t_tree, "heatmap"))
+        return;
+    TConfigurationNode& conf = GetNode(t_tree, "heatmap");
+    GetNodeAttribute(conf, "path", heatmapConfig.path);
+    GetNodeAttributeOrDefault(conf, "interval", heatmapConfig.frameInterval, heatmapConfig.frameInterval);
+    GetNodeAttributeOrDefault(conf, "keyframe_interval", heatmapConfig.keyframeInterval, heatmapConfig.keyframeInterval);
+    LOG << "Heatmap file: " << heatmapConfig.path << endl;
+}
+
+void MbfoLoopFunction::parseTrajectoryConfig(TConfigurationNode& t_tree) {
+    if (!NodeExists(t_tree, "trajectory"))
+        return;
+    TConfigurationNode& conf = GetNode(t_tree, "trajectory");
+    GetNodeAttribute(conf, "path", trajectory.path);
+    GetNodeAttributeOrDefault(conf, "resolution", trajectory.resolution, trajectory.resolution);
+    LOG << "Trajectory file: " << trajectory.path << endl;
+}
+
+void MbfoLoopFunction::parseProfilingConfig(TConfigurationNode& t_tree) {
+    if (!NodeExists(t_tree, "profiling"))
+        return;
+    TConfigurationNode& conf = GetNode(t_tree, "profiling");
+    GetNodeAttributeOrDefault(conf, "trace", profiling.trace, profiling.trace);
+    GetNodeAttributeOrDefault(conf, "histograms", profiling.histograms, profiling.histograms);
+    if (!Profiler::enabled)
+        LOGERR << "Profiling output requested, but the build has COVERAGE_SEARCH_PROFILING off" << endl;
 }
 
 bool MbfoLoopFunction::IsExperimentFinished() {
@@ -56,15 +91,16 @@ void MbfoLoopFunction::PreStep() {
 }
 
 void MbfoLoopFunction::PostStep() {
-    std::vector<CoverageGrid::CellIndex> affectedCells = getCellsCoveredByRobots();
-    removeDuplicates(affectedCells);
-    try {
-        updateCoverageCells(affectedCells);
-    }
-    catch(std::exception& e) {
-        THROW_ARGOSEXCEPTION_NESTED("Error during concentration update!", e)
+    {
+        PROFILE_PHASE("coverage");
+        updateCoverageCells();
+        checkPercentageCoverage();
     }
-    checkPercentageCoverage();
+    PROFILE_PHASE("log");
+    heatmap.update(GetSpace().GetSimulationClock());
+    if (trajectory.file.isOpen())
+        trajectory.file.writeFrame(GetSpace().GetSimulationClock(), trajectory.poses);
+    log.file.update(GetSpace().GetSimulationClock());
 }
 
 void MbfoLoopFunction::checkPercentageCoverage() {
@@ -72,103 +108,56 @@ void MbfoLoopFunction::checkPercentageCoverage() {
         const auto percentageCoverage = coverage.getCoverageValue();
         if (percentageCoverage >= thresholdsToLog.front()) {
             LOG << "Threshold " << thresholdsToLog.front() << "% achieved!" << endl;
-            log.thresholds[GetSpace().GetSimulationClock()] = percentageCoverage;
+            log.file.writeThreshold(GetSpace().GetSimulationClock(), percentageCoverage);
             thresholdsToLog.pop_front();
         }
     }
 }
 
-std::vector<CoverageGrid::CellIndex> MbfoLoopFunction::getCellsCoveredByRobots() const {
-    std::vector<CoverageGrid::CellIndex> affectedCells;
-    auto delta = coverage.getCellSize() / 2;
-    for (auto ray : rays) {
-        auto rayLength = ray.GetLength();
-        while (rayLength > 0) {
-            try {
-                affectedCells.emplace_back(coverage.getCellIndex(ray.GetEnd()));
-            }
-            catch(std::exception& e) {
-                std::stringstream s;
-                s << "Error during concentration update for ray end (" << ray.GetEnd() << ")";
-                THROW_ARGOSEXCEPTION_NESTED(s.str(), e);
-            }
-            rayLength = ray.GetLength() - delta;
-            ray.SetLength(rayLength);
-        }
-    }
-    return affectedCells;
-}
-
-void MbfoLoopFunction::removeDuplicates(std::vector<CoverageGrid::CellIndex>& cells) const {
-    std::sort(cells.begin(), cells.end());
-    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
-}
-
-void MbfoLoopFunction::updateCoverageCells(const std::vector<CoverageGrid::CellIndex>& affectedCells) {
-    for (auto &cell : affectedCells) {
-        unsigned x = cell.first;
-        unsigned y = cell.second;
-        coverage.getGrid()[x][y].concentration /= 2;
-    }
+void MbfoLoopFunction::updateCoverageCells() {
+    coveredSpans.clear();
+    for (auto& pose : trajectory.poses)
+        stamps.addSpans(coverage, pose, coveredSpans);
+    coverage.visitSpans(coveredSpans);
 }
 
 void MbfoLoopFunction::Reset() {
     voronoi.setArenaLimits(GetSpace().GetArenaLimits());
     coverage.initGrid(GetSpace().GetArenaLimits());
+    if (!heatmapConfig.path.empty())
+        heatmap.open(heatmapConfig, coverage);
     PreStep();
+    initFootprint(GetSpace().GetEntitiesByType("foot-bot"));
+    if (!trajectory.path.empty())
+        openTrajectory(GetSpace().GetEntitiesByType("foot-bot"));
     update();
 }
 
 void MbfoLoopFunction::Destroy() {
-    saveLog();
-}
-
-void MbfoLoopFunction::saveLog() {
-    log.file.open(log.name);
-    log.file << "{\n";
-    log.file << "\"thresholds\" : [\n";
-    for (auto& threshold : log.thresholds)
-        log.file << "\t" "{ "
-        << "\"step\" : " << threshold.first << ", "
-        << "\"coverage\" : "
-        << fixed << setprecision(2) << threshold.second
-        << " },\n";
-    log.file.seekp(-2, ios_base::end);
-    log.file << "\n],\n";
-
-    log.file << "\"targets\" : [\n";
-    for (auto& target : log.targets) {
-        log.file << "\t" "{ "
-        << "\"id\" : " << target.first << ", "
-        << "\"step\" : " << target.second.step << ", "
-        << "\"position\" : [" << target.second.position << "]"
-        << " },\n";
-    }
-    log.file.seekp(-2, ios_base::end);
-    log.file << "\n]\n";
-
-    log.file << "}";
     log.file.close();
+    heatmap.close();
+    trajectory.file.close();
+    Profiler::exportOutputs(profiling);
 }
 
 void MbfoLoopFunction::update() {
-    voronoi.calculate(robotsPositions, coverage.getGrid());
+    PROFILE_PHASE("voronoi");
+    voronoi.calculate(robotsPositions, coverage);
 
     int gridCounter = 0;
     for (auto& voronoiCell : voronoi.getCells()) {
         robotsCells[voronoiCell.seed.id] = &voronoiCell;
         gridCounter += voronoiCell.coverageCells.size();
     }
-    auto gridCellsCount = coverage.getGrid().size();
-    gridCellsCount *= gridCellsCount;
+    auto gridCellsCount = coverage.getWidth() * coverage.getHeight();
     if (voronoiAssertion && gridCounter != gridCellsCount) {
         std::stringstream s;
         s << "There is " << gridCellsCount - gridCounter
             << " cells unassigned to voronoi cells!\n";
-        for (size_t i = 0; i < coverage.getGrid().size(); i++)
-            for (size_t j = 0; j < coverage.getGrid().size(); j++) {
+        for (unsigned i = 0; i < coverage.getWidth(); i++)
+            for (unsigned j = 0; j < coverage.getHeight(); j++) {
                 s << "[" << i << "," << j << "] "
-                    << "(" << coverage.getGrid().at(i).at(j).center << ") ";
+                    << "(" << coverage.getCellCenter({i, j}) << ") ";
                 for (auto& voronoiCell : voronoi.getCells()) {
                     auto it = find_if(voronoiCell.coverageCells.begin(), voronoiCell.coverageCells.end(), [i, j]
                         (const VoronoiCell::CoverageCell& a) { return a.x == i && a.y == j; });
@@ -182,35 +171,76 @@ void MbfoLoopFunction::update() {
 }
 
 void MbfoLoopFunction::addTargetPosition(int id, const CVector3& position) {
+    PROFILE_PHASE("log");
     std::lock_guard<std::mutex> guard(tagetPositionUpdateMutex);
-    if (log.targets.find(id) == log.targets.end()) {
-        log.targets[id] = {GetSpace().GetSimulationClock(), position};
+    if (log.targets.insert(id).second) {
+        log.file.writeTarget(GetSpace().GetSimulationClock(), id, position.GetX(), position.GetY(), position.GetZ());
         LOG << "Target was found!" << endl;
     }
 }
 
 void MbfoLoopFunction::updateRobotsPositions(const CSpace::TMapPerType &entities) {
-    rays.clear();
+    PROFILE_PHASE("positions");
+    trajectory.poses.clear();
     for (const auto& entity : entities) {
-        auto& footbot = *(any_cast<CFootBotEntity*>(entity.second));
+        auto& footbot = *(any_cast<CCustomFootBotEntity*>(entity.second));
         auto position = footbot.GetEmbodiedEntity().GetOriginAnchor().Position;
-        addRobotsRays(footbot);
         robotsPositions[footbot.GetId()] = position;
+        CRadians yaw, pitch, roll;
+        footbot.GetEmbodiedEntity().GetOriginAnchor().Orientation.ToEulerAngles(yaw, pitch, roll);
+        trajectory.poses.push_back({position.GetX(), position.GetY(), yaw.GetValue()});
     }
 }
 
-void MbfoLoopFunction::addRobotsRays(CFootBotEntity& footbot) {
+void MbfoLoopFunction::initFootprint(const CSpace::TMapPerType& entities) {
+    if (entities.empty())
+        return;
+    /* All robots carry the same sensors */
+    footprint = getFootprint(*any_cast<CCustomFootBotEntity*>(entities.begin()->second));
+    stamps.init(footprint, coverage.getCellSize());
+}
+
+std::vector<CVector3> MbfoLoopFunction::getRaysEnds(CCustomFootBotEntity& footbot) const {
+    if (!footbot.HasComponents(CCustomFootBotEntity::COMPONENT_PROXIMITY))
+        THROW_ARGOSEXCEPTION("The coverage rays of " << footbot.GetId() << " need the proximity component");
+    std::vector<CVector3> ends;
     auto& proximityEntity = footbot.GetProximitySensorEquippedEntity();
     for(UInt32 i = 0; i < proximityEntity.GetNumSensors(); ++i) {
-        CVector3 cRayStart, cRayEnd;
-        cRayStart = footbot.GetEmbodiedEntity().GetOriginAnchor().Position;
+        CVector3 cRayEnd;
         cRayEnd = proximityEntity.GetSensor(i).Offset;
         cRayEnd += proximityEntity.GetSensor(i).Direction;
         cRayEnd.Rotate(proximityEntity.GetSensor(i).Anchor.Orientation);
         cRayEnd += proximityEntity.GetSensor(i).Anchor.Position;
-        wrapPointToArenaLimits(cRayEnd);
-        rays.emplace_back(cRayStart, cRayEnd);
+        ends.push_back(cRayEnd);
     }
+    return ends;
+}
+
+std::vector<Trajectory::Point> MbfoLoopFunction::getFootprint(CCustomFootBotEntity& footbot) const {
+    auto& anchor = footbot.GetEmbodiedEntity().GetOriginAnchor();
+    CRadians yaw, pitch, roll;
+    anchor.Orientation.ToEulerAngles(yaw, pitch, roll);
+    std::vector<Trajectory::Point> footprint;
+    for (auto& rayEnd : getRaysEnds(footbot)) {
+        rayEnd -= anchor.Position;
+        rayEnd.RotateZ(-yaw);
+        footprint.push_back({{rayEnd.GetX(), rayEnd.GetY(), rayEnd.GetZ()}});
+    }
+    return footprint;
+}
+
+void MbfoLoopFunction::openTrajectory(const CSpace::TMapPerType& entities) {
+    if (entities.empty())
+        THROW_ARGOSEXCEPTION("No robots to record the trajectory of!");
+    Trajectory::Header header;
+    auto limits = GetSpace().GetArenaLimits();
+    header.positionResolution = trajectory.resolution;
+    header.arenaMin = {{limits.GetMin().GetX(), limits.GetMin().GetY(), limits.GetMin().GetZ()}};
+    header.arenaMax = {{limits.GetMax().GetX(), limits.GetMax().GetY(), limits.GetMax().GetZ()}};
+    header.footprint = footprint;
+    for (const auto& entity : entities)
+        header.robots.push_back(entity.first);
+    trajectory.file.open(trajectory.path, header);
 }
 
 void MbfoLoopFunction::wrapPointToArenaLimits(CVector3 &point) {
@@ -252,6 +282,17 @@ const std::map<std::string, CVector3> MbfoLoopFunction::getRobotsPositions() {
 }
 
 const std::vector<argos::CRay3> MbfoLoopFunction::getRays() {
+    std::vector<CRay3> rays;
+    for (auto& pose : trajectory.poses) {
+        const CVector3 rayStart(pose.x, pose.y, 0);
+        for (auto& point : footprint) {
+            CVector3 rayEnd(point[0], point[1], point[2]);
+            rayEnd.RotateZ(CRadians(pose.yaw));
+            rayEnd += rayStart;
+            wrapPointToArenaLimits(rayEnd);
+            rays.emplace_back(rayStart, rayEnd);
+        }
+    }
     return rays;
 }
 
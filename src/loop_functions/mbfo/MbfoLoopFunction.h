@@ -1,11 +1,17 @@
 #pragma once
 
 #include <argos3/core/simulator/loop_functions.h>
-#include <argos3/plugins/robots/foot-bot/simulator/footbot_entity.h>
+#include <robots/custom-foot-bot/simulator/footbot_entity.h>
 #include <utils/voronoi/VoronoiDiagram.h>
 #include <utils/coverage/CoverageGrid.h>
+#include <utils/coverage/CoverageRecorder.h>
+#include <utils/coverage/FootprintStamps.h>
+#include <utils/log/RunLogWriter.h>
+#include <utils/log/TrajectoryWriter.h>
+#include <utils/profiling/Profiler.h>
 #include <iostream>
 #include <mutex>
+#include <set>
 
 
 class MbfoLoopFunction : public argos::CLoopFunctions {
@@ -25,47 +31,58 @@ public:
     void addTargetPosition(int id, const argos::CVector3& position);
     const CoverageGrid& getCoverageGrid();
     const std::vector<VoronoiDiagram::Cell>& getVoronoiCells();
+    std::size_t getVoronoiGeneration() const { return voronoi.getGeneration(); }
     const VoronoiDiagram::Cell* getVoronoiCell(std::string id);
     const std::vector<const VoronoiDiagram::Cell*> getNeighbouringVoronoiCells(std::string id);
     const std::map<std::string, argos::CVector3> getRobotsPositions();
     const std::vector<argos::CRay3> getRays();
 
 private:
-    struct Target {
-        using Id = int;
-        argos::UInt32 step;
-        argos::CVector3 position;
+    struct TrajectoryLog {
+        std::string path;
+        double resolution = TrajectoryWriter::defaultPositionResolution;
+        TrajectoryWriter file;
+        std::vector<Trajectory::Pose> poses;
     };
+
     struct MbfoLog {
         std::string name;
-        std::ofstream file;
-        std::map<Target::Id, Target> targets;
-        std::map<argos::UInt32, double> thresholds;
+        RunLogWriter file;
+        std::set<int> targets;
     };
 
     std::mutex tagetPositionUpdateMutex;
 
     MbfoLog log;
+    TrajectoryLog trajectory;
+    Profiler::Outputs profiling;
     std::list<double> thresholdsToLog;
     unsigned targetsNumber;
     CoverageGrid coverage;
+    CoverageRecorder::Config heatmapConfig;
+    CoverageRecorder heatmap;
     VoronoiDiagram voronoi;
     bool voronoiAssertion = false;
     std::map<std::string, argos::CVector3> robotsPositions;
     std::map<std::string, const VoronoiDiagram::Cell*> robotsCells;
-    std::vector<argos::CRay3> rays;
+    /* Ray ends in the robot frame, the same for all robots */
+    std::vector<Trajectory::Point> footprint;
+    FootprintStamps stamps;
+    std::vector<CoverageGrid::Span> coveredSpans;
 
     void updateRobotsPositions(const argos::CSpace::TMapPerType& entities);
-    void addRobotsRays(argos::CFootBotEntity& footbot);
+    std::vector<argos::CVector3> getRaysEnds(argos::CCustomFootBotEntity& footbot) const;
+    std::vector<Trajectory::Point> getFootprint(argos::CCustomFootBotEntity& footbot) const;
+    void openTrajectory(const argos::CSpace::TMapPerType& entities);
     void wrapPointToArenaLimits(argos::CVector3 &point);
-    std::vector<CoverageGrid::CellIndex> getCellsCoveredByRobots() const;
-    void removeDuplicates(std::vector<CoverageGrid::CellIndex>& cells) const;
-    void updateCoverageCells(const std::vector<CoverageGrid::CellIndex>& affectedCells);
+    void initFootprint(const argos::CSpace::TMapPerType& entities);
+    void updateCoverageCells();
 
     void parseLogConfig(argos::TConfigurationNode& t_tree);
+    void parseHeatmapConfig(argos::TConfigurationNode& t_tree);
+    void parseTrajectoryConfig(argos::TConfigurationNode& t_tree);
     void parseVoronoiConfig(argos::TConfigurationNode& t_tree);
+    void parseProfilingConfig(argos::TConfigurationNode& t_tree);
 
     void checkPercentageCoverage();
-
-    void saveLog() ;
 };
@@ -11,6 +11,7 @@ using namespace argos;
 void ClosestDistance::Init(TConfigurationNode& t_tree) {
     parseLogConfig(t_tree);
     parseTargetConfig(t_tree);
+    parseProfilingConfig(t_tree);
     try {
         targetsNumber = this->GetSpace().GetEntitiesByType("target").size();
     } catch(CARGoSException& e) {
@@ -26,14 +27,17 @@ bool ClosestDistance::IsExperimentFinished() {
 
 void ClosestDistance::parseLogConfig(TConfigurationNode& t_tree) {
     log.name = "pso.log";
+    UInt32 flushInterval = RunLogWriter::defaultFlushInterval;
     try {
         TConfigurationNode& conf = GetNode(t_tree, "log");
         GetNodeAttribute(conf, "path", log.name);
+        GetNodeAttributeOrDefault(conf, "flush_interval", flushInterval, flushInterval);
         LOG << "Log file: " << log.name << endl;
     }
     catch (CARGoSException& e) {
         LOGERR << "Error parsing log config! " <<  e.what() << endl;
     }
+    log.file.open(log.name, {RunLog::EventType::ClosestDistance, RunLog::EventType::Target}, flushInterval);
 }
 
 void ClosestDistance::parseTargetConfig(TConfigurationNode& t_tree) {
@@ -49,8 +53,24 @@ void ClosestDistance::parseTargetConfig(TConfigurationNode& t_tree) {
     }
 }
 
+void ClosestDistance::parseProfilingConfig(TConfigurationNode& t_tree) {
+    if (!NodeExists(t_tree, "profiling"))
+        return;
+    TConfigurationNode& conf = GetNode(t_tree, "profiling");
+    GetNodeAttributeOrDefault(conf, "trace", profiling.trace, profiling.trace);
+    GetNodeAttributeOrDefault(conf, "histograms", profiling.histograms, profiling.histograms);
+    if (!Profiler::enabled)
+        LOGERR << "Profiling output requested, but the build has COVERAGE_SEARCH_PROFILING off" << endl;
+}
+
+void ClosestDistance::PostStep() {
+    PROFILE_PHASE("log");
+    log.file.update(GetSpace().GetSimulationClock());
+}
+
 void ClosestDistance::Destroy() {
-    saveLog();
+    log.file.close();
+    Profiler::exportOutputs(profiling);
 }
 
 void ClosestDistance::addRobotPosition(CVector3 pos) {
@@ -60,48 +80,20 @@ void ClosestDistance::addRobotPosition(CVector3 pos) {
 
     std::lock_guard<std::mutex> guard(robotDistanceUpdateMutex);
     if (distance < bestObtainedDistance) {
+        PROFILE_PHASE("log");
         bestObtainedDistance = distance;
-        log.closestDistances[GetSpace().GetSimulationClock()] = bestObtainedDistance;
+        log.file.writeClosestDistance(GetSpace().GetSimulationClock(), bestObtainedDistance);
     }
 }
 
 void ClosestDistance::addTargetPosition(int id, const CVector3& position) {
+    PROFILE_PHASE("log");
     std::lock_guard<std::mutex> guard(tagetPositionUpdateMutex);
-    if (log.targets.find(id) == log.targets.end()) {
-        log.targets[id] = { GetSpace().GetSimulationClock(), position };
+    if (log.targets.insert(id).second) {
+        log.file.writeTarget(GetSpace().GetSimulationClock(), id, position.GetX(), position.GetY(), position.GetZ());
         LOG << "Target was found!" << endl;
     }
 }
 
-void ClosestDistance::saveLog() {
-    log.file.open(log.name);
-    log.file << "{\n";
-
-    log.file << "\"closest\" : [\n";
-    for (auto& distance : log.closestDistances)
-        log.file << "\t" "{ "
-        << "\"step\" : " << distance.first << ", "
-        << "\"distance\" : " << distance.second
-        << " },\n";
-    if (log.closestDistances.size() != 0)
-        log.file.seekp(-2, ios_base::end);
-    log.file << "\n],\n";
-
-    log.file << "\"targets\" : [\n";
-    for (auto& target : log.targets) {
-        log.file << "\t" "{ "
-        << "\"id\" : " << target.first << ", "
-        << "\"step\" : " << target.second.step << ", "
-        << "\"position\" : [" << target.second.position << "]"
-        << " },\n";
-    }
-    if (log.targets.size() != 0)
-        log.file.seekp(-2, ios_base::end);
-    log.file << "\n]\n";
-
-    log.file << "}";
-    log.file.close();
-}
-
 REGISTER_LOOP_FUNCTIONS(ClosestDistance, "closest_distance")
 
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <argos3/core/simulator/loop_functions.h>
+#include <utils/log/RunLogWriter.h>
+#include <utils/profiling/Profiler.h>
 #include <iostream>
 #include <mutex>
+#include <set>
 
 
 class ClosestDistance : public argos::CLoopFunctions {
@@ -12,23 +15,17 @@ public:
 
     virtual void Init(argos::TConfigurationNode& t_tree);
     virtual bool IsExperimentFinished();
+    virtual void PostStep();
     virtual void Destroy();
 
     void addRobotPosition(argos::CVector3 pos);
     void addTargetPosition(int id, const argos::CVector3& position);
 
 private:
-    struct Target {
-        using Id = int;
-        argos::UInt32 step;
-        argos::CVector3 position;
-    };
-
     struct PsoLog {
         std::string name;
-        std::ofstream file;
-        std::map<Target::Id, Target> targets;
-        std::map<argos::UInt32, double> closestDistances;
+        RunLogWriter file;
+        std::set<int> targets;
     };
 
     std::mutex robotDistanceUpdateMutex;
@@ -38,10 +35,10 @@ private:
     unsigned targetsNumber;
     argos::CVector2 position;
     PsoLog log;
+    Profiler::Outputs profiling;
 
     void parseTargetConfig(argos::TConfigurationNode& t_tree);
     void parseLogConfig(argos::TConfigurationNode& t_tree);
-
-    void saveLog();
+    void parseProfilingConfig(argos::TConfigurationNode& t_tree);
 };
 
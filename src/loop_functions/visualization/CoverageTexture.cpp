@@ -0,0 +1,168 @@
+#include "CoverageTexture.h"
+#include <algorithm>
+
+#ifdef __APPLE__
+#include <gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+using namespace std;
+using namespace argos;
+
+namespace {
+
+const array<CColor, 8> ownersPalette = {
+    CColor::BLUE, CColor::GREEN, CColor::YELLOW, CColor::MAGENTA,
+    CColor::CYAN, CColor::ORANGE, CColor::PURPLE, CColor::BROWN
+};
+
+/* Raised above the floor texture to avoid z-fighting */
+const Real ownersLiftOnZ = 0.001f;
+
+}
+
+CoverageTexture::CoverageTexture(UInt8 gridColor, CColor unownedColor)
+    : gridColor(gridColor)
+    , gridFloorDiff(255 - gridColor)
+    , unownedColor(unownedColor)
+{}
+
+CoverageTexture::~CoverageTexture() {
+    if (levels.texture != 0)
+        glDeleteTextures(1, &levels.texture);
+    if (owners.texture != 0)
+        glDeleteTextures(1, &owners.texture);
+}
+
+void CoverageTexture::DirtyRegion::add(size_t x, size_t y) {
+    if (empty) {
+        minX = maxX = x;
+        minY = maxY = y;
+        empty = false;
+        return;
+    }
+    minX = std::min(minX, x);
+    maxX = std::max(maxX, x);
+    minY = std::min(minY, y);
+    maxY = std::max(maxY, y);
+}
+
+void CoverageTexture::resize(const CoverageGrid& grid) {
+    min = grid.getExtent().GetMin();
+    max = grid.getExtent().GetMax();
+    if (width == grid.getWidth() && height == grid.getHeight())
+        return;
+    width = grid.getWidth();
+    height = grid.getHeight();
+    levels.texels.assign(width * height, 0);
+    levels.allocated = false;
+    owners.texels.assign(width * height, Texel{0, 0, 0, 0});
+    owners.allocated = false;
+}
+
+void CoverageTexture::updateConcentrations(const CoverageGrid& grid) {
+    if (grid.getWidth() == 0 || grid.getHeight() == 0)
+        return;
+    resize(grid);
+    const double scale = static_cast<double>(gridFloorDiff) / grid.maxCellConcentration;
+    array<uint8_t, CoverageGrid::maxVisits + 1> visitsLevels;
+    for (unsigned i = 0; i < visitsLevels.size(); i++)
+        visitsLevels[i] = static_cast<uint8_t>(gridColor + scale * grid.getConcentrationLevel(i));
+    for (unsigned x = 0; x < width; x++) {
+        for (unsigned y = 0; y < height; y++) {
+            const auto level = visitsLevels[grid.getVisits({x, y})];
+            auto& texel = levels.texels[y * width + x];
+            if (texel != level) {
+                texel = level;
+                levels.dirty.add(x, y);
+            }
+        }
+    }
+}
+
+CoverageTexture::Texel CoverageTexture::getOwnerColor(int owner) const {
+    if (owner == noOwner)
+        return {unownedColor.GetRed(), unownedColor.GetGreen(), unownedColor.GetBlue(), unownedColor.GetAlpha()};
+    const auto& color = ownersPalette[owner % ownersPalette.size()];
+    return {color.GetRed(), color.GetGreen(), color.GetBlue(), ownerAlpha};
+}
+
+void CoverageTexture::updateOwners(const vector<int>& labels) {
+    if (labels.size() != width * height)
+        return;
+    for (size_t x = 0; x < width; x++)
+        for (size_t y = 0; y < height; y++) {
+            const auto color = getOwnerColor(labels[x * height + y]);
+            auto& texel = owners.texels[y * width + x];
+            if (texel != color) {
+                texel = color;
+                owners.dirty.add(x, y);
+            }
+        }
+}
+
+template<typename T>
+void CoverageTexture::upload(Layer<T>& layer, unsigned format) {
+    if (layer.texture == 0) {
+        glGenTextures(1, &layer.texture);
+        glBindTexture(GL_TEXTURE_2D, layer.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    else
+        glBindTexture(GL_TEXTURE_2D, layer.texture);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (!layer.allocated) {
+        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, layer.texels.data());
+        layer.allocated = true;
+    }
+    else if (!layer.dirty.empty) {
+        const auto& dirty = layer.dirty;
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, dirty.minX, dirty.minY,
+                        dirty.maxX - dirty.minX + 1, dirty.maxY - dirty.minY + 1, format, GL_UNSIGNED_BYTE,
+                        &layer.texels[dirty.minY * width + dirty.minX]);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    layer.dirty.empty = true;
+}
+
+void CoverageTexture::drawQuad(unsigned texture, Real z) const {
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glBegin(GL_QUADS);
+    glTexCoord2f(0, 0);
+    glVertex3d(min.GetX(), min.GetY(), z);
+    glTexCoord2f(1, 0);
+    glVertex3d(max.GetX(), min.GetY(), z);
+    glTexCoord2f(1, 1);
+    glVertex3d(max.GetX(), max.GetY(), z);
+    glTexCoord2f(0, 1);
+    glVertex3d(min.GetX(), max.GetY(), z);
+    glEnd();
+}
+
+void CoverageTexture::draw(bool showOwners) {
+    if (width == 0 || height == 0)
+        return;
+    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT | GL_COLOR_BUFFER_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_TEXTURE_2D);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    glColor4ub(255, 255, 255, 255);
+
+    upload(levels, GL_LUMINANCE);
+    drawQuad(levels.texture, min.GetZ());
+    if (showOwners) {
+        upload(owners, GL_RGBA);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        drawQuad(owners.texture, min.GetZ() + ownersLiftOnZ);
+    }
+    glPopAttrib();
+}
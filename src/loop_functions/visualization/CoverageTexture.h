@@ -0,0 +1,65 @@
+#pragma once
+
+#include <utils/coverage/CoverageGrid.h>
+#include <argos3/core/utility/datatypes/color.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Draws a coverage grid as one textured quad over the arena floor instead of
+ * a polygon per cell. Concentrations are grey levels, the optional ownership
+ * overlay tints every cell with the color of its owner. Only the bounding box
+ * of texels changed since the last draw is uploaded.
+ *
+ * Owners are labels indexed x * height + y, like the recorder numbers cells.
+ * All calls have to come from a drawer, with the OpenGL context current.
+ */
+class CoverageTexture {
+public:
+    static constexpr int noOwner = -1;
+
+    CoverageTexture(argos::UInt8 gridColor = 40, argos::CColor unownedColor = argos::CColor::RED);
+    ~CoverageTexture();
+    CoverageTexture(const CoverageTexture&) = delete;
+    CoverageTexture& operator=(const CoverageTexture&) = delete;
+
+    void updateConcentrations(const CoverageGrid& grid);
+    void updateOwners(const std::vector<int>& owners);
+    void draw(bool showOwners = true);
+
+private:
+    using Texel = std::array<std::uint8_t, 4>;
+
+    struct DirtyRegion {
+        std::size_t minX, minY, maxX, maxY;
+        bool empty = true;
+
+        void add(std::size_t x, std::size_t y);
+    };
+
+    template<typename T>
+    struct Layer {
+        unsigned texture = 0;
+        bool allocated = false;
+        std::vector<T> texels;
+        DirtyRegion dirty;
+    };
+
+    static constexpr std::uint8_t ownerAlpha = 80;
+    const argos::UInt8 gridColor;
+    const argos::UInt8 gridFloorDiff;
+    const argos::CColor unownedColor;
+    std::size_t width = 0;
+    std::size_t height = 0;
+    argos::CVector3 min;
+    argos::CVector3 max;
+    Layer<std::uint8_t> levels;
+    Layer<Texel> owners;
+
+    void resize(const CoverageGrid& grid);
+    Texel getOwnerColor(int owner) const;
+    template<typename T>
+    void upload(Layer<T>& layer, unsigned format);
+    void drawQuad(unsigned texture, argos::Real z) const;
+};
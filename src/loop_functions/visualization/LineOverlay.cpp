@@ -0,0 +1,66 @@
+#include "LineOverlay.h"
+
+#ifdef __APPLE__
+#include <gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+using namespace argos;
+
+LineOverlay::LineOverlay(Real lineWidth, Real pointSize)
+    : lineWidth(lineWidth)
+    , pointSize(pointSize)
+{}
+
+void LineOverlay::Batch::add(const CVector3& vertex, const CColor& color) {
+    vertices.insert(vertices.end(), {static_cast<float>(vertex.GetX()),
+                                     static_cast<float>(vertex.GetY()),
+                                     static_cast<float>(vertex.GetZ())});
+    colors.insert(colors.end(), {color.GetRed(), color.GetGreen(), color.GetBlue(), color.GetAlpha()});
+}
+
+void LineOverlay::Batch::clear() {
+    vertices.clear();
+    colors.clear();
+}
+
+void LineOverlay::clear() {
+    lines.clear();
+    points.clear();
+}
+
+void LineOverlay::addLine(const CVector3& start, const CVector3& end, const CColor& color) {
+    lines.add(start, color);
+    lines.add(end, color);
+}
+
+void LineOverlay::addPoint(const CVector3& point, const CColor& color) {
+    points.add(point, color);
+}
+
+void LineOverlay::draw() const {
+    if (isEmpty())
+        return;
+    glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_POINT_BIT);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glDisable(GL_LIGHTING);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    if (!lines.vertices.empty()) {
+        glLineWidth(lineWidth);
+        glVertexPointer(3, GL_FLOAT, 0, lines.vertices.data());
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, lines.colors.data());
+        glDrawArrays(GL_LINES, 0, lines.vertices.size() / 3);
+    }
+    if (!points.vertices.empty()) {
+        glPointSize(pointSize);
+        glVertexPointer(3, GL_FLOAT, 0, points.vertices.data());
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, points.colors.data());
+        glDrawArrays(GL_POINTS, 0, points.vertices.size() / 3);
+    }
+
+    glPopClientAttrib();
+    glPopAttrib();
+}
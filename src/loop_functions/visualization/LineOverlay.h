@@ -0,0 +1,43 @@
+#pragma once
+
+#include <argos3/core/utility/datatypes/color.h>
+#include <argos3/core/utility/math/ray3.h>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Batches line segments and points for the qt-opengl user functions. The
+ * overlay is filled once per change of what it shows, e.g. once per Voronoi
+ * diagram, and drawn with one glDrawArrays call for all lines and one for
+ * all points, instead of a DrawRay or DrawPoint call per item.
+ *
+ * draw has to be called from a drawer, with the OpenGL context current.
+ */
+class LineOverlay {
+public:
+    LineOverlay(argos::Real lineWidth = 1.0f, argos::Real pointSize = 5.0f);
+
+    void clear();
+    void addLine(const argos::CVector3& start, const argos::CVector3& end, const argos::CColor& color);
+    void addRay(const argos::CRay3& ray, const argos::CColor& color) {
+        addLine(ray.GetStart(), ray.GetEnd(), color);
+    }
+    void addPoint(const argos::CVector3& point, const argos::CColor& color);
+    bool isEmpty() const { return lines.vertices.empty() && points.vertices.empty(); }
+
+    void draw() const;
+
+private:
+    struct Batch {
+        std::vector<float> vertices;
+        std::vector<std::uint8_t> colors;
+
+        void add(const argos::CVector3& vertex, const argos::CColor& color);
+        void clear();
+    };
+
+    const argos::Real lineWidth;
+    const argos::Real pointSize;
+    Batch lines;
+    Batch points;
+};
@@ -18,7 +18,7 @@ void VoronoiCalculator::update() {
 void VoronoiCalculator::updateRobotsPositions(const CSpace::TMapPerType &entities) {
     robotsPositions.clear();
     for (const auto& entity : entities) {
-        auto& footbot = *(any_cast<CFootBotEntity*>(entity.second));
+        auto& footbot = *(any_cast<CCustomFootBotEntity*>(entity.second));
         auto position = footbot.GetEmbodiedEntity().GetOriginAnchor().Position;
         robotsPositions[footbot.GetId()] = position;
     }
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <argos3/core/simulator/loop_functions.h>
-#include <argos3/plugins/robots/foot-bot/simulator/footbot_entity.h>
+#include <robots/custom-foot-bot/simulator/footbot_entity.h>
 #include <utils/voronoi/VoronoiDiagram.h>
 
 
@@ -14,6 +14,7 @@ public:
     void update();
     std::vector<argos::CVector3> getVertices();
     std::vector<argos::CRay3> getEdges();
+    std::size_t getGeneration() const { return voronoi.getGeneration(); }
 
 private:
     VoronoiDiagram voronoi;
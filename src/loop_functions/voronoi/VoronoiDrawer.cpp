@@ -4,26 +4,37 @@
 using namespace argos;
 
 VoronoiDrawer::VoronoiDrawer()
-    : voronoi(dynamic_cast<VoronoiCalculator&>(CSimulator::GetInstance().GetLoopFunctions())) {}
+    : voronoi(dynamic_cast<VoronoiCalculator&>(CSimulator::GetInstance().GetLoopFunctions()))
+    , overlay(1.0f, vertexSize) {}
 
 void VoronoiDrawer::DrawInWorld() {
-    voronoi.update();
-    drawVertices();
-    drawEdges();
+    /* Robots move only between steps, camera moves need no new diagram */
+    const auto clock = CSimulator::GetInstance().GetSpace().GetSimulationClock();
+    if (clock != voronoiClock) {
+        voronoi.update();
+        voronoiClock = clock;
+    }
+    if (voronoi.getGeneration() != overlayGeneration) {
+        overlay.clear();
+        addVertices();
+        addEdges();
+        overlayGeneration = voronoi.getGeneration();
+    }
+    overlay.draw();
 }
 
-void VoronoiDrawer::drawEdges() {
+void VoronoiDrawer::addEdges() {
     auto voronoiEdges = voronoi.getEdges();
     LOG << "Draw " << voronoiEdges.size() << " edges" "\n";
     for (auto& edge : voronoiEdges)
-        DrawRay(edge);
+        overlay.addRay(edge, edgeColor);
 }
 
-void VoronoiDrawer::drawVertices() {
+void VoronoiDrawer::addVertices() {
     auto voronoiVertices = voronoi.getVertices();
     LOG << "Draw " << voronoiVertices.size() << " vertices" "\n";
     for (auto& vertex : voronoiVertices)
-        DrawPoint(vertex, vertexColor, vertexSize);
+        overlay.addPoint(vertex, vertexColor);
 }
 
 REGISTER_QTOPENGL_USER_FUNCTIONS(VoronoiDrawer, "draw_voronoi")
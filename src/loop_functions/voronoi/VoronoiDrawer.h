@@ -2,6 +2,7 @@
 
 #include <argos3/plugins/simulator/visualizations/qt-opengl/qtopengl_user_functions.h>
 #include <argos3/plugins/robots/foot-bot/simulator/footbot_entity.h>
+#include <loop_functions/visualization/LineOverlay.h>
 #include "VoronoiCalculator.h"
 
 class VoronoiDrawer : public argos::CQTOpenGLUserFunctions {
@@ -11,11 +12,17 @@ public:
     void DrawInWorld() override;
 private:
     const argos::CColor vertexColor = argos::CColor::BLACK;
+    const argos::CColor edgeColor = argos::CColor::RED;
     const argos::Real vertexSize = 5.0f;
     VoronoiCalculator& voronoi;
+    LineOverlay overlay;
+    /* Simulation step the diagram was last calculated for */
+    argos::UInt32 voronoiClock = std::numeric_limits<argos::UInt32>::max();
+    /* Voronoi diagram generation the overlay was built for */
+    std::size_t overlayGeneration = std::numeric_limits<std::size_t>::max();
 
-    void drawVertices();
-    void drawEdges();
+    void addVertices();
+    void addEdges();
 };
 
 
@@ -0,0 +1,409 @@
+/**
+ * @file kinematics2d_engine.cpp
+ */
+
+#include "kinematics2d_engine.h"
+#include <argos3/core/simulator/simulator.h>
+#include <argos3/core/simulator/space/space.h>
+#include <algorithm>
+#include <cmath>
+
+namespace argos {
+
+   /****************************************/
+   /****************************************/
+
+   CKinematics2DEngine::CKinematics2DEngine() :
+      m_fCellSize(0.0),
+      m_unCollisionPasses(2),
+      m_bGridReady(false),
+      m_bObstaclesChanged(true),
+      m_fMaxMovableRadius(0.0),
+      m_fInverseCellSize(1.0),
+      m_unGridWidth(1),
+      m_unGridHeight(1) {
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DEngine::Init(TConfigurationNode& t_tree) {
+      try {
+         /* Init parent */
+         CPhysicsEngine::Init(t_tree);
+         /* Zero means twice the largest robot radius, the smallest size the neighbour search allows */
+         GetNodeAttributeOrDefault(t_tree, "cell_size", m_fCellSize, m_fCellSize);
+         if(m_fCellSize < 0.0) {
+            THROW_ARGOSEXCEPTION("The cell size of the kinematics2d engine must not be negative, got " << m_fCellSize);
+         }
+         GetNodeAttributeOrDefault(t_tree, "collision_passes", m_unCollisionPasses, m_unCollisionPasses);
+      }
+      catch(CARGoSException& ex) {
+         THROW_ARGOSEXCEPTION_NESTED("Error initializing the kinematics2d engine \"" << GetId() << "\"", ex);
+      }
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DEngine::Reset() {
+      for(CKinematics2DModel::TMap::iterator it = m_tPhysicsModels.begin();
+          it != m_tPhysicsModels.end(); ++it) {
+         it->second->Reset();
+      }
+      m_bGridReady = false;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DEngine::Destroy() {
+      for(CKinematics2DModel::TMap::iterator it = m_tPhysicsModels.begin();
+          it != m_tPhysicsModels.end(); ++it) {
+         delete it->second;
+      }
+      m_tPhysicsModels.clear();
+      m_vecMovables.clear();
+      m_vecObstacles.clear();
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DEngine::Update() {
+      /* Move the robots as their wheels say */
+      Real fDt = GetSimulationClockTick();
+      for(size_t i = 0; i < m_vecMovables.size(); ++i) {
+         m_vecMovables[i]->UpdateFromEntityStatus();
+         m_vecMovables[i]->Step(fDt);
+      }
+      /* Push overlapping shapes apart */
+      if(!m_bGridReady) {
+         SetupGrid();
+      }
+      for(UInt32 i = 0; i < m_unCollisionPasses; ++i) {
+         BuildMovableGrid();
+         ResolveCollisions();
+      }
+      /* Leave the grid up to date for the ray queries of the sensors */
+      BuildMovableGrid();
+      m_bGridReady = true;
+      /* Update the simulated space */
+      for(size_t i = 0; i < m_vecMovables.size(); ++i) {
+         m_vecMovables[i]->UpdateEntityStatus();
+      }
+   }
+
+   /****************************************/
+   /****************************************/
+
+   size_t CKinematics2DEngine::GetNumPhysicsModels() {
+      return m_tPhysicsModels.size();
+   }
+
+   /****************************************/
+   /****************************************/
+
+   bool CKinematics2DEngine::AddEntity(CEntity& c_entity) {
+      SOperationOutcome cOutcome =
+         CallEntityOperation<CKinematics2DOperationAddEntity, CKinematics2DEngine, SOperationOutcome>
+         (*this, c_entity);
+      return cOutcome.Value;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   bool CKinematics2DEngine::RemoveEntity(CEntity& c_entity) {
+      SOperationOutcome cOutcome =
+         CallEntityOperation<CKinematics2DOperationRemoveEntity, CKinematics2DEngine, SOperationOutcome>
+         (*this, c_entity);
+      return cOutcome.Value;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   bool CKinematics2DEngine::IsPointContained(const CVector3& c_point) {
+      return true;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   bool CKinematics2DEngine::IsEntityTransferNeeded() const {
+      return false;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DEngine::TransferEntities() {
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DEngine::CheckIntersectionWithRay(TEmbodiedEntityIntersectionData& t_data,
+                                                      const CRay3& c_ray) const {
+      Real fT;
+      if(!m_bGridReady) {
+         /* Models moved since the last step, check them all */
+         for(CKinematics2DModel::TMap::const_iterator it = m_tPhysicsModels.begin();
+             it != m_tPhysicsModels.end(); ++it) {
+            if(it->second->IntersectsRay(fT, c_ray)) {
+               t_data.push_back(SEmbodiedEntityIntersectionItem(&it->second->GetEmbodiedEntity(), fT));
+            }
+         }
+         return;
+      }
+      /* Cells the ray can touch a shape in */
+      const CVector3& cStart = c_ray.GetStart();
+      const CVector3& cEnd = c_ray.GetEnd();
+      UInt32 unMinX = GetCellX(Min(cStart.GetX(), cEnd.GetX()) - m_fMaxMovableRadius);
+      UInt32 unMaxX = GetCellX(Max(cStart.GetX(), cEnd.GetX()) + m_fMaxMovableRadius);
+      UInt32 unMinY = GetCellY(Min(cStart.GetY(), cEnd.GetY()) - m_fMaxMovableRadius);
+      UInt32 unMaxY = GetCellY(Max(cStart.GetY(), cEnd.GetY()) + m_fMaxMovableRadius);
+      size_t unObstacleHits = t_data.size();
+      for(UInt32 unX = unMinX; unX <= unMaxX; ++unX) {
+         for(UInt32 unY = unMinY; unY <= unMaxY; ++unY) {
+            UInt32 unCell = unX * m_unGridHeight + unY;
+            for(UInt32 i = m_vecMovableCellStart[unCell]; i < m_vecMovableCellStart[unCell + 1]; ++i) {
+               const CKinematics2DModel& cModel = *m_vecMovables[m_vecMovablesByCell[i]];
+               if(cModel.IntersectsRay(fT, c_ray)) {
+                  t_data.push_back(SEmbodiedEntityIntersectionItem(&cModel.GetEmbodiedEntity(), fT));
+               }
+            }
+            for(UInt32 i = m_vecObstacleCellStart[unCell]; i < m_vecObstacleCellStart[unCell + 1]; ++i) {
+               const CKinematics2DModel& cModel = *m_vecObstacles[m_vecObstaclesByCell[i]];
+               if(!cModel.IntersectsRay(fT, c_ray)) continue;
+               /* Obstacles span several cells, report them once */
+               bool bReported = false;
+               for(size_t j = unObstacleHits; j < t_data.size() && !bReported; ++j) {
+                  bReported = (t_data[j].IntersectedEntity == &cModel.GetEmbodiedEntity());
+               }
+               if(!bReported) {
+                  t_data.push_back(SEmbodiedEntityIntersectionItem(&cModel.GetEmbodiedEntity(), fT));
+               }
+            }
+         }
+      }
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DEngine::AddPhysicsModel(const std::string& str_id,
+                                             CKinematics2DModel& c_model) {
+      m_tPhysicsModels[str_id] = &c_model;
+      if(c_model.IsMovable()) {
+         m_vecMovables.push_back(&c_model);
+      }
+      else {
+         m_vecObstacles.push_back(&c_model);
+         m_bObstaclesChanged = true;
+      }
+      m_bGridReady = false;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DEngine::RemovePhysicsModel(const std::string& str_id) {
+      CKinematics2DModel::TMap::iterator it = m_tPhysicsModels.find(str_id);
+      if(it == m_tPhysicsModels.end()) {
+         THROW_ARGOSEXCEPTION("Kinematics2d model id \"" << str_id << "\" not found in kinematics2d engine \"" << GetId() << "\"");
+      }
+      CKinematics2DModel* pcModel = it->second;
+      std::vector<CKinematics2DModel*>& vecModels = pcModel->IsMovable() ? m_vecMovables : m_vecObstacles;
+      vecModels.erase(std::find(vecModels.begin(), vecModels.end(), pcModel));
+      if(!pcModel->IsMovable()) {
+         m_bObstaclesChanged = true;
+      }
+      m_bGridReady = false;
+      delete pcModel;
+      m_tPhysicsModels.erase(it);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   bool CKinematics2DEngine::IsColliding(const CKinematics2DModel& c_model) const {
+      /* Only used to place entities, so a linear scan is enough */
+      for(CKinematics2DModel::TMap::const_iterator it = m_tPhysicsModels.begin();
+          it != m_tPhysicsModels.end(); ++it) {
+         if(it->second != &c_model && c_model.Overlaps(*it->second)) {
+            return true;
+         }
+      }
+      return false;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DEngine::SetupGrid() {
+      /* Cells at least as large as two robots, so neighbours are in the 3x3 cells around */
+      Real fMaxMovableRadius = 0.0;
+      for(size_t i = 0; i < m_vecMovables.size(); ++i) {
+         fMaxMovableRadius = Max(fMaxMovableRadius, m_vecMovables[i]->GetRadius());
+      }
+      Real fCellSize = Max(m_fCellSize, 2.0 * fMaxMovableRadius);
+      if(fCellSize <= 0.0) {
+         fCellSize = 1.0;
+      }
+      const CRange<CVector3>& cLimits = CSimulator::GetInstance().GetSpace().GetArenaLimits();
+      CVector2 cGridMin(cLimits.GetMin().GetX(), cLimits.GetMin().GetY());
+      UInt32 unWidth = Max<UInt32>(1, static_cast<UInt32>(std::ceil((cLimits.GetMax().GetX() - cLimits.GetMin().GetX()) / fCellSize)));
+      UInt32 unHeight = Max<UInt32>(1, static_cast<UInt32>(std::ceil((cLimits.GetMax().GetY() - cLimits.GetMin().GetY()) / fCellSize)));
+      bool bResized = (unWidth != m_unGridWidth || unHeight != m_unGridHeight ||
+                       cGridMin != m_cGridMin || fMaxMovableRadius != m_fMaxMovableRadius);
+      m_fMaxMovableRadius = fMaxMovableRadius;
+      m_cGridMin = cGridMin;
+      m_fInverseCellSize = 1.0 / fCellSize;
+      m_unGridWidth = unWidth;
+      m_unGridHeight = unHeight;
+      m_vecMovableCellStart.resize(m_unGridWidth * m_unGridHeight + 1);
+      if(!m_bObstaclesChanged && !bResized) return;
+      /* Obstacles go in every cell a robot touching them can be centered in */
+      std::vector<UInt32> vecCount(m_unGridWidth * m_unGridHeight + 1, 0);
+      for(UInt32 unPass = 0; unPass < 2; ++unPass) {
+         for(UInt32 i = 0; i < m_vecObstacles.size(); ++i) {
+            const SBoundingBox& sBox = m_vecObstacles[i]->GetBoundingBox();
+            UInt32 unMaxX = GetCellX(sBox.MaxCorner.GetX() + m_fMaxMovableRadius);
+            UInt32 unMinY = GetCellY(sBox.MinCorner.GetY() - m_fMaxMovableRadius);
+            UInt32 unMaxY = GetCellY(sBox.MaxCorner.GetY() + m_fMaxMovableRadius);
+            for(UInt32 unX = GetCellX(sBox.MinCorner.GetX() - m_fMaxMovableRadius); unX <= unMaxX; ++unX) {
+               for(UInt32 unY = unMinY; unY <= unMaxY; ++unY) {
+                  UInt32 unCell = unX * m_unGridHeight + unY;
+                  if(unPass == 0) {
+                     ++vecCount[unCell + 1];
+                  }
+                  else {
+                     m_vecObstaclesByCell[vecCount[unCell]++] = i;
+                  }
+               }
+            }
+         }
+         if(unPass == 0) {
+            for(size_t i = 1; i < vecCount.size(); ++i) {
+               vecCount[i] += vecCount[i - 1];
+            }
+            m_vecObstacleCellStart = vecCount;
+            m_vecObstaclesByCell.resize(vecCount.back());
+         }
+      }
+      m_bObstaclesChanged = false;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DEngine::BuildMovableGrid() {
+      /* Counting sort of the robots by the cell of their center */
+      m_vecMovableCell.resize(m_vecMovables.size());
+      m_vecMovablesByCell.resize(m_vecMovables.size());
+      std::fill(m_vecMovableCellStart.begin(), m_vecMovableCellStart.end(), 0);
+      for(size_t i = 0; i < m_vecMovables.size(); ++i) {
+         const CVector2& cPosition = m_vecMovables[i]->GetPosition();
+         m_vecMovableCell[i] = GetCellX(cPosition.GetX()) * m_unGridHeight + GetCellY(cPosition.GetY());
+         ++m_vecMovableCellStart[m_vecMovableCell[i]];
+      }
+      /* Each cell start holds the end of the cell, then goes back to its start while filling */
+      for(size_t i = 1; i + 1 < m_vecMovableCellStart.size(); ++i) {
+         m_vecMovableCellStart[i] += m_vecMovableCellStart[i - 1];
+      }
+      m_vecMovableCellStart.back() = m_vecMovables.size();
+      for(size_t i = m_vecMovables.size(); i > 0; --i) {
+         m_vecMovablesByCell[--m_vecMovableCellStart[m_vecMovableCell[i - 1]]] = i - 1;
+      }
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DEngine::ResolveCollisions() {
+      CVector2 cDirection;
+      for(UInt32 i = 0; i < m_vecMovables.size(); ++i) {
+         CKinematics2DModel& cModel = *m_vecMovables[i];
+         UInt32 unCell = m_vecMovableCell[i];
+         UInt32 unCellX = unCell / m_unGridHeight;
+         UInt32 unCellY = unCell % m_unGridHeight;
+         /* Robots, each pair once, both move half of the overlap */
+         for(UInt32 unX = (unCellX > 0 ? unCellX - 1 : 0); unX <= Min(unCellX + 1, m_unGridWidth - 1); ++unX) {
+            for(UInt32 unY = (unCellY > 0 ? unCellY - 1 : 0); unY <= Min(unCellY + 1, m_unGridHeight - 1); ++unY) {
+               UInt32 unOther = unX * m_unGridHeight + unY;
+               for(UInt32 j = m_vecMovableCellStart[unOther]; j < m_vecMovableCellStart[unOther + 1]; ++j) {
+                  if(m_vecMovablesByCell[j] <= i) continue;
+                  CKinematics2DModel& cOther = *m_vecMovables[m_vecMovablesByCell[j]];
+                  Real fPenetration = cOther.Penetration(cDirection, cModel.GetPosition(), cModel.GetRadius());
+                  if(fPenetration > 0.0) {
+                     cDirection *= fPenetration * 0.5;
+                     cModel.Translate(cDirection);
+                     cOther.Translate(-cDirection);
+                  }
+               }
+            }
+         }
+         /* Obstacles, the robot moves out of them entirely */
+         for(UInt32 j = m_vecObstacleCellStart[unCell]; j < m_vecObstacleCellStart[unCell + 1]; ++j) {
+            Real fPenetration = m_vecObstacles[m_vecObstaclesByCell[j]]->Penetration(cDirection, cModel.GetPosition(), cModel.GetRadius());
+            if(fPenetration > 0.0) {
+               cModel.Translate(cDirection * fPenetration);
+            }
+         }
+      }
+   }
+
+   /****************************************/
+   /****************************************/
+
+   UInt32 CKinematics2DEngine::GetCellX(Real f_x) const {
+      Real fCell = std::floor((f_x - m_cGridMin.GetX()) * m_fInverseCellSize);
+      if(fCell <= 0.0) return 0;
+      return Min(static_cast<UInt32>(fCell), m_unGridWidth - 1);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   UInt32 CKinematics2DEngine::GetCellY(Real f_y) const {
+      Real fCell = std::floor((f_y - m_cGridMin.GetY()) * m_fInverseCellSize);
+      if(fCell <= 0.0) return 0;
+      return Min(static_cast<UInt32>(fCell), m_unGridHeight - 1);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   REGISTER_PHYSICS_ENGINE(CKinematics2DEngine,
+                           "kinematics2d",
+                           "Coverage search developers",
+                           "1.0",
+                           "A kinematic 2D engine for large parameter sweeps.",
+                           "This physics engine moves differential drive robots along the arc given by\n"
+                           "their wheel velocities, without forces or contact dynamics. Shapes that overlap\n"
+                           "after the move are pushed apart on a uniform grid. It supports the foot-bot,\n"
+                           "the custom foot-bot, the target, and boxes and cylinders, which are always\n"
+                           "treated as fixed obstacles. Grippers and turrets are not simulated.\n\n"
+                           "REQUIRED XML CONFIGURATION\n\n"
+                           "  <physics_engines>\n"
+                           "    ...\n"
+                           "    <kinematics2d id=\"kin2d\" />\n"
+                           "    ...\n"
+                           "  </physics_engines>\n\n"
+                           "The 'id' attribute is necessary and must be unique among the physics engines.\n\n"
+                           "OPTIONAL XML CONFIGURATION\n\n"
+                           "The 'cell_size' attribute sets the side of the grid cells in meters. It defaults\n"
+                           "to, and cannot be smaller than, the diameter of the largest robot. The\n"
+                           "'collision_passes' attribute sets how many times per step overlaps are\n"
+                           "resolved, 2 by default. More passes untangle dense crowds better.\n\n"
+                           "  <physics_engines>\n"
+                           "    ...\n"
+                           "    <kinematics2d id=\"kin2d\" cell_size=\"0.5\" collision_passes=\"3\" />\n"
+                           "    ...\n"
+                           "  </physics_engines>\n",
+                           "Usable"
+      );
+
+}
@@ -0,0 +1,147 @@
+/**
+ * @file kinematics2d_engine.h
+ *
+ * Physics engine for large parameter sweeps that do not need contact
+ * dynamics. Differential drive robots follow their wheel velocities in
+ * closed form and overlapping shapes are pushed apart on a uniform grid.
+ */
+
+#ifndef KINEMATICS2D_ENGINE_H
+#define KINEMATICS2D_ENGINE_H
+
+#include <argos3/core/simulator/entity/entity.h>
+#include <argos3/core/simulator/physics_engine/physics_engine.h>
+#include "kinematics2d_model.h"
+
+namespace argos {
+
+   class CKinematics2DEngine : public CPhysicsEngine {
+
+   public:
+
+      CKinematics2DEngine();
+      virtual ~CKinematics2DEngine() {}
+
+      virtual void Init(TConfigurationNode& t_tree);
+      virtual void Reset();
+      virtual void Destroy();
+
+      virtual void Update();
+
+      virtual size_t GetNumPhysicsModels();
+      virtual bool AddEntity(CEntity& c_entity);
+      virtual bool RemoveEntity(CEntity& c_entity);
+
+      virtual bool IsPointContained(const CVector3& c_point);
+      virtual bool IsEntityTransferNeeded() const;
+      virtual void TransferEntities();
+
+      virtual void CheckIntersectionWithRay(TEmbodiedEntityIntersectionData& t_data,
+                                            const CRay3& c_ray) const;
+
+      void AddPhysicsModel(const std::string& str_id,
+                           CKinematics2DModel& c_model);
+      void RemovePhysicsModel(const std::string& str_id);
+
+      /** Returns true if the model overlaps any other model */
+      bool IsColliding(const CKinematics2DModel& c_model) const;
+
+      /** To be called when a model is moved outside of Update() */
+      inline void InvalidateGrid() {
+         m_bGridReady = false;
+         m_bObstaclesChanged = true;
+      }
+
+   private:
+
+      void SetupGrid();
+      void BuildMovableGrid();
+      void ResolveCollisions();
+
+      inline UInt32 GetCellX(Real f_x) const;
+      inline UInt32 GetCellY(Real f_y) const;
+
+   private:
+
+      CKinematics2DModel::TMap m_tPhysicsModels;
+      std::vector<CKinematics2DModel*> m_vecMovables;
+      std::vector<CKinematics2DModel*> m_vecObstacles;
+
+      Real   m_fCellSize;
+      UInt32 m_unCollisionPasses;
+
+      /* Grid over the arena, models outside are kept in the border cells */
+      bool     m_bGridReady;
+      bool     m_bObstaclesChanged;
+      Real     m_fMaxMovableRadius;
+      CVector2 m_cGridMin;
+      Real     m_fInverseCellSize;
+      UInt32   m_unGridWidth;
+      UInt32   m_unGridHeight;
+      /* Movables by cell of their center, rebuilt each pass with a counting sort */
+      std::vector<UInt32> m_vecMovableCellStart;
+      std::vector<UInt32> m_vecMovablesByCell;
+      std::vector<UInt32> m_vecMovableCell;
+      /* Obstacles in every cell their bounding box, grown by the largest movable radius, touches */
+      std::vector<UInt32> m_vecObstacleCellStart;
+      std::vector<UInt32> m_vecObstaclesByCell;
+   };
+
+   /****************************************/
+   /****************************************/
+
+   template <typename ACTION>
+   class CKinematics2DOperation : public CEntityOperation<ACTION, CKinematics2DEngine, SOperationOutcome> {
+   public:
+      virtual ~CKinematics2DOperation() {}
+   };
+
+   class CKinematics2DOperationAddEntity : public CKinematics2DOperation<CKinematics2DOperationAddEntity> {
+   public:
+      virtual ~CKinematics2DOperationAddEntity() {}
+   };
+
+   class CKinematics2DOperationRemoveEntity : public CKinematics2DOperation<CKinematics2DOperationRemoveEntity> {
+   public:
+      virtual ~CKinematics2DOperationRemoveEntity() {}
+   };
+
+#define REGISTER_KINEMATICS2D_OPERATION(ACTION, OPERATION, ENTITY)      \
+   REGISTER_ENTITY_OPERATION(ACTION, CKinematics2DEngine, OPERATION, SOperationOutcome, ENTITY);
+
+   /*
+    * Registers the add and remove operations of an entity, the model is
+    * created by an overload of CreateKinematics2DModel(engine, entity).
+    */
+#define REGISTER_KINEMATICS2D_OPERATIONS_ON_ENTITY(SPACE_ENTITY)        \
+   class CKinematics2DOperationAdd ## SPACE_ENTITY : public CKinematics2DOperationAddEntity { \
+   public:                                                              \
+      virtual ~CKinematics2DOperationAdd ## SPACE_ENTITY() {}           \
+      SOperationOutcome ApplyTo(CKinematics2DEngine& c_engine,          \
+                                SPACE_ENTITY& c_entity) {               \
+         CKinematics2DModel* pcModel = CreateKinematics2DModel(c_engine, c_entity); \
+         c_engine.AddPhysicsModel(c_entity.GetId(), *pcModel);          \
+         c_entity.GetEmbodiedEntity().AddPhysicsModel(c_engine.GetId(), *pcModel); \
+         return SOperationOutcome(true);                                \
+      }                                                                 \
+   };                                                                   \
+   class CKinematics2DOperationRemove ## SPACE_ENTITY : public CKinematics2DOperationRemoveEntity { \
+   public:                                                              \
+      virtual ~CKinematics2DOperationRemove ## SPACE_ENTITY() {}        \
+      SOperationOutcome ApplyTo(CKinematics2DEngine& c_engine,          \
+                                SPACE_ENTITY& c_entity) {               \
+         c_engine.RemovePhysicsModel(c_entity.GetId());                 \
+         c_entity.GetEmbodiedEntity().RemovePhysicsModel(c_engine.GetId()); \
+         return SOperationOutcome(true);                                \
+      }                                                                 \
+   };                                                                   \
+   REGISTER_KINEMATICS2D_OPERATION(CKinematics2DOperationAddEntity,     \
+                                   CKinematics2DOperationAdd ## SPACE_ENTITY, \
+                                   SPACE_ENTITY);                       \
+   REGISTER_KINEMATICS2D_OPERATION(CKinematics2DOperationRemoveEntity,  \
+                                   CKinematics2DOperationRemove ## SPACE_ENTITY, \
+                                   SPACE_ENTITY);
+
+}
+
+#endif
@@ -0,0 +1,385 @@
+/**
+ * @file kinematics2d_model.cpp
+ */
+
+#include "kinematics2d_model.h"
+#include "kinematics2d_engine.h"
+#include <argos3/plugins/simulator/entities/box_entity.h>
+#include <argos3/plugins/simulator/entities/cylinder_entity.h>
+#include <argos3/plugins/simulator/entities/wheeled_entity.h>
+#include <argos3/plugins/robots/foot-bot/simulator/footbot_entity.h>
+#include <robots/custom-foot-bot/simulator/footbot_entity.h>
+#include <robots/target/target_entity.h>
+#include <robots/target/target_details.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace argos {
+
+   /****************************************/
+   /****************************************/
+
+   /* Same body as in the dynamics2d foot-bot model */
+   static const Real FOOTBOT_RADIUS                   = 0.085036758f;
+   static const Real FOOTBOT_INTERWHEEL_DISTANCE      = 0.14f;
+   static const Real FOOTBOT_HEIGHT                   = 0.146899733f;
+
+   enum FOOTBOT_WHEELS {
+      FOOTBOT_LEFT_WHEEL = 0,
+      FOOTBOT_RIGHT_WHEEL = 1
+   };
+
+   /* Below this angular velocity the robot moves along a straight line */
+   static const Real MIN_ANGULAR_VELOCITY = 1e-9;
+
+   /****************************************/
+   /****************************************/
+
+   CKinematics2DModel::CKinematics2DModel(CKinematics2DEngine& c_engine,
+                                          CEmbodiedEntity& c_entity,
+                                          EShape e_shape,
+                                          const CVector2& c_half_size,
+                                          Real f_height) :
+      CPhysicsModel(c_engine, c_entity),
+      m_cEngine(c_engine),
+      m_eShape(e_shape),
+      m_cHalfSize(c_half_size),
+      m_fHeight(f_height),
+      m_fElevation(0.0) {
+      RegisterAnchorMethod<CKinematics2DModel>(
+         GetEmbodiedEntity().GetOriginAnchor(),
+         &CKinematics2DModel::UpdateOriginAnchor);
+      /* Turret, cameras and the like are rigidly attached to the body */
+      for(auto& tAnchor : GetEmbodiedEntity().GetAnchors()) {
+         if(tAnchor.second != &GetEmbodiedEntity().GetOriginAnchor()) {
+            RegisterAnchorMethod<CKinematics2DModel>(
+               *tAnchor.second,
+               &CKinematics2DModel::UpdateRigidAnchor);
+         }
+      }
+      ReadPoseFromEntity();
+      UpdateEntityStatus();
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DModel::Reset() {
+      /* The embodied entity is back to its initial pose already */
+      ReadPoseFromEntity();
+      UpdateEntityStatus();
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DModel::MoveTo(const CVector3& c_position,
+                                   const CQuaternion& c_orientation) {
+      CRadians cYAngle, cXAngle;
+      c_orientation.ToEulerAngles(m_cYaw, cYAngle, cXAngle);
+      m_cPosition.Set(c_position.GetX(), c_position.GetY());
+      m_fElevation = c_position.GetZ();
+      m_cEngine.InvalidateGrid();
+      UpdateEntityStatus();
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DModel::CalculateBoundingBox() {
+      CVector2 cExtent = m_cHalfSize;
+      if(m_eShape == SHAPE_BOX) {
+         Real fCos = Abs(Cos(m_cYaw));
+         Real fSin = Abs(Sin(m_cYaw));
+         cExtent.Set(fCos * m_cHalfSize.GetX() + fSin * m_cHalfSize.GetY(),
+                     fSin * m_cHalfSize.GetX() + fCos * m_cHalfSize.GetY());
+      }
+      GetBoundingBox().MinCorner.Set(m_cPosition.GetX() - cExtent.GetX(),
+                                     m_cPosition.GetY() - cExtent.GetY(),
+                                     m_fElevation);
+      GetBoundingBox().MaxCorner.Set(m_cPosition.GetX() + cExtent.GetX(),
+                                     m_cPosition.GetY() + cExtent.GetY(),
+                                     m_fElevation + m_fHeight);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   bool CKinematics2DModel::IsCollidingWithSomething() const {
+      return m_cEngine.IsColliding(*this);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   bool CKinematics2DModel::Overlaps(const CKinematics2DModel& c_other) const {
+      CVector2 cDirection;
+      if(m_eShape == SHAPE_CIRCLE) {
+         return c_other.Penetration(cDirection, m_cPosition, GetRadius()) > 0.0;
+      }
+      if(c_other.m_eShape == SHAPE_CIRCLE) {
+         return Penetration(cDirection, c_other.m_cPosition, c_other.GetRadius()) > 0.0;
+      }
+      return false;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   Real CKinematics2DModel::Penetration(CVector2& c_direction,
+                                        const CVector2& c_center,
+                                        Real f_radius) const {
+      if(m_eShape == SHAPE_CIRCLE) {
+         c_direction = c_center - m_cPosition;
+         Real fDistance = c_direction.Length();
+         Real fPenetration = GetRadius() + f_radius - fDistance;
+         if(fPenetration <= 0.0) return 0.0;
+         if(fDistance > 0.0) {
+            c_direction /= fDistance;
+         }
+         else {
+            c_direction = CVector2::X;
+         }
+         return fPenetration;
+      }
+      /* Box: find the closest point in its frame */
+      CVector2 cLocal = ToLocal(c_center);
+      CVector2 cClosest(Min(Max(cLocal.GetX(), -m_cHalfSize.GetX()), m_cHalfSize.GetX()),
+                        Min(Max(cLocal.GetY(), -m_cHalfSize.GetY()), m_cHalfSize.GetY()));
+      CVector2 cLocalDirection;
+      Real fPenetration;
+      if(cClosest != cLocal) {
+         /* Center outside of the box */
+         cLocalDirection = cLocal - cClosest;
+         Real fDistance = cLocalDirection.Length();
+         fPenetration = f_radius - fDistance;
+         if(fPenetration <= 0.0) return 0.0;
+         cLocalDirection /= fDistance;
+      }
+      else {
+         /* Center inside of the box, leave through the closest side */
+         Real fToX = m_cHalfSize.GetX() - Abs(cLocal.GetX());
+         Real fToY = m_cHalfSize.GetY() - Abs(cLocal.GetY());
+         if(fToX < fToY) {
+            cLocalDirection.Set(cLocal.GetX() < 0.0 ? -1.0 : 1.0, 0.0);
+            fPenetration = fToX + f_radius;
+         }
+         else {
+            cLocalDirection.Set(0.0, cLocal.GetY() < 0.0 ? -1.0 : 1.0);
+            fPenetration = fToY + f_radius;
+         }
+      }
+      c_direction = cLocalDirection.Rotate(m_cYaw);
+      return fPenetration;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   bool CKinematics2DModel::IntersectsRay(Real& f_t_on_ray,
+                                          const CRay3& c_ray) const {
+      const CVector3& cStart = c_ray.GetStart();
+      const CVector3& cEnd = c_ray.GetEnd();
+      CVector2 cStart2(cStart.GetX(), cStart.GetY());
+      CVector2 cDelta(cEnd.GetX() - cStart.GetX(), cEnd.GetY() - cStart.GetY());
+      Real fT;
+      if(m_eShape == SHAPE_CIRCLE) {
+         /* Entering root of |start + t * delta - center| = radius */
+         CVector2 cFromCenter = cStart2 - m_cPosition;
+         Real fA = cDelta.SquareLength();
+         if(fA == 0.0) return false;
+         Real fB = cFromCenter.DotProduct(cDelta);
+         Real fC = cFromCenter.SquareLength() - GetRadius() * GetRadius();
+         Real fDiscriminant = fB * fB - fA * fC;
+         if(fDiscriminant < 0.0) return false;
+         fT = (-fB - std::sqrt(fDiscriminant)) / fA;
+      }
+      else {
+         /* Slab test in the frame of the box */
+         CVector2 cLocalStart = ToLocal(cStart2);
+         CVector2 cLocalDelta = cDelta;
+         cLocalDelta.Rotate(-m_cYaw);
+         Real fEnter = -std::numeric_limits<Real>::max();
+         Real fExit = std::numeric_limits<Real>::max();
+         Real pfStart[2] = { cLocalStart.GetX(), cLocalStart.GetY() };
+         Real pfDelta[2] = { cLocalDelta.GetX(), cLocalDelta.GetY() };
+         Real pfHalf[2] = { m_cHalfSize.GetX(), m_cHalfSize.GetY() };
+         for(UInt32 i = 0; i < 2; ++i) {
+            if(pfDelta[i] == 0.0) {
+               if(Abs(pfStart[i]) > pfHalf[i]) return false;
+               continue;
+            }
+            Real fT1 = (-pfHalf[i] - pfStart[i]) / pfDelta[i];
+            Real fT2 = ( pfHalf[i] - pfStart[i]) / pfDelta[i];
+            if(fT1 > fT2) std::swap(fT1, fT2);
+            fEnter = Max(fEnter, fT1);
+            fExit = Min(fExit, fT2);
+         }
+         if(fEnter > fExit) return false;
+         fT = fEnter;
+      }
+      if(fT < 0.0 || fT > 1.0) return false;
+      /* The shapes are extruded from the elevation up to the height */
+      Real fZ = cStart.GetZ() + fT * (cEnd.GetZ() - cStart.GetZ());
+      if(fZ < m_fElevation || fZ > m_fElevation + m_fHeight) return false;
+      f_t_on_ray = fT;
+      return true;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DModel::UpdateOriginAnchor(SAnchor& s_anchor) {
+      s_anchor.Position.Set(m_cPosition.GetX(), m_cPosition.GetY(), m_fElevation);
+      s_anchor.Orientation.FromAngleAxis(m_cYaw, CVector3::Z);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DModel::UpdateRigidAnchor(SAnchor& s_anchor) {
+      CQuaternion cBodyOrientation(m_cYaw, CVector3::Z);
+      s_anchor.Position = s_anchor.OffsetPosition;
+      s_anchor.Position.Rotate(cBodyOrientation);
+      s_anchor.Position += CVector3(m_cPosition.GetX(), m_cPosition.GetY(), m_fElevation);
+      s_anchor.Orientation = cBodyOrientation * s_anchor.OffsetOrientation;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DModel::ReadPoseFromEntity() {
+      const SAnchor& sOrigin = GetEmbodiedEntity().GetOriginAnchor();
+      m_cPosition.Set(sOrigin.Position.GetX(), sOrigin.Position.GetY());
+      m_fElevation = sOrigin.Position.GetZ();
+      CRadians cYAngle, cXAngle;
+      sOrigin.Orientation.ToEulerAngles(m_cYaw, cYAngle, cXAngle);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   CVector2 CKinematics2DModel::ToLocal(const CVector2& c_point) const {
+      CVector2 cLocal = c_point - m_cPosition;
+      return cLocal.Rotate(-m_cYaw);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   CKinematics2DDifferentialDriveModel::CKinematics2DDifferentialDriveModel(CKinematics2DEngine& c_engine,
+                                                                            CEmbodiedEntity& c_entity,
+                                                                            CWheeledEntity& c_wheeled_entity,
+                                                                            Real f_radius,
+                                                                            Real f_height,
+                                                                            Real f_interwheel_distance) :
+      CKinematics2DModel(c_engine, c_entity, SHAPE_CIRCLE, CVector2(f_radius, f_radius), f_height),
+      m_pfWheelVelocities(c_wheeled_entity.GetWheelVelocities()),
+      m_fInterwheelDistance(f_interwheel_distance),
+      m_fLinearVelocity(0.0),
+      m_fAngularVelocity(0.0) {}
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DDifferentialDriveModel::Reset() {
+      m_fLinearVelocity = 0.0;
+      m_fAngularVelocity = 0.0;
+      CKinematics2DModel::Reset();
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DDifferentialDriveModel::UpdateFromEntityStatus() {
+      m_fLinearVelocity = (m_pfWheelVelocities[FOOTBOT_LEFT_WHEEL] +
+                           m_pfWheelVelocities[FOOTBOT_RIGHT_WHEEL]) * 0.5;
+      m_fAngularVelocity = (m_pfWheelVelocities[FOOTBOT_RIGHT_WHEEL] -
+                            m_pfWheelVelocities[FOOTBOT_LEFT_WHEEL]) / m_fInterwheelDistance;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CKinematics2DDifferentialDriveModel::Step(Real f_dt) {
+      Real fYaw = m_cYaw.GetValue();
+      if(Abs(m_fAngularVelocity) < MIN_ANGULAR_VELOCITY) {
+         m_cPosition += CVector2(m_fLinearVelocity * f_dt, m_cYaw);
+      }
+      else {
+         /* Exact integration along the arc of radius v / w */
+         Real fRadius = m_fLinearVelocity / m_fAngularVelocity;
+         Real fNewYaw = fYaw + m_fAngularVelocity * f_dt;
+         m_cPosition += CVector2(fRadius * (std::sin(fNewYaw) - std::sin(fYaw)),
+                                 fRadius * (std::cos(fYaw) - std::cos(fNewYaw)));
+         m_cYaw.SetValue(fNewYaw);
+         m_cYaw.SignedNormalize();
+      }
+   }
+
+   /****************************************/
+   /****************************************/
+
+   static CKinematics2DModel* CreateKinematics2DModel(CKinematics2DEngine& c_engine,
+                                                      CBoxEntity& c_entity) {
+      const CVector3& cSize = c_entity.GetSize();
+      return new CKinematics2DModel(c_engine,
+                                    c_entity.GetEmbodiedEntity(),
+                                    CKinematics2DModel::SHAPE_BOX,
+                                    CVector2(cSize.GetX() * 0.5, cSize.GetY() * 0.5),
+                                    cSize.GetZ());
+   }
+
+   static CKinematics2DModel* CreateKinematics2DModel(CKinematics2DEngine& c_engine,
+                                                      CCylinderEntity& c_entity) {
+      return new CKinematics2DModel(c_engine,
+                                    c_entity.GetEmbodiedEntity(),
+                                    CKinematics2DModel::SHAPE_CIRCLE,
+                                    CVector2(c_entity.GetRadius(), c_entity.GetRadius()),
+                                    c_entity.GetHeight());
+   }
+
+   static CKinematics2DModel* CreateKinematics2DModel(CKinematics2DEngine& c_engine,
+                                                      CTargetEntity& c_entity) {
+      return new CKinematics2DModel(c_engine,
+                                    c_entity.GetEmbodiedEntity(),
+                                    CKinematics2DModel::SHAPE_CIRCLE,
+                                    CVector2(BODY_RADIUS, BODY_RADIUS),
+                                    BODY_HEIGHT);
+   }
+
+   static CKinematics2DModel* CreateKinematics2DModel(CKinematics2DEngine& c_engine,
+                                                      CFootBotEntity& c_entity) {
+      return new CKinematics2DDifferentialDriveModel(c_engine,
+                                                     c_entity.GetEmbodiedEntity(),
+                                                     c_entity.GetWheeledEntity(),
+                                                     FOOTBOT_RADIUS,
+                                                     FOOTBOT_HEIGHT,
+                                                     FOOTBOT_INTERWHEEL_DISTANCE);
+   }
+
+   static CKinematics2DModel* CreateKinematics2DModel(CKinematics2DEngine& c_engine,
+                                                      CCustomFootBotEntity& c_entity) {
+      return new CKinematics2DDifferentialDriveModel(c_engine,
+                                                     c_entity.GetEmbodiedEntity(),
+                                                     c_entity.GetWheeledEntity(),
+                                                     FOOTBOT_RADIUS,
+                                                     FOOTBOT_HEIGHT,
+                                                     FOOTBOT_INTERWHEEL_DISTANCE);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   /* Movable boxes and cylinders are fixed obstacles in this engine */
+   REGISTER_KINEMATICS2D_OPERATIONS_ON_ENTITY(CBoxEntity);
+   REGISTER_KINEMATICS2D_OPERATIONS_ON_ENTITY(CCylinderEntity);
+   REGISTER_KINEMATICS2D_OPERATIONS_ON_ENTITY(CTargetEntity);
+   REGISTER_KINEMATICS2D_OPERATIONS_ON_ENTITY(CFootBotEntity);
+   REGISTER_KINEMATICS2D_OPERATIONS_ON_ENTITY(CCustomFootBotEntity);
+
+   /****************************************/
+   /****************************************/
+
+}
@@ -0,0 +1,161 @@
+/**
+ * @file kinematics2d_model.h
+ *
+ * Models of the kinematics2d engine. Every entity is a circle or a box on
+ * the XY plane. Differential drive robots move, everything else is a fixed
+ * obstacle.
+ */
+
+#ifndef KINEMATICS2D_MODEL_H
+#define KINEMATICS2D_MODEL_H
+
+namespace argos {
+   class CKinematics2DEngine;
+   class CWheeledEntity;
+}
+
+#include <argos3/core/simulator/physics_engine/physics_model.h>
+#include <argos3/core/simulator/entity/embodied_entity.h>
+#include <argos3/core/utility/math/vector2.h>
+#include <argos3/core/utility/math/ray3.h>
+
+namespace argos {
+
+   class CKinematics2DModel : public CPhysicsModel {
+
+   public:
+
+      typedef std::map<std::string, CKinematics2DModel*> TMap;
+
+      enum EShape {
+         SHAPE_CIRCLE,
+         SHAPE_BOX
+      };
+
+   public:
+
+      /**
+       * @param c_half_size the half sides of a box, a circle uses the X value as radius
+       */
+      CKinematics2DModel(CKinematics2DEngine& c_engine,
+                         CEmbodiedEntity& c_entity,
+                         EShape e_shape,
+                         const CVector2& c_half_size,
+                         Real f_height);
+      virtual ~CKinematics2DModel() {}
+
+      virtual void Reset();
+
+      virtual void MoveTo(const CVector3& c_position,
+                          const CQuaternion& c_orientation);
+
+      virtual void CalculateBoundingBox();
+
+      virtual void UpdateFromEntityStatus() {}
+
+      virtual bool IsCollidingWithSomething() const;
+
+      /** Integrates the motion over the given time, obstacles stay still */
+      virtual void Step(Real f_dt) {}
+
+      virtual bool IsMovable() const {
+         return false;
+      }
+
+      inline EShape GetShape() const {
+         return m_eShape;
+      }
+
+      inline const CVector2& GetPosition() const {
+         return m_cPosition;
+      }
+
+      inline Real GetRadius() const {
+         return m_cHalfSize.GetX();
+      }
+
+      /** Moves the model without any check, used to push it out of others */
+      inline void Translate(const CVector2& c_delta) {
+         m_cPosition += c_delta;
+      }
+
+      /**
+       * Returns true if the shapes overlap. Two boxes are never reported,
+       * they can only be fixed obstacles.
+       */
+      bool Overlaps(const CKinematics2DModel& c_other) const;
+
+      /**
+       * Returns the distance a circle at the given position has to move out of
+       * this model, zero when they do not overlap.
+       * @param c_direction set to the direction to move along
+       */
+      Real Penetration(CVector2& c_direction,
+                       const CVector2& c_center,
+                       Real f_radius) const;
+
+      /**
+       * Returns true if the ray enters the model between its start and end.
+       * Rays starting inside the model are not reported, as in dynamics2d.
+       */
+      bool IntersectsRay(Real& f_t_on_ray,
+                         const CRay3& c_ray) const;
+
+      void UpdateOriginAnchor(SAnchor& s_anchor);
+
+      void UpdateRigidAnchor(SAnchor& s_anchor);
+
+   protected:
+
+      void ReadPoseFromEntity();
+
+      /** Returns the point in the frame of the model */
+      CVector2 ToLocal(const CVector2& c_point) const;
+
+   protected:
+
+      CKinematics2DEngine& m_cEngine;
+      EShape   m_eShape;
+      CVector2 m_cHalfSize;
+      Real     m_fHeight;
+      Real     m_fElevation;
+      CVector2 m_cPosition;
+      CRadians m_cYaw;
+   };
+
+   /****************************************/
+   /****************************************/
+
+   class CKinematics2DDifferentialDriveModel : public CKinematics2DModel {
+
+   public:
+
+      CKinematics2DDifferentialDriveModel(CKinematics2DEngine& c_engine,
+                                          CEmbodiedEntity& c_entity,
+                                          CWheeledEntity& c_wheeled_entity,
+                                          Real f_radius,
+                                          Real f_height,
+                                          Real f_interwheel_distance);
+      virtual ~CKinematics2DDifferentialDriveModel() {}
+
+      virtual void Reset();
+
+      virtual void UpdateFromEntityStatus();
+
+      virtual void Step(Real f_dt);
+
+      virtual bool IsMovable() const {
+         return true;
+      }
+
+   private:
+
+      const Real* m_pfWheelVelocities;
+      Real m_fInterwheelDistance;
+      Real m_fLinearVelocity;
+      Real m_fAngularVelocity;
+   };
+
+}
+
+#endif
@@ -0,0 +1,39 @@
+/**
+ * @file <robots/custom-foot-bot/control_interface/ci_colored_beacon_bearing_sensor.cpp>
+ *
+ * @author Paweł Jakubowski
+ */
+
+#include "ci_colored_beacon_bearing_sensor.h"
+
+#ifdef ARGOS_WITH_LUA
+#include <argos3/core/wrappers/lua/lua_utility.h>
+#endif
+
+namespace argos {
+
+#ifdef ARGOS_WITH_LUA
+void CCI_ColoredBeaconBearingSensor::CreateLuaState(lua_State* pt_lua_state) {
+    CLuaUtility::OpenRobotStateTable(pt_lua_state, "colored_beacon_bearing");
+    CLuaUtility::CloseRobotStateTable(pt_lua_state);
+}
+
+void CCI_ColoredBeaconBearingSensor::ReadingsToLuaState(lua_State* pt_lua_state) {
+    lua_getfield(pt_lua_state, -1, "colored_beacon_bearing");
+    /* Drop the readings of the previous step */
+    lua_pushnil(pt_lua_state);
+    lua_setfield(pt_lua_state, -2, "readings");
+    CLuaUtility::StartTable(pt_lua_state, "readings");
+    for(size_t i = 0; i < m_tReadings.size(); ++i) {
+        CLuaUtility::StartTable(pt_lua_state, i + 1);
+        CLuaUtility::AddToTable(pt_lua_state, "color", m_tReadings[i].Color);
+        CLuaUtility::AddToTable(pt_lua_state, "bearing", m_tReadings[i].Bearing);
+        CLuaUtility::AddToTable(pt_lua_state, "range", m_tReadings[i].Range);
+        CLuaUtility::EndTable(pt_lua_state);
+    }
+    CLuaUtility::EndTable(pt_lua_state);
+    lua_pop(pt_lua_state, 1);
+}
+#endif
+
+}
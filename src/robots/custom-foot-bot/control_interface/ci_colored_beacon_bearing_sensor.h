@@ -0,0 +1,74 @@
+/**
+ * @file <robots/custom-foot-bot/control_interface/ci_colored_beacon_bearing_sensor.h>
+ *
+ * @brief Control interface of a sensor that returns the bearing and range
+ * to every colored LED visible from the robot.
+ *
+ * Bearings are expressed in the robot frame, counter-clockwise from the
+ * robot's heading, and normalized to (-pi, pi]. This is the same convention
+ * the four perspective cameras produced when their blob positions were
+ * converted to angles.
+ *
+ * @author Paweł Jakubowski
+ */
+
+#pragma once
+
+namespace argos {
+class CCI_ColoredBeaconBearingSensor;
+}
+
+#include <argos3/core/control_interface/ci_sensor.h>
+#include <argos3/core/utility/datatypes/color.h>
+#include <argos3/core/utility/math/angles.h>
+#include <vector>
+
+namespace argos {
+
+class CCI_ColoredBeaconBearingSensor : public CCI_Sensor {
+
+public:
+
+    struct SReading {
+        CColor Color;
+        CRadians Bearing;
+        Real Range;
+
+        SReading(const CColor& c_color,
+                 const CRadians& c_bearing,
+                 Real f_range) :
+            Color(c_color),
+            Bearing(c_bearing),
+            Range(f_range) {}
+    };
+
+    typedef std::vector<SReading> TReadings;
+
+public:
+
+    CCI_ColoredBeaconBearingSensor() :
+        m_bEnabled(false) {}
+
+    virtual ~CCI_ColoredBeaconBearingSensor() {}
+
+    virtual void Enable() { m_bEnabled = true; }
+
+    virtual void Disable() { m_bEnabled = false; }
+
+    inline bool IsEnabled() const { return m_bEnabled; }
+
+    inline const TReadings& GetReadings() const { return m_tReadings; }
+
+#ifdef ARGOS_WITH_LUA
+    virtual void CreateLuaState(lua_State* pt_lua_state);
+
+    virtual void ReadingsToLuaState(lua_State* pt_lua_state);
+#endif
+
+protected:
+
+    bool m_bEnabled;
+    TReadings m_tReadings;
+};
+
+}
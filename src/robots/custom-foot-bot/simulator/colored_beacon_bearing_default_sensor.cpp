@@ -0,0 +1,128 @@
+#include "colored_beacon_bearing_default_sensor.h"
+#include <argos3/core/simulator/simulator.h>
+#include <argos3/core/simulator/entity/composable_entity.h>
+#include <argos3/core/simulator/entity/controllable_entity.h>
+#include <argos3/plugins/simulator/media/led_medium.h>
+
+namespace argos {
+
+CColoredBeaconBearingDefaultSensor::CColoredBeaconBearingDefaultSensor() :
+    m_pcControllableEntity(NULL),
+    m_pcEmbodiedEntity(NULL),
+    m_pcLEDIndex(NULL),
+    m_cOperation(*this),
+    m_fRange(2.0),
+    m_bShowRays(false) {}
+
+void CColoredBeaconBearingDefaultSensor::SetRobot(CComposableEntity& c_entity) {
+    /* Get controllable entity */
+    m_pcControllableEntity = &(c_entity.GetComponent<CControllableEntity>("controller"));
+    /* Get embodied entity */
+    m_pcEmbodiedEntity = &(c_entity.GetComponent<CEmbodiedEntity>("body"));
+}
+
+void CColoredBeaconBearingDefaultSensor::Init(TConfigurationNode& t_tree) {
+    try {
+        CCI_ColoredBeaconBearingSensor::Init(t_tree);
+        GetNodeAttributeOrDefault(t_tree, "range", m_fRange, m_fRange);
+        if(m_fRange <= 0.0) {
+            THROW_ARGOSEXCEPTION("The range of the colored beacon bearing sensor must be positive, got " << m_fRange);
+        }
+        GetNodeAttributeOrDefault(t_tree, "show_rays", m_bShowRays, m_bShowRays);
+        std::string strMedium;
+        GetNodeAttribute(t_tree, "medium", strMedium);
+        m_pcLEDIndex = &(CSimulator::GetInstance().GetMedium<CLEDMedium>(strMedium).GetIndex());
+    }
+    catch(CARGoSException& ex) {
+        THROW_ARGOSEXCEPTION_NESTED("Error initializing the colored beacon bearing sensor", ex);
+    }
+}
+
+void CColoredBeaconBearingDefaultSensor::Update() {
+    m_tReadings.clear();
+    if(!m_bEnabled) return;
+
+    const SAnchor& sOrigin = m_pcEmbodiedEntity->GetOriginAnchor();
+    m_cPosition = sOrigin.Position;
+    CRadians cAngleY, cAngleX;
+    sOrigin.Orientation.ToEulerAngles(m_cOrientation, cAngleY, cAngleX);
+
+    /* A single index query covers the whole field of view of the robot */
+    m_pcLEDIndex->ForEntitiesInBoxRange(m_cPosition,
+                                        CVector3(m_fRange, m_fRange, m_fRange),
+                                        m_cOperation);
+}
+
+void CColoredBeaconBearingDefaultSensor::Reset() {
+    m_tReadings.clear();
+}
+
+bool CColoredBeaconBearingDefaultSensor::CLEDCheckOperation::operator()(CLEDEntity& c_led) {
+    m_cSensor.CheckLED(c_led);
+    return true;
+}
+
+void CColoredBeaconBearingDefaultSensor::CheckLED(CLEDEntity& c_led) {
+    /* Switched off LEDs and the robot's own LEDs are never reported */
+    if(c_led.GetColor() == CColor::BLACK) return;
+    if(&c_led.GetRootEntity() == &m_pcEmbodiedEntity->GetRootEntity()) return;
+
+    const CVector3& cLEDPosition = c_led.GetPosition();
+    CVector2 cRelative(cLEDPosition.GetX() - m_cPosition.GetX(),
+                       cLEDPosition.GetY() - m_cPosition.GetY());
+    Real fRange = cRelative.Length();
+    if(fRange > m_fRange) return;
+
+    /* The ray is cast at the height of the LED, so that it does not hit the ground */
+    m_cOcclusionCheckRay.Set(CVector3(m_cPosition.GetX(), m_cPosition.GetY(), cLEDPosition.GetZ()),
+                             cLEDPosition);
+    if(GetClosestEmbodiedEntityIntersectedByRay(m_sIntersectionItem,
+                                                m_cOcclusionCheckRay,
+                                                *m_pcEmbodiedEntity)) {
+        if(m_bShowRays) {
+            m_pcControllableEntity->AddIntersectionPoint(m_cOcclusionCheckRay,
+                                                         m_sIntersectionItem.TOnRay);
+            m_pcControllableEntity->AddCheckedRay(true, m_cOcclusionCheckRay);
+        }
+        return;
+    }
+    if(m_bShowRays) {
+        m_pcControllableEntity->AddCheckedRay(false, m_cOcclusionCheckRay);
+    }
+
+    CRadians cBearing = (cRelative.Angle() - m_cOrientation).SignedNormalize();
+    m_tReadings.push_back(SReading(c_led.GetColor(), cBearing, fRange));
+}
+
+REGISTER_SENSOR(CColoredBeaconBearingDefaultSensor,
+                "colored_beacon_bearing", "default",
+                "Paweł Jakubowski", "1.0",
+                "A sensor that returns the bearing and range to colored LEDs.",
+                "This sensor replaces the four colored blob perspective cameras of the custom\n"
+                "foot-bot. For each LED of the given LED medium within range and not occluded by\n"
+                "another body, it returns the color of the LED, its bearing in the robot frame\n"
+                "(counter-clockwise from the heading, in (-pi, pi]) and its distance on the XY\n"
+                "plane. The sensor is disabled by default.\n\n"
+                "REQUIRED XML CONFIGURATION\n\n"
+                "    <controllers>\n"
+                "      ...\n"
+                "      <my_controller ...>\n"
+                "        ...\n"
+                "        <sensors>\n"
+                "          ...\n"
+                "          <colored_beacon_bearing implementation=\"default\"\n"
+                "                                  medium=\"leds\" />\n"
+                "          ...\n"
+                "        </sensors>\n"
+                "        ...\n"
+                "      </my_controller>\n"
+                "      ...\n"
+                "    </controllers>\n\n"
+                "OPTIONAL XML CONFIGURATION\n\n"
+                "The 'range' attribute sets the maximum detection distance in meters (default 2).\n"
+                "Setting 'show_rays' to 'true' draws the occlusion check rays in the OpenGL\n"
+                "visualization.\n",
+                "Usable"
+);
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+namespace argos {
+class CControllableEntity;
+class CEmbodiedEntity;
+class CLEDEntity;
+}
+
+#include <robots/custom-foot-bot/control_interface/ci_colored_beacon_bearing_sensor.h>
+#include <argos3/core/simulator/sensor.h>
+#include <argos3/core/simulator/entity/embodied_entity.h>
+#include <argos3/core/simulator/space/positional_indices/positional_index.h>
+#include <argos3/plugins/simulator/entities/led_entity.h>
+
+namespace argos {
+
+/*
+ * Replaces the four colored blob perspective cameras of the custom foot-bot.
+ * The LED medium index is queried once per step for the whole robot and
+ * every LED in range is checked for occlusion with a single ray, instead of
+ * projecting it onto four 900 pixel wide images.
+ */
+class CColoredBeaconBearingDefaultSensor : public CSimulatedSensor,
+                                           public CCI_ColoredBeaconBearingSensor {
+
+public:
+
+    CColoredBeaconBearingDefaultSensor();
+    virtual ~CColoredBeaconBearingDefaultSensor() = default;
+
+    virtual void SetRobot(CComposableEntity& c_entity);
+    virtual void Init(TConfigurationNode& t_tree);
+    virtual void Update();
+    virtual void Reset();
+
+private:
+
+    class CLEDCheckOperation : public CPositionalIndex<CLEDEntity>::COperation {
+    public:
+        explicit CLEDCheckOperation(CColoredBeaconBearingDefaultSensor& c_sensor) :
+            m_cSensor(c_sensor) {}
+        virtual bool operator()(CLEDEntity& c_led);
+    private:
+        CColoredBeaconBearingDefaultSensor& m_cSensor;
+    };
+
+    void CheckLED(CLEDEntity& c_led);
+
+private:
+
+    CControllableEntity* m_pcControllableEntity;
+    CEmbodiedEntity* m_pcEmbodiedEntity;
+    CPositionalIndex<CLEDEntity>* m_pcLEDIndex;
+    CLEDCheckOperation m_cOperation;
+    Real m_fRange;
+    bool m_bShowRays;
+
+    /* Robot pose cached at the beginning of each update */
+    CVector3 m_cPosition;
+    CRadians m_cOrientation;
+    SEmbodiedEntityIntersectionItem m_sIntersectionItem;
+    CRay3 m_cOcclusionCheckRay;
+};
+
+}
@@ -5,6 +5,7 @@
  */
 
 #include "dynamics2d_footbot_model.h"
+#include "dynamics2d_footbot_single_body_model.h"
 #include <argos3/plugins/robots/foot-bot/simulator/footbot_turret_entity.h>
 #include <argos3/plugins/simulator/physics_engines/dynamics2d/dynamics2d_gripping.h>
 #include <argos3/plugins/simulator/physics_engines/dynamics2d/dynamics2d_engine.h>
@@ -40,9 +41,23 @@ namespace argos {
    /****************************************/
    /****************************************/
 
+   /* The model holds references to the gripper and the turret, check them before the members are built.
+      The add operation picks the single body model for robots without them. */
+   static CCustomFootBotEntity& CheckRequiredComponents(CCustomFootBotEntity& c_entity) {
+      if(!c_entity.HasComponents(CCustomFootBotEntity::COMPONENT_GRIPPER |
+                                 CCustomFootBotEntity::COMPONENT_TURRET)) {
+         THROW_ARGOSEXCEPTION("The dynamics2d model of foot-bot \"" << c_entity.GetId() <<
+                              "\" needs the gripper and turret components");
+      }
+      return c_entity;
+   }
+
+   /****************************************/
+   /****************************************/
+
    CDynamics2DCustomFootBotModel::CDynamics2DCustomFootBotModel(CDynamics2DEngine& c_engine,
                                                     CCustomFootBotEntity& c_entity) :
-      CDynamics2DMultiBodyObjectModel(c_engine, c_entity),
+      CDynamics2DMultiBodyObjectModel(c_engine, CheckRequiredComponents(c_entity)),
       m_cFootBotEntity(c_entity),
       m_cWheeledEntity(m_cFootBotEntity.GetWheeledEntity()),
       m_cGripperEntity(c_entity.GetGripperEquippedEntity()),
@@ -61,18 +76,20 @@ namespace argos {
       RegisterAnchorMethod<CDynamics2DCustomFootBotModel>(
          GetEmbodiedEntity().GetAnchor("turret"),
          &CDynamics2DCustomFootBotModel::UpdateTurretAnchor);
-      RegisterAnchorMethod<CDynamics2DCustomFootBotModel>(
-         GetEmbodiedEntity().GetAnchor("perspective_camera_left"),
-         &CDynamics2DCustomFootBotModel::UpdatePerspectiveCameraAnchor);
-      RegisterAnchorMethod<CDynamics2DCustomFootBotModel>(
-          GetEmbodiedEntity().GetAnchor("perspective_camera_right"),
-          &CDynamics2DCustomFootBotModel::UpdatePerspectiveCameraAnchor);
-      RegisterAnchorMethod<CDynamics2DCustomFootBotModel>(
-          GetEmbodiedEntity().GetAnchor("perspective_camera_front"),
-          &CDynamics2DCustomFootBotModel::UpdatePerspectiveCameraAnchor);
-      RegisterAnchorMethod<CDynamics2DCustomFootBotModel>(
-          GetEmbodiedEntity().GetAnchor("perspective_camera_back"),
-          &CDynamics2DCustomFootBotModel::UpdatePerspectiveCameraAnchor);
+      if(m_cFootBotEntity.HasComponents(CCustomFootBotEntity::COMPONENT_PERSPECTIVE_CAMERAS)) {
+         RegisterAnchorMethod<CDynamics2DCustomFootBotModel>(
+            GetEmbodiedEntity().GetAnchor("perspective_camera_left"),
+            &CDynamics2DCustomFootBotModel::UpdatePerspectiveCameraAnchor);
+         RegisterAnchorMethod<CDynamics2DCustomFootBotModel>(
+            GetEmbodiedEntity().GetAnchor("perspective_camera_right"),
+            &CDynamics2DCustomFootBotModel::UpdatePerspectiveCameraAnchor);
+         RegisterAnchorMethod<CDynamics2DCustomFootBotModel>(
+            GetEmbodiedEntity().GetAnchor("perspective_camera_front"),
+            &CDynamics2DCustomFootBotModel::UpdatePerspectiveCameraAnchor);
+         RegisterAnchorMethod<CDynamics2DCustomFootBotModel>(
+            GetEmbodiedEntity().GetAnchor("perspective_camera_back"),
+            &CDynamics2DCustomFootBotModel::UpdatePerspectiveCameraAnchor);
+      }
       /* Create the actual body with initial position and orientation */
       m_ptActualBaseBody =
          cpSpaceAddBody(GetDynamics2DEngine().GetPhysicsSpace(),
@@ -378,7 +395,48 @@ namespace argos {
    /****************************************/
    /****************************************/
 
-   REGISTER_STANDARD_DYNAMICS2D_OPERATIONS_ON_ENTITY(CCustomFootBotEntity, CDynamics2DCustomFootBotModel);
+   /*
+    * Same as REGISTER_STANDARD_DYNAMICS2D_OPERATIONS_ON_ENTITY, but robots
+    * without gripper or turret get the single body model, which has no
+    * gripper body and constraints to solve.
+    */
+   class CDynamics2DOperationAddCustomFootBot : public CDynamics2DOperationAddEntity {
+   public:
+      virtual ~CDynamics2DOperationAddCustomFootBot() {}
+      SOperationOutcome ApplyTo(CDynamics2DEngine& c_engine,
+                                CCustomFootBotEntity& c_entity) {
+         CDynamics2DModel* pcModel;
+         if(c_entity.HasComponents(CCustomFootBotEntity::COMPONENT_GRIPPER |
+                                   CCustomFootBotEntity::COMPONENT_TURRET)) {
+            pcModel = new CDynamics2DCustomFootBotModel(c_engine, c_entity);
+         }
+         else {
+            pcModel = new CDynamics2DCustomFootBotSingleBodyModel(c_engine, c_entity);
+         }
+         c_engine.AddPhysicsModel(c_entity.GetId(), *pcModel);
+         c_entity.GetEmbodiedEntity().AddPhysicsModel(c_engine.GetId(), *pcModel);
+         return SOperationOutcome(true);
+      }
+   };
+
+   class CDynamics2DOperationRemoveCustomFootBot : public CDynamics2DOperationRemoveEntity {
+   public:
+      virtual ~CDynamics2DOperationRemoveCustomFootBot() {}
+      SOperationOutcome ApplyTo(CDynamics2DEngine& c_engine,
+                                CCustomFootBotEntity& c_entity) {
+         c_engine.RemovePhysicsModel(c_entity.GetId());
+         c_entity.GetEmbodiedEntity().RemovePhysicsModel(c_engine.GetId());
+         return SOperationOutcome(true);
+      }
+   };
+
+   REGISTER_DYNAMICS2D_OPERATION(CDynamics2DOperationAddEntity,
+                                 CDynamics2DOperationAddCustomFootBot,
+                                 CCustomFootBotEntity);
+
+   REGISTER_DYNAMICS2D_OPERATION(CDynamics2DOperationRemoveEntity,
+                                 CDynamics2DOperationRemoveCustomFootBot,
+                                 CCustomFootBotEntity);
 
    /****************************************/
    /****************************************/
@@ -0,0 +1,140 @@
+/**
+ * @file dynamics2d_footbot_single_body_model.cpp
+ *
+ * Based on dynamics2d_footbot_model.cpp and dynamics2d_epuck_model.cpp
+ */
+
+#include "dynamics2d_footbot_single_body_model.h"
+#include <argos3/plugins/simulator/physics_engines/dynamics2d/dynamics2d_engine.h>
+
+namespace argos {
+
+   /****************************************/
+   /****************************************/
+
+   static const Real FOOTBOT_RADIUS                   = 0.085036758f;
+   static const Real FOOTBOT_INTERWHEEL_DISTANCE      = 0.14f;
+   static const Real FOOTBOT_HEIGHT                   = 0.146899733f;
+   static const Real FOOTBOT_MASS                     = 1.6f;
+
+   static const Real FOOTBOT_MAX_FORCE                = 15.f;
+   static const Real FOOTBOT_MAX_TORQUE               = 150.f;
+
+   enum FOOTBOT_WHEELS {
+      FOOTBOT_LEFT_WHEEL = 0,
+      FOOTBOT_RIGHT_WHEEL = 1
+   };
+
+   /****************************************/
+   /****************************************/
+
+   CDynamics2DCustomFootBotSingleBodyModel::CDynamics2DCustomFootBotSingleBodyModel(CDynamics2DEngine& c_engine,
+                                                                                    CCustomFootBotEntity& c_entity) :
+      CDynamics2DSingleBodyObjectModel(c_engine, c_entity),
+      m_cFootBotEntity(c_entity),
+      m_cWheeledEntity(m_cFootBotEntity.GetWheeledEntity()),
+      m_cDiffSteering(c_engine,
+                      FOOTBOT_MAX_FORCE,
+                      FOOTBOT_MAX_TORQUE,
+                      FOOTBOT_INTERWHEEL_DISTANCE),
+      m_fCurrentWheelVelocity(m_cWheeledEntity.GetWheelVelocities()) {
+      /* The LEDs are attached to the turret anchor, which stays still on the body */
+      RegisterAnchorMethod<CDynamics2DCustomFootBotSingleBodyModel>(
+         GetEmbodiedEntity().GetAnchor("turret"),
+         &CDynamics2DCustomFootBotSingleBodyModel::UpdateTurretAnchor);
+      if(m_cFootBotEntity.HasComponents(CCustomFootBotEntity::COMPONENT_PERSPECTIVE_CAMERAS)) {
+         RegisterAnchorMethod<CDynamics2DCustomFootBotSingleBodyModel>(
+            GetEmbodiedEntity().GetAnchor("perspective_camera_left"),
+            &CDynamics2DCustomFootBotSingleBodyModel::UpdatePerspectiveCameraAnchor);
+         RegisterAnchorMethod<CDynamics2DCustomFootBotSingleBodyModel>(
+            GetEmbodiedEntity().GetAnchor("perspective_camera_right"),
+            &CDynamics2DCustomFootBotSingleBodyModel::UpdatePerspectiveCameraAnchor);
+         RegisterAnchorMethod<CDynamics2DCustomFootBotSingleBodyModel>(
+            GetEmbodiedEntity().GetAnchor("perspective_camera_front"),
+            &CDynamics2DCustomFootBotSingleBodyModel::UpdatePerspectiveCameraAnchor);
+         RegisterAnchorMethod<CDynamics2DCustomFootBotSingleBodyModel>(
+            GetEmbodiedEntity().GetAnchor("perspective_camera_back"),
+            &CDynamics2DCustomFootBotSingleBodyModel::UpdatePerspectiveCameraAnchor);
+      }
+      /* Create the body with initial position and orientation */
+      cpBody* ptBody =
+         cpSpaceAddBody(GetDynamics2DEngine().GetPhysicsSpace(),
+                        cpBodyNew(FOOTBOT_MASS,
+                                  cpMomentForCircle(FOOTBOT_MASS,
+                                                    0.0f,
+                                                    FOOTBOT_RADIUS + FOOTBOT_RADIUS,
+                                                    cpvzero)));
+      const CVector3& cPosition = GetEmbodiedEntity().GetOriginAnchor().Position;
+      ptBody->p = cpv(cPosition.GetX(), cPosition.GetY());
+      CRadians cXAngle, cYAngle, cZAngle;
+      GetEmbodiedEntity().GetOriginAnchor().Orientation.ToEulerAngles(cZAngle, cYAngle, cXAngle);
+      cpBodySetAngle(ptBody, cZAngle.GetValue());
+      /* Create the body shape */
+      cpShape* ptShape =
+         cpSpaceAddShape(GetDynamics2DEngine().GetPhysicsSpace(),
+                         cpCircleShapeNew(ptBody,
+                                          FOOTBOT_RADIUS,
+                                          cpvzero));
+      ptShape->e = 0.0; // No elasticity
+      ptShape->u = 0.7; // Lots of friction
+      /* Constrain the body to follow the diff steering control */
+      m_cDiffSteering.AttachTo(ptBody);
+      /* Set the body so that the default methods work as expected */
+      SetBody(ptBody, FOOTBOT_HEIGHT);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   CDynamics2DCustomFootBotSingleBodyModel::~CDynamics2DCustomFootBotSingleBodyModel() {
+      m_cDiffSteering.Detach();
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CDynamics2DCustomFootBotSingleBodyModel::Reset() {
+      CDynamics2DSingleBodyObjectModel::Reset();
+      m_cDiffSteering.Reset();
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CDynamics2DCustomFootBotSingleBodyModel::UpdateFromEntityStatus() {
+      /* Do we want to move? */
+      if((m_fCurrentWheelVelocity[FOOTBOT_LEFT_WHEEL] != 0.0f) ||
+         (m_fCurrentWheelVelocity[FOOTBOT_RIGHT_WHEEL] != 0.0f)) {
+         m_cDiffSteering.SetWheelVelocity(m_fCurrentWheelVelocity[FOOTBOT_LEFT_WHEEL],
+                                          m_fCurrentWheelVelocity[FOOTBOT_RIGHT_WHEEL]);
+      }
+      else {
+         /* No, we don't want to move - zero all speeds */
+         m_cDiffSteering.Reset();
+      }
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CDynamics2DCustomFootBotSingleBodyModel::UpdateTurretAnchor(SAnchor& s_anchor) {
+      s_anchor.Position.SetX(GetBody()->p.x);
+      s_anchor.Position.SetY(GetBody()->p.y);
+      s_anchor.Orientation.FromAngleAxis(CRadians(GetBody()->a), CVector3::Z);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CDynamics2DCustomFootBotSingleBodyModel::UpdatePerspectiveCameraAnchor(SAnchor& s_anchor) {
+      s_anchor.Position.SetX(GetBody()->p.x + s_anchor.OffsetPosition.GetX());
+      s_anchor.Position.SetY(GetBody()->p.y + s_anchor.OffsetPosition.GetY());
+      s_anchor.Orientation =
+         s_anchor.OffsetOrientation *
+         CQuaternion(CRadians(GetBody()->a), CVector3::Z);
+   }
+
+   /****************************************/
+   /****************************************/
+
+}
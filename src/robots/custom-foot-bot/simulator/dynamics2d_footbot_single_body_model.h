@@ -0,0 +1,47 @@
+/**
+ * @file dynamics2d_footbot_single_body_model.h
+ *
+ * Lightweight dynamics2d model of the custom foot-bot, used when the robot has
+ * no gripper or no turret. It is a single circle body driven by differential
+ * steering, without the gripper body and its constraints.
+ */
+
+#ifndef DYNAMICS2D_FOOTBOT_SINGLE_BODY_MODEL_H
+#define DYNAMICS2D_FOOTBOT_SINGLE_BODY_MODEL_H
+
+#include <argos3/plugins/simulator/physics_engines/dynamics2d/dynamics2d_single_body_object_model.h>
+#include <argos3/plugins/simulator/physics_engines/dynamics2d/dynamics2d_differentialsteering_control.h>
+#include "footbot_entity.h"
+
+namespace argos {
+
+   class CDynamics2DCustomFootBotSingleBodyModel : public CDynamics2DSingleBodyObjectModel {
+
+   public:
+
+      CDynamics2DCustomFootBotSingleBodyModel(CDynamics2DEngine& c_engine,
+                                              CCustomFootBotEntity& c_entity);
+      virtual ~CDynamics2DCustomFootBotSingleBodyModel();
+
+      virtual void Reset();
+
+      virtual void UpdateFromEntityStatus();
+
+      void UpdateTurretAnchor(SAnchor& s_anchor);
+
+      void UpdatePerspectiveCameraAnchor(SAnchor& s_anchor);
+
+   private:
+
+      CCustomFootBotEntity& m_cFootBotEntity;
+      CWheeledEntity&       m_cWheeledEntity;
+
+      CDynamics2DDifferentialSteeringControl m_cDiffSteering;
+
+      const Real* m_fCurrentWheelVelocity;
+
+   };
+
+}
+
+#endif
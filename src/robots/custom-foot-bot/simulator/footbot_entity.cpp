@@ -7,6 +7,7 @@
 #include "footbot_entity.h"
 
 #include <argos3/core/utility/math/matrix/rotationmatrix3.h>
+#include <argos3/core/utility/string_utilities.h>
 #include <argos3/core/simulator/space/space.h>
 #include <argos3/core/simulator/entity/controllable_entity.h>
 #include <argos3/core/simulator/entity/embodied_entity.h>
@@ -90,6 +91,54 @@ static const int PERSPECTIVE_CAMERA_WIDHT  = 900;
 /****************************************/
 /****************************************/
 
+/* Names of the optional components in the 'components' attribute */
+static const struct {
+    const char* Name;
+    UInt32 Flag;
+} COMPONENT_NAMES[] = {
+    { "leds",                   CCustomFootBotEntity::COMPONENT_LEDS },
+    { "proximity",              CCustomFootBotEntity::COMPONENT_PROXIMITY },
+    { "light",                  CCustomFootBotEntity::COMPONENT_LIGHT },
+    { "gripper",                CCustomFootBotEntity::COMPONENT_GRIPPER },
+    { "ground",                 CCustomFootBotEntity::COMPONENT_GROUND },
+    { "distance_scanner",       CCustomFootBotEntity::COMPONENT_DISTANCE_SCANNER },
+    { "rab",                    CCustomFootBotEntity::COMPONENT_RAB },
+    { "omnidirectional_camera", CCustomFootBotEntity::COMPONENT_OMNIDIRECTIONAL_CAMERA },
+    { "perspective_cameras",    CCustomFootBotEntity::COMPONENT_PERSPECTIVE_CAMERAS },
+    { "turret",                 CCustomFootBotEntity::COMPONENT_TURRET },
+    { "wifi",                   CCustomFootBotEntity::COMPONENT_WIFI },
+    { "all",                    CCustomFootBotEntity::COMPONENTS_ALL }
+};
+
+/****************************************/
+/****************************************/
+
+UInt32 CCustomFootBotEntity::ParseComponents(const std::string& str_components) {
+    std::vector<std::string> vecNames;
+    Tokenize(str_components, vecNames, ", ");
+    UInt32 unComponents = 0;
+    for(const std::string& strName : vecNames) {
+        bool bFound = false;
+        for(const auto& sComponent : COMPONENT_NAMES) {
+            if(strName == sComponent.Name) {
+                unComponents |= sComponent.Flag;
+                bFound = true;
+                break;
+            }
+        }
+        if(!bFound) {
+            std::string strValid;
+            for(const auto& sComponent : COMPONENT_NAMES)
+                strValid += std::string(strValid.empty() ? "" : ", ") + sComponent.Name;
+            THROW_ARGOSEXCEPTION("Unknown foot-bot component \"" << strName << "\", valid ones are: " << strValid);
+        }
+    }
+    return unComponents;
+}
+
+/****************************************/
+/****************************************/
+
 CCustomFootBotEntity::CCustomFootBotEntity() :
     CComposableEntity(NULL),
     m_pcControllableEntity(NULL),
@@ -108,7 +157,8 @@ CCustomFootBotEntity::CCustomFootBotEntity() :
     m_pcProximitySensorEquippedEntity(NULL),
     m_pcRABEquippedEntity(NULL),
     m_pcWheeledEntity(NULL),
-    m_pcWiFiEquippedEntity(NULL) {
+    m_pcWiFiEquippedEntity(NULL),
+    m_unComponents(COMPONENTS_ALL) {
 }
 
 /****************************************/
@@ -123,7 +173,8 @@ CCustomFootBotEntity::CCustomFootBotEntity(const std::string& str_id,
                                            const CRadians& c_omnicam_aperture,
                                            const CRadians& c_perspcam_aperture,
                                            Real f_perspcam_focal_length,
-                                           Real f_perspcam_range) :
+                                           Real f_perspcam_range,
+                                           UInt32 un_components) :
     CComposableEntity(NULL, str_id),
     m_pcControllableEntity(NULL),
     m_pcDistanceScannerEquippedEntity(NULL),
@@ -141,7 +192,8 @@ CCustomFootBotEntity::CCustomFootBotEntity(const std::string& str_id,
     m_pcProximitySensorEquippedEntity(NULL),
     m_pcRABEquippedEntity(NULL),
     m_pcWheeledEntity(NULL),
-    m_pcWiFiEquippedEntity(NULL) {
+    m_pcWiFiEquippedEntity(NULL),
+    m_unComponents(un_components) {
     try {
         /*
          * Create and init components
@@ -152,175 +204,12 @@ CCustomFootBotEntity::CCustomFootBotEntity(const std::string& str_id,
          */
         m_pcEmbodiedEntity = new CEmbodiedEntity(this, "body_0", c_position, c_orientation);
         AddComponent(*m_pcEmbodiedEntity);
-        SAnchor& cTurretAnchor = m_pcEmbodiedEntity->AddAnchor("turret");
-        SAnchor& cPerspLeftCamAnchor = m_pcEmbodiedEntity->AddAnchor("perspective_camera_left",
-                                                                     CVector3(0.0, 0.0, BEACON_ELEVATION),
-                                                                     CQuaternion(CRadians::PI_OVER_TWO, CVector3::Z));
-        SAnchor& cPerspRightCamAnchor = m_pcEmbodiedEntity->AddAnchor("perspective_camera_right",
-                                                                      CVector3(0.0, 0.0, BEACON_ELEVATION),
-                                                                      CQuaternion(-CRadians::PI_OVER_TWO, CVector3::Z));
-        SAnchor& cPerspFrontCamAnchor = m_pcEmbodiedEntity->AddAnchor("perspective_camera_front",
-                                                                      CVector3(0.0, 0.0, BEACON_ELEVATION),
-                                                                      CQuaternion(CRadians::ZERO, CVector3::Z));
-        SAnchor& cPerspBackCamAnchor = m_pcEmbodiedEntity->AddAnchor("perspective_camera_back",
-                                                                      CVector3(0.0, 0.0, BEACON_ELEVATION),
-                                                                      CQuaternion(-CRadians::PI, CVector3::Z));
-        /* Wheeled entity and wheel positions (left, right) */
-        m_pcWheeledEntity = new CWheeledEntity(this, "wheels_0", 2);
-        AddComponent(*m_pcWheeledEntity);
-        m_pcWheeledEntity->SetWheel(0, CVector3(0.0f,  HALF_INTERWHEEL_DISTANCE, 0.0f), WHEEL_RADIUS);
-        m_pcWheeledEntity->SetWheel(1, CVector3(0.0f, -HALF_INTERWHEEL_DISTANCE, 0.0f), WHEEL_RADIUS);
-        /* LED equipped entity, with LEDs [0-11] and beacon [12] */
-        m_pcLEDEquippedEntity = new CLEDEquippedEntity(this, "leds_0");
-        AddComponent(*m_pcLEDEquippedEntity);
-        m_pcLEDEquippedEntity->AddLEDRing(
-            CVector3(0.0f, 0.0f, LED_RING_ELEVATION),
-            LED_RING_RADIUS,
-            HALF_LED_ANGLE_SLICE,
-            12,
-            cTurretAnchor);
-        m_pcLEDEquippedEntity->AddLED(
-            CVector3(0.0f, 0.0f, BEACON_ELEVATION),
-            cTurretAnchor);
-        /* Proximity sensor equipped entity */
-        m_pcProximitySensorEquippedEntity =
-            new CProximitySensorEquippedEntity(this, "proximity_0");
-        AddComponent(*m_pcProximitySensorEquippedEntity);
-        m_pcProximitySensorEquippedEntity->AddSensorRing(
-            CVector3(0.0f, 0.0f, PROXIMITY_SENSOR_RING_ELEVATION),
-            PROXIMITY_SENSOR_RING_RADIUS,
-            PROXIMITY_SENSOR_RING_START_ANGLE,
-            PROXIMITY_SENSOR_RING_RANGE,
-            24,
-            m_pcEmbodiedEntity->GetOriginAnchor());
-        /* Light sensor equipped entity */
-        m_pcLightSensorEquippedEntity =
-            new CLightSensorEquippedEntity(this, "light_0");
-        AddComponent(*m_pcLightSensorEquippedEntity);
-        m_pcLightSensorEquippedEntity->AddSensorRing(
-            CVector3(0.0f, 0.0f, PROXIMITY_SENSOR_RING_ELEVATION),
-            PROXIMITY_SENSOR_RING_RADIUS,
-            PROXIMITY_SENSOR_RING_START_ANGLE,
-            PROXIMITY_SENSOR_RING_RANGE,
-            24,
-            m_pcEmbodiedEntity->GetOriginAnchor());
-        /* Gripper equipped entity */
-        m_pcGripperEquippedEntity =
-            new CGripperEquippedEntity(this,
-                                       "gripper_0",
-                                       CVector3(BODY_RADIUS, 0.0f, GRIPPER_ELEVATION),
-                                       CVector3::X);
-        AddComponent(*m_pcGripperEquippedEntity);
-        /* Ground sensor equipped entity */
-        m_pcGroundSensorEquippedEntity =
-            new CGroundSensorEquippedEntity(this, "ground_0");
-        AddComponent(*m_pcGroundSensorEquippedEntity);
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(0.063, 0.0116),
-                                                  CGroundSensorEquippedEntity::TYPE_GRAYSCALE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(-0.063, 0.0116),
-                                                  CGroundSensorEquippedEntity::TYPE_GRAYSCALE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(-0.063, -0.0116),
-                                                  CGroundSensorEquippedEntity::TYPE_GRAYSCALE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(0.063, -0.0116),
-                                                  CGroundSensorEquippedEntity::TYPE_GRAYSCALE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(0.08, 0.0),
-                                                  CGroundSensorEquippedEntity::TYPE_BLACK_WHITE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(0.042, 0.065),
-                                                  CGroundSensorEquippedEntity::TYPE_BLACK_WHITE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(0.0, 0.08),
-                                                  CGroundSensorEquippedEntity::TYPE_BLACK_WHITE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(-0.042, 0.065),
-                                                  CGroundSensorEquippedEntity::TYPE_BLACK_WHITE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(-0.08, 0.0),
-                                                  CGroundSensorEquippedEntity::TYPE_BLACK_WHITE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(-0.042, -0.065),
-                                                  CGroundSensorEquippedEntity::TYPE_BLACK_WHITE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(0.0, -0.08),
-                                                  CGroundSensorEquippedEntity::TYPE_BLACK_WHITE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        m_pcGroundSensorEquippedEntity->AddSensor(CVector2(0.042, -0.065),
-                                                  CGroundSensorEquippedEntity::TYPE_BLACK_WHITE,
-                                                  m_pcEmbodiedEntity->GetOriginAnchor());
-        /* Distance scanner */
-        m_pcDistanceScannerEquippedEntity =
-            new CFootBotDistanceScannerEquippedEntity(this, "distance_scanner_0");
-        AddComponent(*m_pcDistanceScannerEquippedEntity);
-        /* RAB equipped entity */
-        m_pcRABEquippedEntity =
-            new CRABEquippedEntity(this,
-                                   "rab_0",
-                                   un_rab_data_size,
-                                   f_rab_range,
-                                   m_pcEmbodiedEntity->GetOriginAnchor(),
-                                   *m_pcEmbodiedEntity,
-                                   CVector3(0.0f, 0.0f, RAB_ELEVATION));
-        AddComponent(*m_pcRABEquippedEntity);
-        /* Omnidirectional camera equipped entity */
-        m_pcOmnidirectionalCameraEquippedEntity =
-            new COmnidirectionalCameraEquippedEntity(this,
-                                                     "omnidirectional_camera_0",
-                                                     c_omnicam_aperture,
-                                                     CVector3(0.0f,
-                                                              0.0f,
-                                                              OMNIDIRECTIONAL_CAMERA_ELEVATION));
-        AddComponent(*m_pcOmnidirectionalCameraEquippedEntity);
-        /* Perspective camera equipped entity */
-        m_pcLeftPerspectiveCameraEquippedEntity =
-            new PerspectiveCameraLeft(this,
-                                      "perspective_camera_left_0",
-                                      c_perspcam_aperture,
-                                      f_perspcam_focal_length,
-                                      f_perspcam_range,
-                                      PERSPECTIVE_CAMERA_WIDHT,
-                                      PERSPECTIVE_CAMERA_HEIGHT,
-                                      cPerspLeftCamAnchor);
-        m_pcRightPerspectiveCameraEquippedEntity =
-            new PerspectiveCameraRight(this,
-                                       "perspective_camera_right_0",
-                                       c_perspcam_aperture,
-                                       f_perspcam_focal_length,
-                                       f_perspcam_range,
-                                       PERSPECTIVE_CAMERA_WIDHT,
-                                       PERSPECTIVE_CAMERA_HEIGHT,
-                                       cPerspRightCamAnchor);
-        m_pcFrontPerspectiveCameraEquippedEntity =
-            new PerspectiveCameraFront(this,
-                                       "perspective_camera_front_0",
-                                       c_perspcam_aperture,
-                                       f_perspcam_focal_length,
-                                       f_perspcam_range,
-                                       PERSPECTIVE_CAMERA_WIDHT,
-                                       PERSPECTIVE_CAMERA_HEIGHT,
-                                       cPerspFrontCamAnchor);
-        m_pcBackPerspectiveCameraEquippedEntity =
-            new PerspectiveCameraBack(this,
-                                       "perspective_camera_back_0",
-                                       c_perspcam_aperture,
-                                       f_perspcam_focal_length,
-                                       f_perspcam_range,
-                                       PERSPECTIVE_CAMERA_WIDHT,
-                                       PERSPECTIVE_CAMERA_HEIGHT,
-                                       cPerspBackCamAnchor);
-        AddComponent(*m_pcLeftPerspectiveCameraEquippedEntity);
-        AddComponent(*m_pcRightPerspectiveCameraEquippedEntity);
-        AddComponent(*m_pcFrontPerspectiveCameraEquippedEntity);
-        AddComponent(*m_pcBackPerspectiveCameraEquippedEntity);
-        /* Turret equipped entity */
-        m_pcTurretEntity = new CFootBotTurretEntity(this, "turret_0", cTurretAnchor);
-        AddComponent(*m_pcTurretEntity);
-        /* WiFi equipped entity */
-        m_pcWiFiEquippedEntity = new CWiFiEquippedEntity(this, "wifi_0");
-        AddComponent(*m_pcWiFiEquippedEntity);
+        CreateComponents(f_rab_range,
+                         un_rab_data_size,
+                         c_omnicam_aperture,
+                         c_perspcam_aperture,
+                         f_perspcam_focal_length,
+                         f_perspcam_range);
         /* Controllable entity
            It must be the last one, for actuators/sensors to link to composing entities correctly */
         m_pcControllableEntity = new CControllableEntity(this, "controller_0");
@@ -343,6 +232,24 @@ void CCustomFootBotEntity::Init(TConfigurationNode& t_tree) {
          * Init parent
          */
         CComposableEntity::Init(t_tree);
+        /*
+         * Read the optional parameters
+         */
+        std::string strComponents = "all";
+        GetNodeAttributeOrDefault(t_tree, "components", strComponents, strComponents);
+        m_unComponents = ParseComponents(strComponents);
+        Real fRange = 3.0f;
+        GetNodeAttributeOrDefault(t_tree, "rab_range", fRange, fRange);
+        UInt32 unDataSize = 10;
+        GetNodeAttributeOrDefault(t_tree, "rab_data_size", unDataSize, unDataSize);
+        CDegrees cOmnicamAperture(70.0f);
+        GetNodeAttributeOrDefault(t_tree, "omnidirectional_camera_aperture", cOmnicamAperture, cOmnicamAperture);
+        Real fPerspCamFocalLength = 0.035;
+        GetNodeAttributeOrDefault(t_tree, "perspective_camera_focal_length", fPerspCamFocalLength, fPerspCamFocalLength);
+        Real fPerspCamRange = 2.0;
+        GetNodeAttributeOrDefault(t_tree, "perspective_camera_range", fPerspCamRange, fPerspCamRange);
+        CDegrees cPerspCamAperture(30.0f);
+        GetNodeAttributeOrDefault(t_tree, "perspective_camera_aperture", cPerspCamAperture, cPerspCamAperture);
         /*
          * Create and init components
          */
@@ -353,13 +260,43 @@ void CCustomFootBotEntity::Init(TConfigurationNode& t_tree) {
         m_pcEmbodiedEntity = new CEmbodiedEntity(this);
         AddComponent(*m_pcEmbodiedEntity);
         m_pcEmbodiedEntity->Init(GetNode(t_tree, "body"));
-        SAnchor& cTurretAnchor = m_pcEmbodiedEntity->AddAnchor("turret");
-        /* Wheeled entity and wheel positions (left, right) */
-        m_pcWheeledEntity = new CWheeledEntity(this, "wheels_0", 2);
-        AddComponent(*m_pcWheeledEntity);
-        m_pcWheeledEntity->SetWheel(0, CVector3(0.0f,  HALF_INTERWHEEL_DISTANCE, 0.0f), WHEEL_RADIUS);
-        m_pcWheeledEntity->SetWheel(1, CVector3(0.0f, -HALF_INTERWHEEL_DISTANCE, 0.0f), WHEEL_RADIUS);
-        /* LED equipped entity, with LEDs [0-11] and beacon [12] */
+        CreateComponents(fRange,
+                         unDataSize,
+                         ToRadians(cOmnicamAperture),
+                         ToRadians(cPerspCamAperture),
+                         fPerspCamFocalLength,
+                         fPerspCamRange);
+        /* Controllable entity
+           It must be the last one, for actuators/sensors to link to composing entities correctly */
+        m_pcControllableEntity = new CControllableEntity(this);
+        AddComponent(*m_pcControllableEntity);
+        m_pcControllableEntity->Init(GetNode(t_tree, "controller"));
+        /* Update components */
+        UpdateComponents();
+    }
+    catch(CARGoSException& ex) {
+        THROW_ARGOSEXCEPTION_NESTED("Failed to initialize entity \"" << GetId() << "\".", ex);
+    }
+}
+
+/****************************************/
+/****************************************/
+
+void CCustomFootBotEntity::CreateComponents(Real f_rab_range,
+                                            size_t un_rab_data_size,
+                                            const CRadians& c_omnicam_aperture,
+                                            const CRadians& c_perspcam_aperture,
+                                            Real f_perspcam_focal_length,
+                                            Real f_perspcam_range) {
+    /* The LEDs turn with the turret, so the anchor is there even without the turret entity */
+    SAnchor& cTurretAnchor = m_pcEmbodiedEntity->AddAnchor("turret");
+    /* Wheeled entity and wheel positions (left, right) */
+    m_pcWheeledEntity = new CWheeledEntity(this, "wheels_0", 2);
+    AddComponent(*m_pcWheeledEntity);
+    m_pcWheeledEntity->SetWheel(0, CVector3(0.0f,  HALF_INTERWHEEL_DISTANCE, 0.0f), WHEEL_RADIUS);
+    m_pcWheeledEntity->SetWheel(1, CVector3(0.0f, -HALF_INTERWHEEL_DISTANCE, 0.0f), WHEEL_RADIUS);
+    /* LED equipped entity, with LEDs [0-11] and beacon [12] */
+    if(HasComponents(COMPONENT_LEDS)) {
         m_pcLEDEquippedEntity = new CLEDEquippedEntity(this, "leds_0");
         AddComponent(*m_pcLEDEquippedEntity);
         m_pcLEDEquippedEntity->AddLEDRing(
@@ -371,7 +308,9 @@ void CCustomFootBotEntity::Init(TConfigurationNode& t_tree) {
         m_pcLEDEquippedEntity->AddLED(
             CVector3(0.0f, 0.0f, BEACON_ELEVATION),
             cTurretAnchor);
-        /* Proximity sensor equipped entity */
+    }
+    /* Proximity sensor equipped entity */
+    if(HasComponents(COMPONENT_PROXIMITY)) {
         m_pcProximitySensorEquippedEntity =
             new CProximitySensorEquippedEntity(this, "proximity_0");
         AddComponent(*m_pcProximitySensorEquippedEntity);
@@ -382,7 +321,9 @@ void CCustomFootBotEntity::Init(TConfigurationNode& t_tree) {
             PROXIMITY_SENSOR_RING_RANGE,
             24,
             m_pcEmbodiedEntity->GetOriginAnchor());
-        /* Light sensor equipped entity */
+    }
+    /* Light sensor equipped entity */
+    if(HasComponents(COMPONENT_LIGHT)) {
         m_pcLightSensorEquippedEntity =
             new CLightSensorEquippedEntity(this, "light_0");
         AddComponent(*m_pcLightSensorEquippedEntity);
@@ -393,14 +334,18 @@ void CCustomFootBotEntity::Init(TConfigurationNode& t_tree) {
             PROXIMITY_SENSOR_RING_RANGE,
             24,
             m_pcEmbodiedEntity->GetOriginAnchor());
-        /* Gripper equipped entity */
+    }
+    /* Gripper equipped entity */
+    if(HasComponents(COMPONENT_GRIPPER)) {
         m_pcGripperEquippedEntity =
             new CGripperEquippedEntity(this,
                                        "gripper_0",
                                        CVector3(BODY_RADIUS, 0.0f, GRIPPER_ELEVATION),
                                        CVector3::X);
         AddComponent(*m_pcGripperEquippedEntity);
-        /* Ground sensor equipped entity */
+    }
+    /* Ground sensor equipped entity */
+    if(HasComponents(COMPONENT_GROUND)) {
         m_pcGroundSensorEquippedEntity =
             new CGroundSensorEquippedEntity(this, "ground_0");
         AddComponent(*m_pcGroundSensorEquippedEntity);
@@ -440,42 +385,38 @@ void CCustomFootBotEntity::Init(TConfigurationNode& t_tree) {
         m_pcGroundSensorEquippedEntity->AddSensor(CVector2(0.042, -0.065),
                                                   CGroundSensorEquippedEntity::TYPE_BLACK_WHITE,
                                                   m_pcEmbodiedEntity->GetOriginAnchor());
-        /* Distance scanner */
+    }
+    /* Distance scanner */
+    if(HasComponents(COMPONENT_DISTANCE_SCANNER)) {
         m_pcDistanceScannerEquippedEntity =
             new CFootBotDistanceScannerEquippedEntity(this, "distance_scanner_0");
         AddComponent(*m_pcDistanceScannerEquippedEntity);
-        /* RAB equipped entity */
-        Real fRange = 3.0f;
-        GetNodeAttributeOrDefault(t_tree, "rab_range", fRange, fRange);
-        UInt32 unDataSize = 10;
-        GetNodeAttributeOrDefault(t_tree, "rab_data_size", unDataSize, unDataSize);
+    }
+    /* RAB equipped entity */
+    if(HasComponents(COMPONENT_RAB)) {
         m_pcRABEquippedEntity =
             new CRABEquippedEntity(this,
                                    "rab_0",
-                                   unDataSize,
-                                   fRange,
+                                   un_rab_data_size,
+                                   f_rab_range,
                                    m_pcEmbodiedEntity->GetOriginAnchor(),
                                    *m_pcEmbodiedEntity,
                                    CVector3(0.0f, 0.0f, RAB_ELEVATION));
         AddComponent(*m_pcRABEquippedEntity);
-        /* Omnidirectional camera equipped entity */
-        CDegrees cAperture(70.0f);
-        GetNodeAttributeOrDefault(t_tree, "omnidirectional_camera_aperture", cAperture, cAperture);
+    }
+    /* Omnidirectional camera equipped entity */
+    if(HasComponents(COMPONENT_OMNIDIRECTIONAL_CAMERA)) {
         m_pcOmnidirectionalCameraEquippedEntity =
             new COmnidirectionalCameraEquippedEntity(this,
                                                      "omnidirectional_camera_0",
-                                                     ToRadians(cAperture),
+                                                     c_omnicam_aperture,
                                                      CVector3(0.0f,
                                                               0.0f,
                                                               OMNIDIRECTIONAL_CAMERA_ELEVATION));
         AddComponent(*m_pcOmnidirectionalCameraEquippedEntity);
-        /* Perspective camera equipped entity */
-        Real fPerspCamFocalLength = 0.035;
-        GetNodeAttributeOrDefault(t_tree, "perspective_camera_focal_length", fPerspCamFocalLength, fPerspCamFocalLength);
-        Real fPerspCamRange = 2.0;
-        GetNodeAttributeOrDefault(t_tree, "perspective_camera_range", fPerspCamRange, fPerspCamRange);
-        cAperture.SetValue(30.0f);
-        GetNodeAttributeOrDefault(t_tree, "perspective_camera_aperture", cAperture, cAperture);
+    }
+    /* Perspective camera equipped entities, their anchors exist only with them */
+    if(HasComponents(COMPONENT_PERSPECTIVE_CAMERAS)) {
         SAnchor& cPerspLeftCamAnchor = m_pcEmbodiedEntity->AddAnchor("perspective_camera_left",
                                                                      CVector3(0.0, 0.0, BEACON_ELEVATION),
                                                                      CQuaternion(CRadians::PI_OVER_TWO, CVector3::Z));
@@ -486,65 +427,58 @@ void CCustomFootBotEntity::Init(TConfigurationNode& t_tree) {
                                                                       CVector3(0.0, 0.0, BEACON_ELEVATION),
                                                                       CQuaternion(CRadians::ZERO, CVector3::Z));
         SAnchor& cPerspBackCamAnchor = m_pcEmbodiedEntity->AddAnchor("perspective_camera_back",
-                                                                      CVector3(0.0, 0.0, BEACON_ELEVATION),
-                                                                      CQuaternion(-CRadians::PI, CVector3::Z));
-
+                                                                     CVector3(0.0, 0.0, BEACON_ELEVATION),
+                                                                     CQuaternion(-CRadians::PI, CVector3::Z));
         m_pcLeftPerspectiveCameraEquippedEntity =
             new PerspectiveCameraLeft(this,
                                       "perspective_camera_left_0",
-                                      ToRadians(cAperture),
-                                      fPerspCamFocalLength,
-                                      fPerspCamRange,
+                                      c_perspcam_aperture,
+                                      f_perspcam_focal_length,
+                                      f_perspcam_range,
                                       PERSPECTIVE_CAMERA_WIDHT,
                                       PERSPECTIVE_CAMERA_HEIGHT,
                                       cPerspLeftCamAnchor);
         m_pcRightPerspectiveCameraEquippedEntity =
             new PerspectiveCameraRight(this,
                                        "perspective_camera_right_0",
-                                       ToRadians(cAperture),
-                                       fPerspCamFocalLength,
-                                       fPerspCamRange,
+                                       c_perspcam_aperture,
+                                       f_perspcam_focal_length,
+                                       f_perspcam_range,
                                        PERSPECTIVE_CAMERA_WIDHT,
                                        PERSPECTIVE_CAMERA_HEIGHT,
                                        cPerspRightCamAnchor);
         m_pcFrontPerspectiveCameraEquippedEntity =
             new PerspectiveCameraFront(this,
                                        "perspective_camera_front_0",
-                                       ToRadians(cAperture),
-                                       fPerspCamFocalLength,
-                                       fPerspCamRange,
+                                       c_perspcam_aperture,
+                                       f_perspcam_focal_length,
+                                       f_perspcam_range,
                                        PERSPECTIVE_CAMERA_WIDHT,
                                        PERSPECTIVE_CAMERA_HEIGHT,
                                        cPerspFrontCamAnchor);
         m_pcBackPerspectiveCameraEquippedEntity =
             new PerspectiveCameraBack(this,
-                                       "perspective_camera_back_0",
-                                       ToRadians(cAperture),
-                                       fPerspCamFocalLength,
-                                       fPerspCamRange,
-                                       PERSPECTIVE_CAMERA_WIDHT,
-                                       PERSPECTIVE_CAMERA_HEIGHT,
-                                       cPerspBackCamAnchor);
+                                      "perspective_camera_back_0",
+                                      c_perspcam_aperture,
+                                      f_perspcam_focal_length,
+                                      f_perspcam_range,
+                                      PERSPECTIVE_CAMERA_WIDHT,
+                                      PERSPECTIVE_CAMERA_HEIGHT,
+                                      cPerspBackCamAnchor);
         AddComponent(*m_pcLeftPerspectiveCameraEquippedEntity);
         AddComponent(*m_pcRightPerspectiveCameraEquippedEntity);
         AddComponent(*m_pcFrontPerspectiveCameraEquippedEntity);
         AddComponent(*m_pcBackPerspectiveCameraEquippedEntity);
-        /* Turret equipped entity */
+    }
+    /* Turret equipped entity */
+    if(HasComponents(COMPONENT_TURRET)) {
         m_pcTurretEntity = new CFootBotTurretEntity(this, "turret_0", cTurretAnchor);
         AddComponent(*m_pcTurretEntity);
-        /* WiFi equipped entity */
+    }
+    /* WiFi equipped entity */
+    if(HasComponents(COMPONENT_WIFI)) {
         m_pcWiFiEquippedEntity = new CWiFiEquippedEntity(this, "wifi_0");
         AddComponent(*m_pcWiFiEquippedEntity);
-        /* Controllable entity
-           It must be the last one, for actuators/sensors to link to composing entities correctly */
-        m_pcControllableEntity = new CControllableEntity(this);
-        AddComponent(*m_pcControllableEntity);
-        m_pcControllableEntity->Init(GetNode(t_tree, "controller"));
-        /* Update components */
-        UpdateComponents();
-    }
-    catch(CARGoSException& ex) {
-        THROW_ARGOSEXCEPTION_NESTED("Failed to initialize entity \"" << GetId() << "\".", ex);
     }
 }
 
@@ -561,10 +495,10 @@ void CCustomFootBotEntity::Reset() {
 /****************************************/
 /****************************************/
 
-#define UPDATE(COMPONENT) if(COMPONENT->IsEnabled()) COMPONENT->Update();
+#define UPDATE(COMPONENT) if(COMPONENT != NULL && COMPONENT->IsEnabled()) COMPONENT->Update();
 
 void CCustomFootBotEntity::UpdateComponents() {
-    /* Update only the components that might change */
+    /* Update only the components that might change and were created */
     UPDATE(m_pcDistanceScannerEquippedEntity);
     UPDATE(m_pcTurretEntity);
     UPDATE(m_pcGripperEquippedEntity);
@@ -647,7 +581,7 @@ REGISTER_ENTITY(CCustomFootBotEntity,
                     "    </foot-bot>\n"
                     "    ...\n"
                     "  </arena>\n\n"
-                    "Finally, you can change the parameters of the perspective camera. You can set\n"
+                    "You can also change the parameters of the perspective camera. You can set\n"
                     "its direction, aperture, focal length, and range with the attributes\n"
                     "'perspective_camera_front', 'perspective_camera_aperture',\n"
                     "'perspective_camera_focal_length', and 'perspective_camera_range', respectively.\n"
@@ -667,6 +601,22 @@ REGISTER_ENTITY(CCustomFootBotEntity,
                     "    </foot-bot>\n"
                     "    ...\n"
                     "  </arena>\n\n"
+                    "Finally, you can leave out the components the controller does not use, which\n"
+                    "saves their memory and their update at every step. The 'components' attribute\n"
+                    "is a comma separated list of: leds, proximity, light, gripper, ground,\n"
+                    "distance_scanner, rab, omnidirectional_camera, perspective_cameras, turret,\n"
+                    "wifi, or all, which is the default. The body, the wheels and the controller\n"
+                    "are always there. Sensors and actuators of missing components cannot be used.\n"
+                    "Without the gripper or the turret, dynamics2d simulates the robot as a single\n"
+                    "body and gripping has no effect. For instance:\n\n"
+                    "  <arena ...>\n"
+                    "    ...\n"
+                    "    <foot-bot id=\"fb0\" components=\"leds,proximity,gripper,turret\">\n"
+                    "      <body position=\"0.4,2.3,0.25\" orientation=\"45,0,0\" />\n"
+                    "      <controller config=\"mycntrl\" />\n"
+                    "    </foot-bot>\n"
+                    "    ...\n"
+                    "  </arena>\n\n"
 ,
                 "Under development"
 );
@@ -35,6 +35,25 @@ public:
 
     ENABLE_VTABLE();
 
+    /**
+     * Optional components of the foot-bot.
+     * The body, the wheels and the controller are always there.
+     */
+    enum EComponent {
+        COMPONENT_LEDS                   = 1 << 0,
+        COMPONENT_PROXIMITY              = 1 << 1,
+        COMPONENT_LIGHT                  = 1 << 2,
+        COMPONENT_GRIPPER                = 1 << 3,
+        COMPONENT_GROUND                 = 1 << 4,
+        COMPONENT_DISTANCE_SCANNER       = 1 << 5,
+        COMPONENT_RAB                    = 1 << 6,
+        COMPONENT_OMNIDIRECTIONAL_CAMERA = 1 << 7,
+        COMPONENT_PERSPECTIVE_CAMERAS    = 1 << 8,
+        COMPONENT_TURRET                 = 1 << 9,
+        COMPONENT_WIFI                   = 1 << 10,
+        COMPONENTS_ALL                   = (1 << 11) - 1
+    };
+
 public:
 
     CCustomFootBotEntity();
@@ -48,12 +67,31 @@ public:
                          const CRadians& c_omnicam_aperture = ToRadians(CDegrees(70.0f)),
                          const CRadians& c_perspcam_aperture = ToRadians(CDegrees(30.0f)),
                          Real f_perspcam_focal_length = 0.035,
-                         Real f_perspcam_range = 2.0);
+                         Real f_perspcam_range = 2.0,
+                         UInt32 un_components = COMPONENTS_ALL);
+
+    /**
+     * Parses a comma separated list of component names, e.g. "proximity,rab".
+     * @throws CARGoSException for an unknown name
+     */
+    static UInt32 ParseComponents(const std::string& str_components);
 
     virtual void Init(TConfigurationNode& t_tree);
     virtual void Reset();
     virtual void UpdateComponents();
 
+    inline UInt32 GetComponents() const {
+        return m_unComponents;
+    }
+
+    /**
+     * Returns true if all the components in the given mask were created.
+     * The getters of the other components must not be called.
+     */
+    inline bool HasComponents(UInt32 un_components) const {
+        return (m_unComponents & un_components) == un_components;
+    }
+
     inline CControllableEntity& GetControllableEntity() {
         return *m_pcControllableEntity;
     }
@@ -118,6 +156,15 @@ public:
         return "foot-bot";
     }
 
+private:
+
+    void CreateComponents(Real f_rab_range,
+                          size_t un_rab_data_size,
+                          const CRadians& c_omnicam_aperture,
+                          const CRadians& c_perspcam_aperture,
+                          Real f_perspcam_focal_length,
+                          Real f_perspcam_range);
+
 private:
 
     CControllableEntity*                   m_pcControllableEntity;
@@ -137,6 +184,7 @@ private:
     CRABEquippedEntity*                    m_pcRABEquippedEntity;
     CWheeledEntity*                        m_pcWheeledEntity;
     CWiFiEquippedEntity*                   m_pcWiFiEquippedEntity;
+    UInt32                                 m_unComponents;
 };
 
 }
@@ -88,14 +88,22 @@ namespace argos {
    static const Real CAMERA_RADIUS               = BEACON_RADIUS;
    static const Real CAMERA_HEIGHT               = 0.104f;
 
+   /* Rendering */
+   static const GLuint LED_RING_SLICES           = 12;
+   static const GLuint PART_LISTS                = 14;
+   static const GLuint LISTS                     = PART_LISTS + LED_RING_SLICES;
+   static const GLfloat LED_EMISSION_FACTOR      = 10.0f;
+   /* Beyond this distance from the camera the gripper and scanner parts are a few pixels wide */
+   static const GLfloat DETAIL_DISTANCE          = 4.0f;
+
    /****************************************/
    /****************************************/
 
    CQTOpenGLCustomFootBot::CQTOpenGLCustomFootBot() :
       m_unVertices(40),
-      m_fLEDAngleSlice(360.0f / 12.0f) {
+      m_fLEDAngleSlice(360.0f / LED_RING_SLICES) {
       /* Reserve the needed display lists */
-      m_unLists = glGenLists(13);
+      m_unLists = glGenLists(LISTS);
 
       /* Assign indices for better referencing (later) */
       m_unBasicWheelList            = m_unLists;
@@ -111,6 +119,8 @@ namespace argos {
       m_unIMXList                   = m_unLists + 10;
       m_unBeaconList                = m_unLists + 11;
       m_unCameraList                = m_unLists + 12;
+      m_unChassisList               = m_unLists + 13;
+      m_unLEDSliceLists             = m_unLists + PART_LISTS;
 
       /* Create the materialless wheel display list */
       glNewList(m_unBasicWheelList, GL_COMPILE);
@@ -176,19 +186,115 @@ namespace argos {
       glNewList(m_unCameraList, GL_COMPILE);
       RenderCamera();
       glEndList();
+
+      /* Create the chassis display list */
+      glNewList(m_unChassisList, GL_COMPILE);
+      RenderChassis();
+      glEndList();
+
+      /* Create one display list per LED slice, already rotated in place */
+      for(GLuint i = 0; i < LED_RING_SLICES; i++) {
+         glNewList(m_unLEDSliceLists + i, GL_COMPILE);
+         glPushMatrix();
+         glRotatef(m_fLEDAngleSlice * (i + 1), 0.0f, 0.0f, 1.0f);
+         glCallList(m_unGrippableSliceList);
+         glPopMatrix();
+         glEndList();
+      }
    }
 
    /****************************************/
    /****************************************/
 
    CQTOpenGLCustomFootBot::~CQTOpenGLCustomFootBot() {
-      glDeleteLists(m_unLists, 13);
+      glDeleteLists(m_unLists, LISTS);
    }
 
    /****************************************/
    /****************************************/
 
    void CQTOpenGLCustomFootBot::Draw(CCustomFootBotEntity& c_entity) {
+      /* Place the parts that do not move with respect to the robot */
+      glCallList(m_unChassisList);
+      /* Level of detail: gripper and scanner mechanics only when close */
+      bool bDetailed = IsCloseToCamera();
+      /* Place the gripper module */
+      glPushMatrix();
+      /* Read gripper orientation from footbot entity, robots without some components draw them at rest */
+      if(c_entity.HasComponents(CCustomFootBotEntity::COMPONENT_TURRET)) {
+         GLfloat fGripperOrientation = ToDegrees(c_entity.GetTurretEntity().GetRotation()).GetValue();
+         glRotatef(fGripperOrientation, 0.0f, 0.0f, 1.0f);
+      }
+      /* Place the grippable part of the gripper module (LEDs) */
+      bool bLEDs = c_entity.HasComponents(CCustomFootBotEntity::COMPONENT_LEDS);
+      glPushAttrib(GL_LIGHTING_BIT | GL_CURRENT_BIT);
+      /* The LED colors drive the emission, the rest of the material is shared by all slices */
+      SetLEDMaterial(0.0f, 0.0f, 0.0f);
+      glColorMaterial(GL_FRONT_AND_BACK, GL_EMISSION);
+      glEnable(GL_COLOR_MATERIAL);
+      for(UInt32 i = 0; i < LED_RING_SLICES; i++) {
+         SetLEDColor(bLEDs ? c_entity.GetLEDEquippedEntity().GetLED(i).GetColor() : CColor::BLACK);
+         glCallList(m_unLEDSliceLists + i);
+      }
+      glPopAttrib();
+      if(bDetailed) {
+         /* Place the gripper mechanics */
+         glCallList(m_unGripperMechanicsList);
+         /* Place the gripper claws */
+         /* Read the gripper aperture from footbot entity */
+         GLfloat fGripperAperture = c_entity.HasComponents(CCustomFootBotEntity::COMPONENT_GRIPPER) ?
+                                    c_entity.GetGripperEquippedEntity().GetLockState() * 90.0f : 0.0f;
+         glTranslatef(GRIPPER_CLAW_OFFSET, 0.0f, GRIPPER_CLAW_ELEVATION);
+         glPushMatrix();
+         glRotatef(fGripperAperture, 0.0f, 1.0f, 0.0f);
+         glCallList(m_unGripperClawList);
+         glPopMatrix();
+         glPushMatrix();
+         glRotatef(-fGripperAperture, 0.0f, 1.0f, 0.0f);
+         glCallList(m_unGripperClawList);
+         glPopMatrix();
+      }
+      glPopMatrix();
+      if(bDetailed && c_entity.HasComponents(CCustomFootBotEntity::COMPONENT_DISTANCE_SCANNER)) {
+         /* Place the distance scanner sensors */
+         glPushMatrix();
+         /* Read dist scanner orientation from footbot entity */
+         GLfloat fDistanceScannerOrientation = ToDegrees(c_entity.GetDistanceScannerEquippedEntity().GetRotation()).GetValue();
+         glRotatef(fDistanceScannerOrientation, 0.0f, 0.0f, 1.0f);
+         glCallList(m_unDistanceScannerSensorList);
+         glRotatef(90.0f, 0.0f, 0.0f, 1.0f);
+         glCallList(m_unDistanceScannerSensorList);
+         glRotatef(90.0f, 0.0f, 0.0f, 1.0f);
+         glCallList(m_unDistanceScannerSensorList);
+         glRotatef(90.0f, 0.0f, 0.0f, 1.0f);
+         glCallList(m_unDistanceScannerSensorList);
+         glPopMatrix();
+      }
+      /* Place the beacon */
+      const CColor& cBeaconColor = bLEDs ? c_entity.GetLEDEquippedEntity().GetLED(12).GetColor() : CColor::BLACK;
+      SetLEDMaterial(cBeaconColor.GetRed()   / 255.0f,
+                     cBeaconColor.GetGreen() / 255.0f,
+                     cBeaconColor.GetBlue()  / 255.0f);
+      glCallList(m_unBeaconList);
+   }
+
+   /****************************************/
+   /****************************************/
+
+   bool CQTOpenGLCustomFootBot::IsCloseToCamera() const {
+      /* The model-view matrix holds the robot pose, so its translation is
+         the robot position in eye coordinates */
+      GLfloat pfModelView[16];
+      glGetFloatv(GL_MODELVIEW_MATRIX, pfModelView);
+      return pfModelView[12] * pfModelView[12] +
+             pfModelView[13] * pfModelView[13] +
+             pfModelView[14] * pfModelView[14] < DETAIL_DISTANCE * DETAIL_DISTANCE;
+   }
+
+   /****************************************/
+   /****************************************/
+
+   void CQTOpenGLCustomFootBot::RenderChassis() {
       /* Place the wheels */
       glPushMatrix();
       glTranslatef(0.0f, HALF_INTERWHEEL_DISTANCE, 0.0f);
@@ -207,64 +313,14 @@ namespace argos {
       glTranslatef(0.0f, -HALF_INTERTRACK_DISTANCE, 0.0f);
       glCallList(m_unTrackList);
       glPopMatrix();
-      /* Place the tracks */
+      /* Place the base */
       glCallList(m_unBaseList);
-      /* Place the gripper module */
-      glPushMatrix();
-      /* Read gripper orientation from footbot entity */
-      GLfloat fGripperOrientation = ToDegrees(c_entity.GetTurretEntity().GetRotation()).GetValue();
-      glRotatef(fGripperOrientation, 0.0f, 0.0f, 1.0f);
-      /* Place the grippable part of the gripper module (LEDs) */
-      glPushMatrix();
-      CLEDEquippedEntity& cLEDEquippedEntity = c_entity.GetLEDEquippedEntity();
-      for(UInt32 i = 0; i < 12; i++) {
-         const CColor& cColor = cLEDEquippedEntity.GetLED(i).GetColor();
-         glRotatef(m_fLEDAngleSlice, 0.0f, 0.0f, 1.0f);
-         SetLEDMaterial(cColor.GetRed()   / 255.0f,
-                        cColor.GetGreen() / 255.0f,
-                        cColor.GetBlue()  / 255.0f);
-         glCallList(m_unGrippableSliceList);
-      }
-      glPopMatrix();
-      /* Place the gripper mechanics */
-      glCallList(m_unGripperMechanicsList);
-      /* Place the gripper claws */
-      /* Read the gripper aperture from footbot entity */
-      GLfloat fGripperAperture = c_entity.GetGripperEquippedEntity().GetLockState() * 90.0f;
-      glTranslatef(GRIPPER_CLAW_OFFSET, 0.0f, GRIPPER_CLAW_ELEVATION);
-      glPushMatrix();
-      glRotatef(fGripperAperture, 0.0f, 1.0f, 0.0f);
-      glCallList(m_unGripperClawList);
-      glPopMatrix();
-      glPushMatrix();
-      glRotatef(-fGripperAperture, 0.0f, 1.0f, 0.0f);
-      glCallList(m_unGripperClawList);
-      glPopMatrix();
-      glPopMatrix();
       /* Place the RAB */
       glCallList(m_unRABList);
       /* Place the distance scanner */
       glCallList(m_unDistanceScannerList);
-      glPushMatrix();
-      /* Read dist scanner orientation from footbot entity */
-      GLfloat fDistanceScannerOrientation = ToDegrees(c_entity.GetDistanceScannerEquippedEntity().GetRotation()).GetValue();
-      glRotatef(fDistanceScannerOrientation, 0.0f, 0.0f, 1.0f);
-      glCallList(m_unDistanceScannerSensorList);
-      glRotatef(90.0f, 0.0f, 0.0f, 1.0f);
-      glCallList(m_unDistanceScannerSensorList);
-      glRotatef(90.0f, 0.0f, 0.0f, 1.0f);
-      glCallList(m_unDistanceScannerSensorList);
-      glRotatef(90.0f, 0.0f, 0.0f, 1.0f);
-      glCallList(m_unDistanceScannerSensorList);
-      glPopMatrix();
       /* Place the iMX module */
       glCallList(m_unIMXList);
-      /* Place the beacon */
-      const CColor& cBeaconColor = cLEDEquippedEntity.GetLED(12).GetColor();
-      SetLEDMaterial(cBeaconColor.GetRed()   / 255.0f,
-                     cBeaconColor.GetGreen() / 255.0f,
-                     cBeaconColor.GetBlue()  / 255.0f);
-      glCallList(m_unBeaconList);
       /* Place the camera */
       glCallList(m_unCameraList);
    }
@@ -360,7 +416,7 @@ namespace argos {
    /****************************************/
 
    void CQTOpenGLCustomFootBot::SetLEDMaterial(GLfloat f_red, GLfloat f_green, GLfloat f_blue) {
-      const GLfloat fEmissionFactor = 10.0f;
+      const GLfloat fEmissionFactor = LED_EMISSION_FACTOR;
       const GLfloat pfColor[]     = {                    f_red,                   f_green,                   f_blue, 1.0f };
       const GLfloat pfSpecular[]  = {                     0.0f,                      0.0f,                     0.0f, 1.0f };
       const GLfloat pfShininess[] = {                     0.0f                                                            };
@@ -374,6 +430,16 @@ namespace argos {
    /****************************************/
    /****************************************/
 
+   void CQTOpenGLCustomFootBot::SetLEDColor(const CColor& c_color) {
+      /* Same saturated emission as SetLEDMaterial, through the color material */
+      glColor3f(Min(1.0f, c_color.GetRed()   / 255.0f * LED_EMISSION_FACTOR),
+                Min(1.0f, c_color.GetGreen() / 255.0f * LED_EMISSION_FACTOR),
+                Min(1.0f, c_color.GetBlue()  / 255.0f * LED_EMISSION_FACTOR));
+   }
+
+   /****************************************/
+   /****************************************/
+
    void CQTOpenGLCustomFootBot::RenderWheel() {
       /* Set material */
       SetWhitePlasticMaterial();
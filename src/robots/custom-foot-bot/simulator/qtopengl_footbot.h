@@ -10,6 +10,7 @@
 namespace argos {
    class CQTOpenGLCustomFootBot;
    class CCustomFootBotEntity;
+   class CColor;
 }
 
 #ifdef __APPLE__
@@ -46,6 +47,11 @@ namespace argos {
       void SetCircuitBoardMaterial();
       /** Sets a colored LED material */
       void SetLEDMaterial(GLfloat f_red, GLfloat f_green, GLfloat f_blue);
+      /** Sets the LED emission when GL_COLOR_MATERIAL tracks it */
+      void SetLEDColor(const CColor& c_color);
+
+      /** Whether the robot is close enough to draw the small moving parts */
+      bool IsCloseToCamera() const;
 
       /** Renders the wheels */
       void RenderWheel();
@@ -71,6 +77,8 @@ namespace argos {
       void RenderBeacon();
       /** Renders the camera */
       void RenderCamera();
+      /** Renders all the parts that are fixed with respect to the robot */
+      void RenderChassis();
 
    private:
 
@@ -104,6 +112,10 @@ namespace argos {
       GLuint m_unBeaconList;
       /** Foot-bot camera module */
       GLuint m_unCameraList;
+      /** Foot-bot wheels, tracks, base, RAB, distance scanner, iMX and camera */
+      GLuint m_unChassisList;
+      /** Start of the grippable slices, one list per LED */
+      GLuint m_unLEDSliceLists;
 
       /** Number of vertices to display the round parts
           (wheels, chassis, etc.) */
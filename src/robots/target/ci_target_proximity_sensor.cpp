@@ -0,0 +1,38 @@
+/**
+ * @file <robots/target/ci_target_proximity_sensor.cpp>
+ */
+
+#include "ci_target_proximity_sensor.h"
+
+#ifdef ARGOS_WITH_LUA
+#include <argos3/core/wrappers/lua/lua_utility.h>
+#endif
+
+namespace argos {
+
+#ifdef ARGOS_WITH_LUA
+void CCI_TargetProximitySensor::CreateLuaState(lua_State* pt_lua_state) {
+    CLuaUtility::OpenRobotStateTable(pt_lua_state, "target_proximity");
+    CLuaUtility::CloseRobotStateTable(pt_lua_state);
+}
+
+void CCI_TargetProximitySensor::ReadingsToLuaState(lua_State* pt_lua_state) {
+    lua_getfield(pt_lua_state, -1, "target_proximity");
+    /* Drop the readings of the previous step */
+    lua_pushnil(pt_lua_state);
+    lua_setfield(pt_lua_state, -2, "readings");
+    CLuaUtility::StartTable(pt_lua_state, "readings");
+    for(size_t i = 0; i < m_tReadings.size(); ++i) {
+        CLuaUtility::StartTable(pt_lua_state, i + 1);
+        CLuaUtility::AddToTable(pt_lua_state, "id", static_cast<Real>(m_tReadings[i].Id));
+        CLuaUtility::AddToTable(pt_lua_state, "position", m_tReadings[i].Position);
+        CLuaUtility::AddToTable(pt_lua_state, "bearing", m_tReadings[i].Bearing);
+        CLuaUtility::AddToTable(pt_lua_state, "range", m_tReadings[i].Range);
+        CLuaUtility::EndTable(pt_lua_state);
+    }
+    CLuaUtility::EndTable(pt_lua_state);
+    lua_pop(pt_lua_state, 1);
+}
+#endif
+
+}
@@ -0,0 +1,67 @@
+/**
+ * @file <robots/target/ci_target_proximity_sensor.h>
+ *
+ * @brief Control interface of a sensor that returns the targets within
+ * range of the robot.
+ *
+ * Each reading carries the numeric id of the target, the same one the target
+ * controller used to broadcast over range and bearing, and its position in
+ * the arena. Bearings follow the convention of the colored beacon bearing
+ * sensor: robot frame, counter-clockwise from the heading, in (-pi, pi].
+ */
+
+#pragma once
+
+namespace argos {
+class CCI_TargetProximitySensor;
+}
+
+#include <argos3/core/control_interface/ci_sensor.h>
+#include <argos3/core/utility/math/angles.h>
+#include <argos3/core/utility/math/vector3.h>
+#include <vector>
+
+namespace argos {
+
+class CCI_TargetProximitySensor : public CCI_Sensor {
+
+public:
+
+    struct SReading {
+        UInt32 Id;
+        CVector3 Position;
+        CRadians Bearing;
+        Real Range;
+
+        SReading(UInt32 un_id,
+                 const CVector3& c_position,
+                 const CRadians& c_bearing,
+                 Real f_range) :
+            Id(un_id),
+            Position(c_position),
+            Bearing(c_bearing),
+            Range(f_range) {}
+    };
+
+    typedef std::vector<SReading> TReadings;
+
+public:
+
+    CCI_TargetProximitySensor() {}
+
+    virtual ~CCI_TargetProximitySensor() {}
+
+    inline const TReadings& GetReadings() const { return m_tReadings; }
+
+#ifdef ARGOS_WITH_LUA
+    virtual void CreateLuaState(lua_State* pt_lua_state);
+
+    virtual void ReadingsToLuaState(lua_State* pt_lua_state);
+#endif
+
+protected:
+
+    TReadings m_tReadings;
+};
+
+}
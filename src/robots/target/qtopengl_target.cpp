@@ -11,15 +11,20 @@
 
 namespace argos {
 
+static const GLuint LED_SLOTS = 8;
+static const GLuint DISPLAY_LISTS = 3 + LED_SLOTS;
+static const GLfloat LED_EMISSION_FACTOR = 10.0f;
+
 CQTOpenGLTarget::CQTOpenGLTarget()
     : roundPartsVerticesNumber(40)
-    , angleGapBetweenLeds(360.0f / 8.0f) {
+    , angleGapBetweenLeds(360.0f / LED_SLOTS) {
     /* Reserve the needed display lists */
-    displayListIndex = glGenLists(3);
+    displayListIndex = glGenLists(DISPLAY_LISTS);
 
     /* Assign indices for better referencing (later) */
     bodyDisplayListIndex = displayListIndex + 1;
     ledDisplayListIndex = displayListIndex + 2;
+    ledSlotsDisplayListIndex = displayListIndex + 3;
 
     /* Create the body display list */
     glNewList(bodyDisplayListIndex, GL_COMPILE);
@@ -30,13 +35,23 @@ CQTOpenGLTarget::CQTOpenGLTarget()
     glNewList(ledDisplayListIndex, GL_COMPILE);
     RenderLED();
     glEndList();
+
+    /* Create one display list per LED position, already rotated in place */
+    for (GLuint i = 0; i < LED_SLOTS; i++) {
+        glNewList(ledSlotsDisplayListIndex + i, GL_COMPILE);
+        glPushMatrix();
+        glRotatef(-angleGapBetweenLeds * (i + 1), 0.0f, 0.0f, 1.0f);
+        glCallList(ledDisplayListIndex);
+        glPopMatrix();
+        glEndList();
+    }
 }
 
 /****************************************/
 /****************************************/
 
 CQTOpenGLTarget::~CQTOpenGLTarget() {
-    glDeleteLists(displayListIndex, 3);
+    glDeleteLists(displayListIndex, DISPLAY_LISTS);
 }
 
 /****************************************/
@@ -45,18 +60,19 @@ CQTOpenGLTarget::~CQTOpenGLTarget() {
 void CQTOpenGLTarget::Draw(CTargetEntity& entity) {
     /* Place the body */
     glCallList(bodyDisplayListIndex);
-    /* Place the LEDs */
-    glPushMatrix();
+    /* Place the LEDs, their colors drive the emission of a shared material */
+    glPushAttrib(GL_LIGHTING_BIT | GL_CURRENT_BIT);
+    SetLEDMaterial(0.0f, 0.0f, 0.0f);
+    glColorMaterial(GL_FRONT_AND_BACK, GL_EMISSION);
+    glEnable(GL_COLOR_MATERIAL);
     CLEDEquippedEntity& ledEquippedEntity = entity.GetLEDEquippedEntity();
+    GLuint slot = 0;
     for (const auto& led : ledEquippedEntity.GetLEDs()) {
-        const CColor& color = led->LED.GetColor();
-        glRotatef(-angleGapBetweenLeds, 0.0f, 0.0f, 1.0f);
-        SetLEDMaterial(color.GetRed(),
-                       color.GetGreen(),
-                       color.GetBlue());
-        glCallList(ledDisplayListIndex);
+        SetLEDColor(led->LED.GetColor());
+        glCallList(ledSlotsDisplayListIndex + slot);
+        slot = (slot + 1) % LED_SLOTS;
     }
-    glPopMatrix();
+    glPopAttrib();
 }
 
 /****************************************/
@@ -107,7 +123,7 @@ void CQTOpenGLTarget::SetCircuitBoardMaterial() {
 void CQTOpenGLTarget::SetLEDMaterial(GLfloat red,
                                        GLfloat green,
                                        GLfloat blue) {
-    const GLfloat fEmissionFactor = 10.0f;
+    const GLfloat fEmissionFactor = LED_EMISSION_FACTOR;
     const GLfloat pfColor[] = {red, green, blue, 1.0f};
     const GLfloat pfSpecular[] = {0.0f, 0.0f, 0.0f, 1.0f};
     const GLfloat pfShininess[] = {0.0f};
@@ -121,6 +137,16 @@ void CQTOpenGLTarget::SetLEDMaterial(GLfloat red,
 /****************************************/
 /****************************************/
 
+void CQTOpenGLTarget::SetLEDColor(const CColor& color) {
+    /* Same saturated emission as SetLEDMaterial with the raw color channels */
+    glColor3f(Min(1.0f, color.GetRed() * LED_EMISSION_FACTOR),
+              Min(1.0f, color.GetGreen() * LED_EMISSION_FACTOR),
+              Min(1.0f, color.GetBlue() * LED_EMISSION_FACTOR));
+}
+
+/****************************************/
+/****************************************/
+
 void CQTOpenGLTarget::RenderBody() {
     /* Set material */
     SetBodyPlasticMaterial();
@@ -208,7 +234,8 @@ public:
     void ApplyTo(CQTOpenGLWidget& visualization,
                  CTargetEntity& entity) {
         static CQTOpenGLTarget model;
-        visualization.DrawRays(entity.GetControllableEntity());
+        if(entity.HasControllableEntity())
+            visualization.DrawRays(entity.GetControllableEntity());
         visualization.DrawEntity(entity.GetEmbodiedEntity());
         model.Draw(entity);
     }
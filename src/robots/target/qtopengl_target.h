@@ -3,6 +3,7 @@
 namespace argos {
 class CQTOpenGLTarget;
 class CTargetEntity;
+class CColor;
 }
 
 #ifdef __APPLE__
@@ -24,6 +25,8 @@ protected:
     void SetRedPlasticMaterial();
     void SetCircuitBoardMaterial();
     void SetLEDMaterial(GLfloat red, GLfloat green, GLfloat blue);
+    /* Sets the LED emission when GL_COLOR_MATERIAL tracks it */
+    void SetLEDColor(const CColor& color);
 
     void RenderBody();
     void RenderLED();
@@ -32,6 +35,7 @@ private:
     GLuint displayListIndex;
     GLuint bodyDisplayListIndex;
     GLuint ledDisplayListIndex;
+    GLuint ledSlotsDisplayListIndex;
     GLuint roundPartsVerticesNumber;
     GLfloat angleGapBetweenLeds;
 };
@@ -70,22 +70,28 @@ void CTargetEntity::Init(TConfigurationNode& t_tree) {
            8,
            embodiedEntity->GetOriginAnchor());
 
-        Real fRange = 0.8f;
-        GetNodeAttributeOrDefault(t_tree, "rab_range", fRange, fRange);
-        UInt32 unDataSize = 2;
-        GetNodeAttributeOrDefault(t_tree, "rab_data_size", unDataSize, unDataSize);
-        rabEquippedEntity = new CRABEquippedEntity(this,
-                                                  rabId,
-                                                  unDataSize,
-                                                  fRange,
-                                                  embodiedEntity->GetOriginAnchor(),
-                                                  *embodiedEntity,
-                                                  CVector3(0.0f, 0.0f, RAB_ELEVATION));
-        AddComponent(*rabEquippedEntity);
-
-        controllableEntity = new CControllableEntity(this);
-        AddComponent(*controllableEntity);
-        controllableEntity->Init(GetNode(t_tree, "controller"));
+        /*
+         * The controller and its range and bearing device are optional, robots
+         * can detect targets with the target_proximity sensor instead
+         */
+        if(NodeExists(t_tree, "controller")) {
+            Real fRange = 0.8f;
+            GetNodeAttributeOrDefault(t_tree, "rab_range", fRange, fRange);
+            UInt32 unDataSize = 2;
+            GetNodeAttributeOrDefault(t_tree, "rab_data_size", unDataSize, unDataSize);
+            rabEquippedEntity = new CRABEquippedEntity(this,
+                                                      rabId,
+                                                      unDataSize,
+                                                      fRange,
+                                                      embodiedEntity->GetOriginAnchor(),
+                                                      *embodiedEntity,
+                                                      CVector3(0.0f, 0.0f, RAB_ELEVATION));
+            AddComponent(*rabEquippedEntity);
+
+            controllableEntity = new CControllableEntity(this);
+            AddComponent(*controllableEntity);
+            controllableEntity->Init(GetNode(t_tree, "controller"));
+        }
 
         UpdateComponents();
     }
@@ -112,7 +118,7 @@ void CTargetEntity::Destroy() {
 /****************************************/
 /****************************************/
 
-#define UPDATE(COMPONENT) if(COMPONENT->IsEnabled()) COMPONENT->Update();
+#define UPDATE(COMPONENT) if(COMPONENT != nullptr && COMPONENT->IsEnabled()) COMPONENT->Update();
 
 void CTargetEntity::UpdateComponents() {
     UPDATE(rabEquippedEntity);
@@ -127,7 +133,9 @@ REGISTER_ENTITY(CTargetEntity,
                 "Pawel Jakubowski",
                 "1.0",
                 "The target robot.",
-                "",
+                "A static robot the coverage algorithms search for. The 'controller' node is\n"
+                "optional: without it the target has no range and bearing device either, and robots\n"
+                "detect it with the target_proximity sensor.\n",
                 "Under development"
    );
 
@@ -32,7 +32,9 @@ public:
 
     virtual void UpdateComponents();
 
+    inline bool HasControllableEntity() const { return controllableEntity != nullptr; }
     inline CControllableEntity& GetControllableEntity() { return *controllableEntity; }
+    inline bool HasRABEquippedEntity() const { return rabEquippedEntity != nullptr; }
     inline CEmbodiedEntity& GetEmbodiedEntity() { return *embodiedEntity; }
     inline CLEDEquippedEntity& GetLEDEquippedEntity() { return *ledEquippedEntity; }
     inline CRABEquippedEntity& GetRABEquippedEntity() { return *rabEquippedEntity; }
@@ -0,0 +1,96 @@
+#include "target_index.h"
+
+#include "target_entity.h"
+#include <argos3/core/simulator/simulator.h>
+#include <argos3/core/simulator/space/space.h>
+#include <argos3/core/simulator/entity/embodied_entity.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace argos {
+
+/* Cell side used when no sensor requested a range */
+static const Real DEFAULT_CELL_SIZE = 1.0f;
+/* The cells are enlarged when targets are so sparse that the grid would have more cells than this per target */
+static const Real MAX_CELLS_PER_TARGET = 4.0f;
+
+CTargetIndex& CTargetIndex::GetInstance() {
+    static CTargetIndex cInstance;
+    return cInstance;
+}
+
+void CTargetIndex::RequireRange(Real f_range) {
+    std::lock_guard<std::mutex> cLock(m_cBuildMutex);
+    /* Once built, larger ranges are still answered correctly, they just touch more cells */
+    if(!m_bBuilt.load(std::memory_order_relaxed)) {
+        m_fCellSize = std::max(m_fCellSize, f_range);
+    }
+}
+
+UInt32 CTargetIndex::ParseId(const std::string& str_id) {
+    size_t unLastNotNumberCharacterIndex = str_id.find_last_not_of("0123456789");
+    return std::atoi(str_id.substr(unLastNotNumberCharacterIndex + 1).c_str()) + 1;
+}
+
+void CTargetIndex::Build() {
+    std::lock_guard<std::mutex> cLock(m_cBuildMutex);
+    /* Another sensor may have built it while this one was waiting */
+    if(m_bBuilt.load(std::memory_order_relaxed)) return;
+
+    std::vector<STarget> vecTargets;
+    CSpace& cSpace = CSimulator::GetInstance().GetSpace();
+    try {
+        for(auto& entity : cSpace.GetEntitiesByType("target")) {
+            auto& cTarget = *any_cast<CTargetEntity*>(entity.second);
+            CEmbodiedEntity& cBody = cTarget.GetEmbodiedEntity();
+            vecTargets.push_back(STarget{ParseId(cTarget.GetId()),
+                                         cBody.GetOriginAnchor().Position,
+                                         &cBody});
+        }
+    }
+    catch(CARGoSException&) {
+        /* No target in the arena */
+    }
+
+    if(!vecTargets.empty()) {
+        CVector2 cMin(vecTargets[0].Position.GetX(), vecTargets[0].Position.GetY());
+        CVector2 cMax = cMin;
+        for(const STarget& sTarget : vecTargets) {
+            cMin.Set(std::min(cMin.GetX(), sTarget.Position.GetX()),
+                     std::min(cMin.GetY(), sTarget.Position.GetY()));
+            cMax.Set(std::max(cMax.GetX(), sTarget.Position.GetX()),
+                     std::max(cMax.GetY(), sTarget.Position.GetY()));
+        }
+        CVector2 cExtent = cMax - cMin;
+        if(m_fCellSize <= 0) {
+            m_fCellSize = DEFAULT_CELL_SIZE;
+        }
+        m_fCellSize = std::max(m_fCellSize,
+                               std::sqrt(cExtent.GetX() * cExtent.GetY() /
+                                         (MAX_CELLS_PER_TARGET * vecTargets.size())));
+        m_cGridMin = cMin;
+        m_unGridWidth = static_cast<UInt32>(cExtent.GetX() / m_fCellSize) + 1;
+        m_unGridHeight = static_cast<UInt32>(cExtent.GetY() / m_fCellSize) + 1;
+
+        /* Counting sort of the targets by cell */
+        std::vector<UInt32> vecCells(vecTargets.size());
+        m_vecCellStart.assign(m_unGridWidth * m_unGridHeight + 1, 0);
+        for(size_t i = 0; i < vecTargets.size(); ++i) {
+            vecCells[i] = GetCellY(vecTargets[i].Position.GetY()) * m_unGridWidth +
+                          GetCellX(vecTargets[i].Position.GetX());
+            ++m_vecCellStart[vecCells[i] + 1];
+        }
+        for(size_t i = 1; i < m_vecCellStart.size(); ++i) {
+            m_vecCellStart[i] += m_vecCellStart[i - 1];
+        }
+        std::vector<UInt32> vecNext(m_vecCellStart.begin(), m_vecCellStart.end() - 1);
+        m_vecTargets.resize(vecTargets.size());
+        for(size_t i = 0; i < vecTargets.size(); ++i) {
+            m_vecTargets[vecNext[vecCells[i]]++] = vecTargets[i];
+        }
+    }
+    m_bBuilt.store(true, std::memory_order_release);
+}
+
+}
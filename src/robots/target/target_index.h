@@ -0,0 +1,112 @@
+#pragma once
+
+namespace argos {
+class CEmbodiedEntity;
+}
+
+#include <argos3/core/utility/math/vector2.h>
+#include <argos3/core/utility/math/vector3.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace argos {
+
+/*
+ * Static spatial index of the target positions, shared by all the target
+ * proximity sensors. Targets never move, so the index is built once, on the
+ * first query, when the arena and the loop functions have added all of them.
+ * The grid cell side is the largest range requested by a sensor, a query
+ * then touches at most 3x3 cells.
+ */
+class CTargetIndex {
+
+public:
+
+    struct STarget {
+        UInt32 Id;
+        CVector3 Position;
+        CEmbodiedEntity* Body;
+    };
+
+public:
+
+    static CTargetIndex& GetInstance();
+
+    /* Sets the cell side, to be called at sensor initialization, before the first query */
+    void RequireRange(Real f_range);
+
+    /*
+     * Calls c_operation(const STarget&) for every target whose distance on the
+     * XY plane to c_center is at most f_range. Safe to call from the sensor
+     * update threads.
+     */
+    template <typename OPERATION>
+    void ForTargetsInRange(const CVector2& c_center, Real f_range, OPERATION&& c_operation) {
+        if(!m_bBuilt.load(std::memory_order_acquire)) {
+            Build();
+        }
+        if(m_vecTargets.empty()) return;
+        Real fSquareRange = f_range * f_range;
+        UInt32 unMinX = GetCellX(c_center.GetX() - f_range);
+        UInt32 unMaxX = GetCellX(c_center.GetX() + f_range);
+        UInt32 unMinY = GetCellY(c_center.GetY() - f_range);
+        UInt32 unMaxY = GetCellY(c_center.GetY() + f_range);
+        for(UInt32 unY = unMinY; unY <= unMaxY; ++unY) {
+            for(UInt32 unX = unMinX; unX <= unMaxX; ++unX) {
+                UInt32 unCell = unY * m_unGridWidth + unX;
+                for(UInt32 i = m_vecCellStart[unCell]; i < m_vecCellStart[unCell + 1]; ++i) {
+                    const STarget& sTarget = m_vecTargets[i];
+                    Real fDX = sTarget.Position.GetX() - c_center.GetX();
+                    Real fDY = sTarget.Position.GetY() - c_center.GetY();
+                    if(fDX * fDX + fDY * fDY <= fSquareRange) {
+                        c_operation(sTarget);
+                    }
+                }
+            }
+        }
+    }
+
+    /* Number the target controller broadcast: the digits its id ends with, plus one */
+    static UInt32 ParseId(const std::string& str_id);
+
+private:
+
+    CTargetIndex() :
+        m_bBuilt(false),
+        m_fCellSize(0),
+        m_unGridWidth(0),
+        m_unGridHeight(0) {}
+
+    void Build();
+
+    inline UInt32 GetCellX(Real f_x) const {
+        return GetCell(f_x - m_cGridMin.GetX(), m_unGridWidth);
+    }
+
+    inline UInt32 GetCellY(Real f_y) const {
+        return GetCell(f_y - m_cGridMin.GetY(), m_unGridHeight);
+    }
+
+    /* Positions outside of the grid are kept in the border cells */
+    inline UInt32 GetCell(Real f_offset, UInt32 un_cells) const {
+        if(f_offset <= 0) return 0;
+        Real fCell = f_offset / m_fCellSize;
+        return fCell >= un_cells ? un_cells - 1 : static_cast<UInt32>(fCell);
+    }
+
+private:
+
+    std::atomic<bool> m_bBuilt;
+    std::mutex m_cBuildMutex;
+
+    Real m_fCellSize;
+    CVector2 m_cGridMin;
+    UInt32 m_unGridWidth;
+    UInt32 m_unGridHeight;
+    /* Targets sorted by cell, those of cell i are in [m_vecCellStart[i], m_vecCellStart[i + 1]) */
+    std::vector<STarget> m_vecTargets;
+    std::vector<UInt32> m_vecCellStart;
+};
+
+}
@@ -0,0 +1,120 @@
+#include "target_proximity_default_sensor.h"
+#include "target_details.h"
+#include <argos3/core/simulator/entity/composable_entity.h>
+#include <argos3/core/simulator/entity/controllable_entity.h>
+
+namespace argos {
+
+CTargetProximityDefaultSensor::CTargetProximityDefaultSensor() :
+    m_pcControllableEntity(NULL),
+    m_pcEmbodiedEntity(NULL),
+    m_cIndex(CTargetIndex::GetInstance()),
+    m_fRange(0.25),
+    m_bCheckOcclusions(true),
+    m_bShowRays(false) {}
+
+void CTargetProximityDefaultSensor::SetRobot(CComposableEntity& c_entity) {
+    /* Get controllable entity */
+    m_pcControllableEntity = &(c_entity.GetComponent<CControllableEntity>("controller"));
+    /* Get embodied entity */
+    m_pcEmbodiedEntity = &(c_entity.GetComponent<CEmbodiedEntity>("body"));
+}
+
+void CTargetProximityDefaultSensor::Init(TConfigurationNode& t_tree) {
+    try {
+        CCI_TargetProximitySensor::Init(t_tree);
+        GetNodeAttributeOrDefault(t_tree, "range", m_fRange, m_fRange);
+        if(m_fRange <= 0.0) {
+            THROW_ARGOSEXCEPTION("The range of the target proximity sensor must be positive, got " << m_fRange);
+        }
+        GetNodeAttributeOrDefault(t_tree, "check_occlusions", m_bCheckOcclusions, m_bCheckOcclusions);
+        GetNodeAttributeOrDefault(t_tree, "show_rays", m_bShowRays, m_bShowRays);
+        m_cIndex.RequireRange(m_fRange);
+    }
+    catch(CARGoSException& ex) {
+        THROW_ARGOSEXCEPTION_NESTED("Error initializing the target proximity sensor", ex);
+    }
+}
+
+void CTargetProximityDefaultSensor::Update() {
+    m_tReadings.clear();
+
+    const SAnchor& sOrigin = m_pcEmbodiedEntity->GetOriginAnchor();
+    m_cPosition = sOrigin.Position;
+    CRadians cAngleY, cAngleX;
+    sOrigin.Orientation.ToEulerAngles(m_cOrientation, cAngleY, cAngleX);
+
+    m_cIndex.ForTargetsInRange(CVector2(m_cPosition.GetX(), m_cPosition.GetY()),
+                               m_fRange,
+                               [this](const CTargetIndex::STarget& s_target) { CheckTarget(s_target); });
+}
+
+void CTargetProximityDefaultSensor::Reset() {
+    m_tReadings.clear();
+}
+
+void CTargetProximityDefaultSensor::CheckTarget(const CTargetIndex::STarget& s_target) {
+    if(m_bCheckOcclusions) {
+        /*
+         * The ray is cast at the height the range and bearing device of the
+         * target had and ends in its center, so the first body it meets is the
+         * target itself unless something stands in between
+         */
+        Real fZ = s_target.Position.GetZ() + RAB_ELEVATION;
+        m_cOcclusionCheckRay.Set(CVector3(m_cPosition.GetX(), m_cPosition.GetY(), fZ),
+                                 CVector3(s_target.Position.GetX(), s_target.Position.GetY(), fZ));
+        if(GetClosestEmbodiedEntityIntersectedByRay(m_sIntersectionItem,
+                                                    m_cOcclusionCheckRay,
+                                                    *m_pcEmbodiedEntity) &&
+           m_sIntersectionItem.IntersectedEntity != s_target.Body) {
+            if(m_bShowRays) {
+                m_pcControllableEntity->AddIntersectionPoint(m_cOcclusionCheckRay,
+                                                             m_sIntersectionItem.TOnRay);
+                m_pcControllableEntity->AddCheckedRay(true, m_cOcclusionCheckRay);
+            }
+            return;
+        }
+        if(m_bShowRays) {
+            m_pcControllableEntity->AddCheckedRay(false, m_cOcclusionCheckRay);
+        }
+    }
+
+    CVector2 cRelative(s_target.Position.GetX() - m_cPosition.GetX(),
+                       s_target.Position.GetY() - m_cPosition.GetY());
+    CRadians cBearing = (cRelative.Angle() - m_cOrientation).SignedNormalize();
+    m_tReadings.push_back(SReading(s_target.Id, s_target.Position, cBearing, cRelative.Length()));
+}
+
+REGISTER_SENSOR(CTargetProximityDefaultSensor,
+                "target_proximity", "default",
+                "Paweł Jakubowski", "1.0",
+                "A sensor that returns the targets within range of the robot.",
+                "This sensor replaces the detection of targets through range and bearing\n"
+                "packets. Targets are static, so their positions are put once in a spatial index\n"
+                "shared by all the robots, which is queried at every step. For each target within\n"
+                "range on the XY plane, it returns its numeric id (the number its id ends with,\n"
+                "plus one), its position, its bearing in the robot frame and its distance. Targets\n"
+                "do not need a controller or a range and bearing device for this sensor.\n\n"
+                "REQUIRED XML CONFIGURATION\n\n"
+                "    <controllers>\n"
+                "      ...\n"
+                "      <my_controller ...>\n"
+                "        ...\n"
+                "        <sensors>\n"
+                "          ...\n"
+                "          <target_proximity implementation=\"default\" />\n"
+                "          ...\n"
+                "        </sensors>\n"
+                "        ...\n"
+                "      </my_controller>\n"
+                "      ...\n"
+                "    </controllers>\n\n"
+                "OPTIONAL XML CONFIGURATION\n\n"
+                "The 'range' attribute sets the maximum detection distance in meters (default\n"
+                "0.25, the range the targets used to broadcast with). Targets hidden behind another\n"
+                "body are not reported, unless 'check_occlusions' is set to 'false'. Setting\n"
+                "'show_rays' to 'true' draws the occlusion check rays in the OpenGL visualization.\n",
+                "Usable"
+);
+
+}
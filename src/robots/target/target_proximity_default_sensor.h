@@ -0,0 +1,53 @@
+#pragma once
+
+namespace argos {
+class CControllableEntity;
+class CEmbodiedEntity;
+}
+
+#include "ci_target_proximity_sensor.h"
+#include "target_index.h"
+#include <argos3/core/simulator/sensor.h>
+#include <argos3/core/simulator/entity/embodied_entity.h>
+
+namespace argos {
+
+/*
+ * Replaces the detection of targets through range and bearing packets. The
+ * static target index is queried for the targets around the robot, so the
+ * targets need neither a controller nor a range and bearing device.
+ */
+class CTargetProximityDefaultSensor : public CSimulatedSensor,
+                                      public CCI_TargetProximitySensor {
+
+public:
+
+    CTargetProximityDefaultSensor();
+    virtual ~CTargetProximityDefaultSensor() = default;
+
+    virtual void SetRobot(CComposableEntity& c_entity);
+    virtual void Init(TConfigurationNode& t_tree);
+    virtual void Update();
+    virtual void Reset();
+
+private:
+
+    void CheckTarget(const CTargetIndex::STarget& s_target);
+
+private:
+
+    CControllableEntity* m_pcControllableEntity;
+    CEmbodiedEntity* m_pcEmbodiedEntity;
+    CTargetIndex& m_cIndex;
+    Real m_fRange;
+    bool m_bCheckOcclusions;
+    bool m_bShowRays;
+
+    /* Robot pose cached at the beginning of each update */
+    CVector3 m_cPosition;
+    CRadians m_cOrientation;
+    SEmbodiedEntityIntersectionItem m_sIntersectionItem;
+    CRay3 m_cOcclusionCheckRay;
+};
+
+}
@@ -0,0 +1,90 @@
+#include <utils/log/RunLogSummary.h>
+#include <argos3/core/utility/configuration/argos_exception.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+/*
+ * Reads every run log of a results tree once and writes per
+ * (experiment, robots, targets) statistics as CSV and as a columnar binary
+ * file for the plotting scripts.
+ *
+ *     aggregate_results <results dir> [<output prefix>]
+ *
+ * The tree is laid out as experiments.py runs it:
+ * <results dir>/<experiment>/r<robots>t<targets>_<repetition>.log
+ */
+
+namespace {
+
+vector<string> listDirectory(const string& path, bool directories) {
+    vector<string> names;
+    DIR* dir = opendir(path.c_str());
+    if (dir == nullptr)
+        THROW_ARGOSEXCEPTION("Cannot open directory " << path);
+    while (auto entry = readdir(dir)) {
+        string name = entry->d_name;
+        if (name == "." || name == "..")
+            continue;
+        struct stat info;
+        if (stat((path + "/" + name).c_str(), &info) == 0 && S_ISDIR(info.st_mode) == directories)
+            names.push_back(name);
+    }
+    closedir(dir);
+    sort(names.begin(), names.end());
+    return names;
+}
+
+bool parseRunName(const string& name, unsigned& robots, unsigned& targets) {
+    unsigned repetition;
+    int length = 0;
+    return sscanf(name.c_str(), "r%ut%u_%u.log%n", &robots, &targets, &repetition, &length) == 3 &&
+           static_cast<size_t>(length) == name.size();
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        cerr << "Usage: " << argv[0] << " <results dir> [<output prefix>]" << endl;
+        return 1;
+    }
+    const string resultsDir = argv[1];
+    const string prefix = argc == 3 ? argv[2] : resultsDir + "/summary";
+
+    RunLogSummary summary;
+    try {
+        for (auto& experiment : listDirectory(resultsDir, true)) {
+            const string experimentDir = resultsDir + "/" + experiment;
+            for (auto& name : listDirectory(experimentDir, false)) {
+                unsigned robots, targets;
+                if (!parseRunName(name, robots, targets))
+                    continue;
+                try {
+                    summary.add(experiment, robots, targets, RunLogData::read(experimentDir + "/" + name));
+                }
+                catch (argos::CARGoSException& e) {
+                    cerr << "Skipping " << experimentDir << "/" << name << ": " << e.what() << endl;
+                }
+            }
+        }
+
+        ofstream csv(prefix + ".csv");
+        summary.writeCsv(csv);
+        ofstream columnar(prefix + ".bin", ios::binary);
+        summary.writeColumnar(columnar);
+        if (!csv || !columnar)
+            THROW_ARGOSEXCEPTION("Cannot write summary " << prefix);
+    }
+    catch (argos::CARGoSException& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    cout << "Aggregated " << summary.getRunsNumber() << " runs into " << prefix << ".{csv,bin}" << endl;
+    return 0;
+}
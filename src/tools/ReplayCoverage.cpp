@@ -0,0 +1,122 @@
+#include <utils/coverage/CoverageGrid.h>
+#include <utils/coverage/FootprintStamps.h>
+#include <utils/log/RunLogWriter.h>
+#include <utils/log/TrajectoryReader.h>
+#include <argos3/core/utility/configuration/argos_exception.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <sstream>
+
+using namespace std;
+using namespace argos;
+
+/*
+ * Recomputes coverage from a recorded trajectory without running the
+ * simulation. Robot poses go through the same footprint stamps and
+ * CoverageGrid updates as the loop functions' PostStep, and the crossed
+ * thresholds are written to a run log.
+ *
+ *     replay_coverage <trajectory> <output run log> [--cell-size=<m>]
+ *                     [--footprint-scale=<factor>] [--thresholds=<%>,<%>,...]
+ */
+
+namespace {
+
+struct ReplayConfig {
+    Real cellSize = 0.1;
+    Real footprintScale = 1;
+    list<double> thresholds = {0.01, 10, 20, 30, 40, 50, 60, 70, 80, 90, 95, 100};
+};
+
+bool parseOption(const string& argument, const string& name, string& value) {
+    const string prefix = "--" + name + "=";
+    if (argument.compare(0, prefix.size(), prefix) != 0)
+        return false;
+    value = argument.substr(prefix.size());
+    return true;
+}
+
+ReplayConfig parseConfig(int argc, char** argv) {
+    ReplayConfig config;
+    for (int i = 3; i < argc; i++) {
+        string value;
+        if (parseOption(argv[i], "cell-size", value))
+            config.cellSize = atof(value.c_str());
+        else if (parseOption(argv[i], "footprint-scale", value))
+            config.footprintScale = atof(value.c_str());
+        else if (parseOption(argv[i], "thresholds", value)) {
+            config.thresholds.clear();
+            stringstream s(value);
+            string threshold;
+            while (getline(s, threshold, ','))
+                config.thresholds.push_back(atof(threshold.c_str()));
+        }
+        else
+            THROW_ARGOSEXCEPTION("Unknown option " << argv[i]);
+    }
+    if (config.cellSize <= 0)
+        THROW_ARGOSEXCEPTION("Cell size has to be positive");
+    return config;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        cerr << "Usage: " << argv[0] << " <trajectory> <output run log> [--cell-size=<m>]"
+             << " [--footprint-scale=<factor>] [--thresholds=<%>,<%>,...]" << endl;
+        return 1;
+    }
+    try {
+        auto config = parseConfig(argc, argv);
+        TrajectoryReader trajectory(argv[1]);
+        const auto& header = trajectory.getHeader();
+        const CRange<CVector3> limits(
+                CVector3(header.arenaMin[0], header.arenaMin[1], header.arenaMin[2]),
+                CVector3(header.arenaMax[0], header.arenaMax[1], header.arenaMax[2]));
+
+        CoverageGrid coverage(numeric_limits<int>::max(), config.cellSize);
+        coverage.initGrid(limits);
+        vector<Trajectory::Point> footprint;
+        for (auto& point : header.footprint)
+            footprint.push_back({{point[0] * config.footprintScale, point[1] * config.footprintScale, point[2]}});
+        FootprintStamps stamps;
+        stamps.init(footprint, config.cellSize);
+
+        RunLogWriter log;
+        log.open(argv[2], {RunLog::EventType::Threshold});
+
+        const auto start = chrono::steady_clock::now();
+        UInt32 steps = 0;
+        vector<CoverageGrid::Span> spans;
+        while (trajectory.next()) {
+            spans.clear();
+            for (auto& pose : trajectory.getPoses())
+                stamps.addSpans(coverage, pose, spans);
+            coverage.visitSpans(spans);
+
+            const auto percentageCoverage = coverage.getVisitedCoverageValue();
+            while (!config.thresholds.empty() && percentageCoverage >= config.thresholds.front()) {
+                cout << "Threshold " << config.thresholds.front() << "% achieved at step "
+                     << trajectory.getStep() << endl;
+                log.writeThreshold(trajectory.getStep(), percentageCoverage);
+                config.thresholds.pop_front();
+            }
+            log.update(trajectory.getStep());
+            steps++;
+        }
+        log.close();
+
+        const chrono::duration<double> duration = chrono::steady_clock::now() - start;
+        cout << "Replayed " << steps << " steps of " << header.robots.size() << " robots in "
+             << duration.count() << " s, final coverage " << coverage.getVisitedCoverageValue() << "%" << endl;
+    }
+    catch (CARGoSException& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
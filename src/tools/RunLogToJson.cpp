@@ -0,0 +1,33 @@
+#include <utils/log/RunLogReader.h>
+#include <argos3/core/utility/configuration/argos_exception.h>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+/*
+ * Converts a binary run log to the JSON document the loop functions used to
+ * write, e.g. to inspect a run or to feed older analysis scripts.
+ *
+ *     run_log_to_json <run log> [<output json>]
+ */
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        cerr << "Usage: " << argv[0] << " <run log> [<output json>]" << endl;
+        return 1;
+    }
+    try {
+        auto data = RunLogData::read(argv[1]);
+        if (argc == 3) {
+            ofstream file(argv[2]);
+            exportJson(data, file);
+        }
+        else
+            exportJson(data, cout);
+    }
+    catch (argos::CARGoSException& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
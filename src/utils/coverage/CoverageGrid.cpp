@@ -1,54 +1,80 @@
 #include "CoverageGrid.h"
+#include "CoverageRecorder.h"
 #include "assert.h"
+#include <algorithm>
+#include <cmath>
 
 using namespace argos;
 
+constexpr CoverageGrid::Visits CoverageGrid::maxVisits;
+constexpr unsigned CoverageGrid::tileSide;
+
 CoverageGrid::CoverageGrid(int maxCellConcentration, Real cellSizeInMeters, Real gridLiftOnZ)
         : maxCellConcentration(maxCellConcentration)
         , cellSizeInMeters(cellSizeInMeters)
         , gridLiftOnZ(gridLiftOnZ)
-{}
+{
+    for (unsigned i = 0; i <= maxVisits; i++)
+        concentrationLevels[i] = maxCellConcentration >> i;
+    for (unsigned i = 0; i < maxVisits; i++)
+        concentrationDrops[i] = concentrationLevels[i] - concentrationLevels[i + 1];
+    concentrationDrops[maxVisits] = 0;
+    coveringVisits = 0;
+    while (coveringVisits < maxVisits && concentrationLevels[coveringVisits] != 0)
+        coveringVisits++;
+}
 
 void CoverageGrid::initGrid(CRange<CVector3> limits) {
+    /* A recording covers a single grid layout */
+    if (recorder != nullptr)
+        recorder->close();
     arenaLimits = limits;
-    Real minX = arenaLimits.GetMin().GetX();
-    Real maxX = arenaLimits.GetMax().GetX();
-    Real minY = arenaLimits.GetMin().GetY();
-    Real maxY = arenaLimits.GetMax().GetY();
-
-    size = 0;
-    grid.clear();
-    for (Real x = minX; x < maxX; x += cellSizeInMeters) {
-        grid.emplace_back();
-        for (Real y = minY; y < maxY; y += cellSizeInMeters)
-            grid.back().push_back(createCell(x, y));
-        size += grid.back().size();
-    }
+    width = countCells(arenaLimits.GetMin().GetX(), arenaLimits.GetMax().GetX());
+    height = countCells(arenaLimits.GetMin().GetY(), arenaLimits.GetMax().GetY());
+    size = static_cast<int>(width * height);
+    concentrationDrop = 0;
+    tilesHeight = (height + tileSide - 1) / tileSide;
+    tiles.clear();
+    tiles.resize(static_cast<std::size_t>((width + tileSide - 1) / tileSide) * tilesHeight);
+}
+
+/* Cells are added while their corner is below the limit, as the grid always did, so layouts do not change */
+unsigned CoverageGrid::countCells(Real min, Real max) const {
+    unsigned cells = 0;
+    for (Real corner = min; corner < max; corner += cellSizeInMeters)
+        cells++;
+    return cells;
 }
 
-CoverageGrid::Cell CoverageGrid::createCell(Real x, Real y) const {
-    CVector3 leftUpperPoint(x, y + cellSizeInMeters, gridLiftOnZ);
-    CVector3 rightUpperPoint(x + cellSizeInMeters, y + cellSizeInMeters, gridLiftOnZ);
-    CVector3 leftLowerPoint(x, y, gridLiftOnZ);
-    CVector3 rightLowerPoint(x + cellSizeInMeters, y, gridLiftOnZ);
+const CoverageGrid::Tile* CoverageGrid::findTile(unsigned x, unsigned y) const {
+    return tiles[(x / tileSide) * tilesHeight + y / tileSide].get();
+}
 
-    Cell cell;
-    const auto centerOffset = cellSizeInMeters / 2;
-    cell.center = CVector3(x + centerOffset, y + centerOffset, gridLiftOnZ * 2);
-    cell.concentration = maxCellConcentration;
-    cell.edges.push_back(CRay3(leftUpperPoint, rightUpperPoint));
-    cell.edges.push_back(CRay3(rightUpperPoint, rightLowerPoint));
-    cell.edges.push_back(CRay3(rightLowerPoint, leftLowerPoint));
-    cell.edges.push_back(CRay3(leftLowerPoint, leftUpperPoint));
-    return cell;
+CoverageGrid::Tile& CoverageGrid::getTile(unsigned x, unsigned y) {
+    auto& tile = tiles[(x / tileSide) * tilesHeight + y / tileSide];
+    if (!tile) {
+        tile.reset(new Tile());
+        const unsigned tileX = x - x % tileSide;
+        const unsigned tileY = y - y % tileSide;
+        tile->cellsNumber = std::min(tileSide, width - tileX) * std::min(tileSide, height - tileY);
+        tile->coveredCells = coveringVisits == 0 ? tile->cellsNumber : 0;
+    }
+    return *tile;
 }
 
-std::vector<std::vector<CoverageGrid::Cell>>& CoverageGrid::getGrid() {
-    return grid;
+unsigned CoverageGrid::getWidth() const {
+    return width;
 }
 
-const std::vector<std::vector<CoverageGrid::Cell>>& CoverageGrid::getGrid() const {
-    return grid;
+unsigned CoverageGrid::getHeight() const {
+    return height;
+}
+
+CRange<CVector3> CoverageGrid::getExtent() const {
+    const auto& min = arenaLimits.GetMin();
+    return CRange<CVector3>(CVector3(min.GetX(), min.GetY(), gridLiftOnZ),
+                            CVector3(min.GetX() + width * cellSizeInMeters,
+                                     min.GetY() + height * cellSizeInMeters, gridLiftOnZ));
 }
 
 CoverageGrid::CellIndex CoverageGrid::getCellIndex(const CVector3& position) const {
@@ -57,14 +83,14 @@ CoverageGrid::CellIndex CoverageGrid::getCellIndex(const CVector3& position) con
         s << "Position (" << position << ") is outside area!";
         THROW_ARGOSEXCEPTION(s.str())
     }
-    unsigned translation = static_cast<unsigned>(grid.size() / 2);
-    unsigned x = static_cast<unsigned>(std::floor(position.GetX() / cellSizeInMeters) + translation);
-    unsigned y = static_cast<unsigned>(std::floor(position.GetY() / cellSizeInMeters) + translation);
-    if (x == grid.size())
+    const CVector2 coordinates = getCellCoordinates(position);
+    unsigned x = static_cast<unsigned>(std::floor(coordinates.GetX()));
+    unsigned y = static_cast<unsigned>(std::floor(coordinates.GetY()));
+    if (x == width)
         x--;
-    if (y == grid.size())
+    if (y == height)
         y--;
-    if (x >= grid.size() || y >= grid.size()) {
+    if (x >= width || y >= height) {
         std::stringstream s;
         s << "Bad cell index (" << x << "," << y << ") calculated for (" << position << ")";
         THROW_ARGOSEXCEPTION(s.str())
@@ -72,32 +98,145 @@ CoverageGrid::CellIndex CoverageGrid::getCellIndex(const CVector3& position) con
     return {x, y};
 }
 
-CoverageGrid::Cell& CoverageGrid::getCell(const CVector3& position) {
-    auto i = getCellIndex(position);
-    return grid.at(i.first).at(i.second);
+CVector2 CoverageGrid::getCellCoordinates(const CVector3& position) const {
+    return CVector2((position.GetX() - arenaLimits.GetMin().GetX()) / cellSizeInMeters,
+                    (position.GetY() - arenaLimits.GetMin().GetY()) / cellSizeInMeters);
 }
 
-const CoverageGrid::Cell& CoverageGrid::getCell(const CVector3& position) const {
-    auto i = getCellIndex(position);
-    return grid.at(i.first).at(i.second);
+CVector3 CoverageGrid::getCellCenter(const CellIndex& index) const {
+    return CVector3(arenaLimits.GetMin().GetX() + (index.first + 0.5) * cellSizeInMeters,
+                    arenaLimits.GetMin().GetY() + (index.second + 0.5) * cellSizeInMeters,
+                    gridLiftOnZ * 2);
 }
 
 const CoverageGrid::Meters CoverageGrid::getCellSize() const {
     return cellSizeInMeters;
 }
 
+CoverageGrid::Visits CoverageGrid::getVisits(const CellIndex& index) const {
+    const Tile* tile = findTile(index.first, index.second);
+    if (tile == nullptr)
+        return 0;
+    return tile->visits[(index.first % tileSide) * tileSide + index.second % tileSide];
+}
+
+int CoverageGrid::getConcentration(const CellIndex& index) const {
+    return concentrationLevels[getVisits(index)];
+}
+
+int CoverageGrid::getConcentrationLevel(Visits cellVisits) const {
+    return concentrationLevels[cellVisits];
+}
+
+CoverageGrid::TileState CoverageGrid::getTileState(const CellIndex& index) const {
+    const Tile* tile = findTile(index.first, index.second);
+    if (tile == nullptr)
+        return TileState::untouched;
+    return tile->coveredCells == tile->cellsNumber ? TileState::covered : TileState::partlyCovered;
+}
+
+std::size_t CoverageGrid::getAllocatedTilesNumber() const {
+    return std::count_if(tiles.begin(), tiles.end(), [](const std::unique_ptr<Tile>& tile) { return !!tile; });
+}
+
+std::vector<CoverageGrid::CellIndex> CoverageGrid::getCellsOnRays(const std::vector<CRay3>& rays) const {
+    std::vector<CellIndex> cells;
+    auto delta = cellSizeInMeters / 2;
+    for (auto ray : rays) {
+        auto rayLength = ray.GetLength();
+        while (rayLength > 0) {
+            try {
+                cells.emplace_back(getCellIndex(ray.GetEnd()));
+            }
+            catch(std::exception& e) {
+                std::stringstream s;
+                s << "Error during concentration update for ray end (" << ray.GetEnd() << ")";
+                THROW_ARGOSEXCEPTION_NESTED(s.str(), e);
+            }
+            rayLength = ray.GetLength() - delta;
+            ray.SetLength(rayLength);
+        }
+    }
+    std::sort(cells.begin(), cells.end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+    return cells;
+}
+
 const double CoverageGrid::getCoverageValue() {
-    double percentCoverage = 0;
-    double cellCoverage;
+    /* Cells with the same number of visits have the same coverage, cells of untouched tiles have none */
+    std::array<std::size_t, maxVisits + 1> cellsPerVisits{};
+    std::size_t coveredTilesCells = 0;
+    for (auto& tile : tiles) {
+        if (!tile)
+            continue;
+        if (tile->coveredCells == tile->cellsNumber) {
+            coveredTilesCells += tile->cellsNumber;
+            continue;
+        }
+        /* Cells of the tile outside of the grid are never visited and add nothing */
+        for (auto cellVisits : tile->visits)
+            cellsPerVisits[cellVisits]++;
+    }
     const double maxConcentration = static_cast<double>(maxCellConcentration);
     const double gridSize = static_cast<double>(size);
-    for (auto& row : grid) {
-        for (auto& cell : row) {
-            cellCoverage = (1 - (cell.concentration / maxConcentration)) * 100;
-            percentCoverage += cellCoverage / gridSize;
-        }
+    double percentCoverage = 100 * coveredTilesCells / gridSize;
+    for (unsigned i = 1; i <= maxVisits; i++) {
+        const double cellCoverage = (1 - (concentrationLevels[i] / maxConcentration)) * 100;
+        percentCoverage += cellCoverage * cellsPerVisits[i] / gridSize;
     }
     return percentCoverage;
 }
 
+void CoverageGrid::visitCell(const CellIndex& index) {
+    visitRow(index.first, index.second, index.second + 1);
+}
+
+void CoverageGrid::visitSpans(std::vector<Span>& spans) {
+    std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) {
+        return a.x < b.x || (a.x == b.x && a.yBegin < b.yBegin);
+    });
+    /* Overlapping or touching spans of a column are visited as one row */
+    for (std::size_t i = 0; i < spans.size();) {
+        const unsigned x = spans[i].x;
+        const unsigned yBegin = spans[i].yBegin;
+        unsigned yEnd = spans[i].yEnd;
+        for (i++; i < spans.size() && spans[i].x == x && spans[i].yBegin <= yEnd; i++)
+            yEnd = std::max(yEnd, spans[i].yEnd);
+        visitRow(x, yBegin, yEnd);
+    }
+}
 
+void CoverageGrid::visitRow(unsigned x, unsigned yBegin, unsigned yEnd) {
+    /* One tile at a time, the cells of a column are contiguous in a tile */
+    for (unsigned tileBegin = yBegin; tileBegin < yEnd;) {
+        const unsigned tileEnd = std::min(yEnd, (tileBegin / tileSide + 1) * tileSide);
+        Tile& tile = getTile(x, tileBegin);
+        Visits* column = &tile.visits[(x % tileSide) * tileSide + tileBegin % tileSide];
+        const unsigned length = tileEnd - tileBegin;
+        long long drop = 0;
+        unsigned covered = 0;
+        for (unsigned i = 0; i < length; i++) {
+            drop += concentrationDrops[column[i]];
+            covered += column[i] + 1u == coveringVisits;
+        }
+        concentrationDrop += drop;
+        tile.coveredCells += covered;
+        /* A saturating byte increment, which the compiler vectorizes */
+        for (unsigned i = 0; i < length; i++)
+            column[i] = static_cast<Visits>(std::min<unsigned>(column[i] + 1u, maxVisits));
+        tileBegin = tileEnd;
+    }
+    if (recorder != nullptr)
+        for (unsigned y = yBegin; y < yEnd; y++)
+            recorder->markChanged({x, y});
+}
+
+double CoverageGrid::getVisitedCoverageValue() const {
+    if (size == 0)
+        return 0;
+    return concentrationDrop / (static_cast<double>(maxCellConcentration) * size) * 100;
+}
+
+void CoverageGrid::setRecorder(CoverageRecorder* recorder) {
+    this->recorder = recorder;
+}
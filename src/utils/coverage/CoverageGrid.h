@@ -1,33 +1,109 @@
 #pragma once
 
-#include "CoverageCell.h"
 #include <argos3/core/utility/math/range.h>
+#include <argos3/core/utility/math/ray3.h>
+#include <argos3/core/utility/math/vector2.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
+class CoverageRecorder;
+
+/*
+ * Coverage of a rectangular arena split into square cells, cell (0, 0) has its corner at the arena minimum. Cells are
+ * stored in tiles of tileSide x tileSide, a tile is allocated at the first visit of one of its cells, so the parts of
+ * the arena robots never reach cost no memory.
+ */
 class CoverageGrid {
 public:
-    using Cell = CoverageCell;
     using Meters = argos::Real;
     using CellIndex = std::pair<unsigned, unsigned>;
+    using Visits = std::uint8_t;
+
+    /* Cells [yBegin, yEnd) of column x */
+    struct Span {
+        unsigned x;
+        unsigned yBegin;
+        unsigned yEnd;
+    };
+
+    enum class TileState {
+        untouched,
+        partlyCovered,
+        covered
+    };
+
+    /*
+     * Cells store how many times they were visited, the concentration is maxCellConcentration halved once per visit.
+     * Every int is 0 after 31 halvings, so counting further visits would not change it.
+     */
+    static constexpr Visits maxVisits = 31;
+    static constexpr unsigned tileSide = 64;
 
     const int maxCellConcentration;
 
     CoverageGrid(int maxCellConcentration, argos::Real cellSizeInMeters = 0.05f, argos::Real gridLiftOnZ = 0.01f);
     void initGrid(argos::CRange<argos::CVector3> limits);
-    std::vector<std::vector<Cell>>& getGrid();
-    const std::vector<std::vector<Cell>>& getGrid() const;
+    /* Number of cells along x and y */
+    unsigned getWidth() const;
+    unsigned getHeight() const;
+    /* Corners of the grid, on the plane it is drawn on */
+    argos::CRange<argos::CVector3> getExtent() const;
     CellIndex getCellIndex(const argos::CVector3& position) const;
-    Cell& getCell(const argos::CVector3& position);
-    const Cell& getCell(const argos::CVector3& position) const;
+    /* Position in cell units, getCellIndex is its floor for positions inside the arena */
+    argos::CVector2 getCellCoordinates(const argos::CVector3& position) const;
+    argos::CVector3 getCellCenter(const CellIndex& index) const;
     const Meters getCellSize() const;
+    Visits getVisits(const CellIndex& index) const;
+    int getConcentration(const CellIndex& index) const;
+    /* Concentration of a cell visited the given number of times */
+    int getConcentrationLevel(Visits cellVisits) const;
+    /* State of the tile of a cell, covered when all its cells have concentration 0 */
+    TileState getTileState(const CellIndex& index) const;
+    std::size_t getAllocatedTilesNumber() const;
+    /* Cells under the rays, sampled every half cell back from the ray ends, without duplicates */
+    std::vector<CellIndex> getCellsOnRays(const std::vector<argos::CRay3>& rays) const;
 
     const double getCoverageValue();
 
+    /* Halves the concentration of a cell and keeps the coverage sum up to date */
+    void visitCell(const CellIndex& index);
+    /* Visits every cell the spans cover once, the spans are sorted and merged in place */
+    void visitSpans(std::vector<Span>& spans);
+    /* Coverage of a grid changed only by visitCell, without scanning all cells */
+    double getVisitedCoverageValue() const;
+    /* Reports cells changed by visitCell to the recorder, nullptr detaches it */
+    void setRecorder(CoverageRecorder* recorder);
+
 private:
+    struct Tile {
+        /* Indexed x * tileSide + y, relative to the tile corner */
+        std::array<Visits, tileSide * tileSide> visits{};
+        /* Cells of the tile inside the grid, and those of them with concentration 0 */
+        unsigned cellsNumber = 0;
+        unsigned coveredCells = 0;
+    };
+
     const Meters cellSizeInMeters;
     const argos::Real gridLiftOnZ;
     int size;
-    std::vector<std::vector<Cell>> grid;
+    unsigned width = 0;
+    unsigned height = 0;
+    unsigned tilesHeight = 0;
+    double concentrationDrop = 0;
+    CoverageRecorder* recorder = nullptr;
+    /* Indexed tileX * tilesHeight + tileY, nullptr until the tile is visited */
+    std::vector<std::unique_ptr<Tile>> tiles;
+    /* Concentration after n visits, and how much the next visit lowers it */
+    std::array<int, maxVisits + 1> concentrationLevels;
+    std::array<int, maxVisits + 1> concentrationDrops;
+    /* Visits after which the concentration is 0 */
+    Visits coveringVisits;
     argos::CRange<argos::CVector3> arenaLimits;
 
-    Cell createCell(argos::Real x, argos::Real y) const;
+    unsigned countCells(argos::Real min, argos::Real max) const;
+    const Tile* findTile(unsigned x, unsigned y) const;
+    Tile& getTile(unsigned x, unsigned y);
+    void visitRow(unsigned x, unsigned yBegin, unsigned yEnd);
 };
@@ -0,0 +1,183 @@
+#include "CoverageRecorder.h"
+#include <algorithm>
+#include <cerrno>
+
+using namespace argos;
+using namespace CoverageRecording;
+
+CoverageRecorder::~CoverageRecorder() {
+    try {
+        close();
+    }
+    catch (CARGoSException&) {
+        /* Nothing more can be saved at this point */
+    }
+}
+
+void CoverageRecorder::open(const Config& config, CoverageGrid& grid) {
+    close();
+    if (config.frameInterval == 0 || config.keyframeInterval == 0)
+        THROW_ARGOSEXCEPTION("Heatmap frame and keyframe intervals have to be positive");
+    if (grid.getWidth() == 0 || grid.getHeight() == 0)
+        THROW_ARGOSEXCEPTION("Heatmap of an empty coverage grid");
+
+    path = config.path;
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        THROW_ARGOSEXCEPTION("Cannot open heatmap " << path << ": " << std::strerror(errno));
+
+    const auto& origin = grid.getExtent().GetMin();
+    header.width = grid.getWidth();
+    header.height = grid.getHeight();
+    header.cellSize = grid.getCellSize();
+    header.minX = origin.GetX();
+    header.minY = origin.GetY();
+    header.maxConcentration = grid.maxCellConcentration;
+    header.frameInterval = config.frameInterval;
+    header.keyframeInterval = config.keyframeInterval;
+
+    this->grid = &grid;
+    changedFlags.assign(static_cast<std::size_t>(header.width) * header.height, 0);
+    changedCells.clear();
+    keyframes.clear();
+    offset = 0;
+    framesNumber = 0;
+    lastFrameStep = 0;
+    lastStep = 0;
+
+    buffer.assign(magic.begin(), magic.end());
+    putFixed(buffer, version);
+    putFixed(buffer, std::uint16_t(0));
+    putFixed(buffer, header.width);
+    putFixed(buffer, header.height);
+    putFixed(buffer, header.cellSize);
+    putFixed(buffer, header.minX);
+    putFixed(buffer, header.minY);
+    putFixed(buffer, header.maxConcentration);
+    putFixed(buffer, header.frameInterval);
+    putFixed(buffer, header.keyframeInterval);
+    write(buffer);
+
+    grid.setRecorder(this);
+    writeFrame(0);
+}
+
+void CoverageRecorder::close() {
+    if (file == nullptr)
+        return;
+    if (!changedCells.empty())
+        writeFrame(lastStep);
+    grid->setRecorder(nullptr);
+    grid = nullptr;
+
+    buffer.clear();
+    const auto indexOffset = offset;
+    for (auto& keyframe : keyframes) {
+        putFixed(buffer, keyframe.step);
+        putFixed(buffer, keyframe.offset);
+    }
+    putFixed(buffer, static_cast<std::uint32_t>(keyframes.size()));
+    putFixed(buffer, indexOffset);
+    buffer.insert(buffer.end(), indexMagic.begin(), indexMagic.end());
+    write(buffer);
+
+    std::fclose(file);
+    file = nullptr;
+}
+
+void CoverageRecorder::markChanged(const CoverageGrid::CellIndex& index) {
+    const auto cell = index.first * header.height + index.second;
+    if (changedFlags[cell] == 0) {
+        changedFlags[cell] = 1;
+        changedCells.push_back(cell);
+    }
+}
+
+void CoverageRecorder::update(std::uint32_t step) {
+    if (file == nullptr)
+        return;
+    lastStep = step;
+    if (step - lastFrameStep < header.frameInterval)
+        return;
+    writeFrame(step);
+}
+
+int CoverageRecorder::getConcentration(std::uint32_t cell) const {
+    return grid->getConcentration({cell / header.height, cell % header.height});
+}
+
+void CoverageRecorder::writeFrame(std::uint32_t step) {
+    const bool isKeyframe = framesNumber % header.keyframeInterval == 0;
+    if (isKeyframe)
+        keyframes.push_back({step, offset});
+
+    buffer.assign(frameHeaderSize, 0);
+    buffer[0] = static_cast<std::uint8_t>(isKeyframe ? FrameType::Key : FrameType::Delta);
+    if (isKeyframe)
+        encodeKeyframe();
+    else
+        encodeDeltaFrame();
+    const auto payloadSize = static_cast<std::uint32_t>(buffer.size() - frameHeaderSize);
+    for (int i = 0; i < 4; i++) {
+        buffer[1 + i] = static_cast<std::uint8_t>(step >> (8 * i));
+        buffer[5 + i] = static_cast<std::uint8_t>(payloadSize >> (8 * i));
+    }
+    write(buffer);
+
+    for (auto cell : changedCells)
+        changedFlags[cell] = 0;
+    changedCells.clear();
+    framesNumber++;
+    lastFrameStep = step;
+}
+
+void CoverageRecorder::encodeKeyframe() {
+    std::uint32_t length = 0;
+    int value = 0;
+    for (std::uint32_t cell = 0; cell < header.width * header.height; cell++) {
+        const auto concentration = getConcentration(cell);
+        if (length > 0 && concentration == value) {
+            length++;
+            continue;
+        }
+        if (length > 0) {
+            putVarint(buffer, length);
+            putVarint(buffer, zigzag(value));
+        }
+        value = concentration;
+        length = 1;
+    }
+    putVarint(buffer, length);
+    putVarint(buffer, zigzag(value));
+}
+
+void CoverageRecorder::encodeDeltaFrame() {
+    std::sort(changedCells.begin(), changedCells.end());
+    std::vector<std::uint8_t> runs;
+    std::uint32_t runsNumber = 0;
+    std::uint32_t previousEnd = 0;
+    std::size_t i = 0;
+    while (i < changedCells.size()) {
+        const auto runBegin = changedCells[i];
+        const auto value = getConcentration(runBegin);
+        auto runEnd = runBegin + 1;
+        i++;
+        while (i < changedCells.size() && changedCells[i] == runEnd && getConcentration(runEnd) == value) {
+            runEnd++;
+            i++;
+        }
+        putVarint(runs, runBegin - previousEnd);
+        putVarint(runs, runEnd - runBegin);
+        putVarint(runs, zigzag(value));
+        previousEnd = runEnd;
+        runsNumber++;
+    }
+    putVarint(buffer, runsNumber);
+    buffer.insert(buffer.end(), runs.begin(), runs.end());
+}
+
+void CoverageRecorder::write(const std::vector<std::uint8_t>& bytes) {
+    if (std::fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size())
+        THROW_ARGOSEXCEPTION("Cannot write heatmap " << path << ": " << std::strerror(errno));
+    offset += bytes.size();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoverageGrid.h"
+#include "CoverageRecording.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*
+ * Records the concentration field of a CoverageGrid every frameInterval
+ * steps. The grid reports cells changed by visitCell, so a delta frame costs
+ * only as much as the cells visited since the previous frame. Every
+ * keyframeInterval-th frame is a full keyframe, which makes the recording
+ * seekable.
+ */
+class CoverageRecorder {
+public:
+    struct Config {
+        std::string path;
+        std::uint32_t frameInterval = 10;
+        std::uint32_t keyframeInterval = 50;
+    };
+
+    CoverageRecorder() = default;
+    CoverageRecorder(const CoverageRecorder&) = delete;
+    CoverageRecorder& operator=(const CoverageRecorder&) = delete;
+    ~CoverageRecorder();
+
+    /* Starts recording the grid, which has to be initialized already */
+    void open(const Config& config, CoverageGrid& grid);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    void markChanged(const CoverageGrid::CellIndex& index);
+    /* Writes a frame if frameInterval steps passed since the last one */
+    void update(std::uint32_t step);
+
+private:
+    std::FILE* file = nullptr;
+    std::string path;
+    CoverageGrid* grid = nullptr;
+    CoverageRecording::Header header;
+    std::vector<std::uint8_t> buffer;
+    std::vector<std::uint8_t> changedFlags;
+    std::vector<std::uint32_t> changedCells;
+    std::vector<CoverageRecording::Keyframe> keyframes;
+    std::uint64_t offset = 0;
+    std::uint32_t framesNumber = 0;
+    std::uint32_t lastFrameStep = 0;
+    std::uint32_t lastStep = 0;
+
+    int getConcentration(std::uint32_t cell) const;
+    void writeFrame(std::uint32_t step);
+    void encodeKeyframe();
+    void encodeDeltaFrame();
+    void write(const std::vector<std::uint8_t>& bytes);
+};
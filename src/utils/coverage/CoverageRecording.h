@@ -0,0 +1,66 @@
+#pragma once
+
+#include <utils/log/Encoding.h>
+#include <array>
+#include <cstdint>
+
+/*
+ * Coverage heatmap recording format.
+ *
+ * Header, 52 bytes:
+ *     "CSHM" | uint16 version | uint16 reserved | uint32 width | uint32 height |
+ *     double cell size | double min x | double min y | int32 max concentration |
+ *     uint32 frame interval | uint32 keyframe interval
+ *
+ * Frames follow the header:
+ *     uint8 frame type | uint32 step | uint32 payload size | payload
+ *
+ * Cells are numbered x * height + y. A keyframe holds all cells as runs of
+ * (varint length, zigzag varint concentration). A delta frame holds the
+ * cells changed since the previous frame: varint number of runs, then runs
+ * of consecutive cells with equal concentration as (varint gap from the end
+ * of the previous run, varint length, zigzag varint concentration).
+ *
+ * A closed recording ends with the keyframe index, (uint32 step, uint64
+ * offset) per keyframe, and a 16 byte footer: uint32 keyframes number |
+ * uint64 index offset | "CSHI". A recording that was cut off has no index
+ * and is read frame by frame.
+ */
+namespace CoverageRecording {
+
+static constexpr std::array<char, 4> magic = {{'C', 'S', 'H', 'M'}};
+static constexpr std::array<char, 4> indexMagic = {{'C', 'S', 'H', 'I'}};
+static constexpr std::uint16_t version = 1;
+static constexpr std::size_t headerSize = 52;
+static constexpr std::size_t frameHeaderSize = 9;
+static constexpr std::size_t footerSize = 16;
+
+enum class FrameType : std::uint8_t {
+    Key = 0,
+    Delta = 1
+};
+
+struct Header {
+    std::uint32_t width;
+    std::uint32_t height;
+    double cellSize;
+    double minX;
+    double minY;
+    std::int32_t maxConcentration;
+    std::uint32_t frameInterval;
+    std::uint32_t keyframeInterval;
+};
+
+struct Keyframe {
+    std::uint32_t step;
+    std::uint64_t offset;
+};
+
+using Encoding::zigzag;
+using Encoding::unzigzag;
+using Encoding::putVarint;
+using Encoding::getVarint;
+using Encoding::putFixed;
+using Encoding::getFixed;
+
+}
@@ -0,0 +1,160 @@
+#include "CoverageRecordingReader.h"
+#include <argos3/core/utility/configuration/argos_exception.h>
+#include <algorithm>
+#include <iterator>
+
+using namespace CoverageRecording;
+
+CoverageRecordingReader::CoverageRecordingReader(const std::string& path)
+    : file(path, std::ios::binary)
+    , path(path)
+{
+    if (!file)
+        THROW_ARGOSEXCEPTION("Cannot open heatmap " << path);
+    readHeader();
+    readIndex();
+    concentrations.assign(static_cast<std::size_t>(header.width) * header.height, header.maxConcentration);
+    file.seekg(headerSize);
+}
+
+void CoverageRecordingReader::readHeader() {
+    std::uint8_t bytes[headerSize];
+    if (!file.read(reinterpret_cast<char*>(bytes), headerSize) || !std::equal(magic.begin(), magic.end(), bytes))
+        THROW_ARGOSEXCEPTION(path << " is not a heatmap recording");
+    const auto fileVersion = getFixed<std::uint16_t>(bytes + 4);
+    if (fileVersion != version)
+        THROW_ARGOSEXCEPTION("Heatmap " << path << " has unsupported version " << fileVersion);
+    header.width = getFixed<std::uint32_t>(bytes + 8);
+    header.height = getFixed<std::uint32_t>(bytes + 12);
+    header.cellSize = getFixed<double>(bytes + 16);
+    header.minX = getFixed<double>(bytes + 24);
+    header.minY = getFixed<double>(bytes + 32);
+    header.maxConcentration = getFixed<std::int32_t>(bytes + 40);
+    header.frameInterval = getFixed<std::uint32_t>(bytes + 44);
+    header.keyframeInterval = getFixed<std::uint32_t>(bytes + 48);
+}
+
+void CoverageRecordingReader::readIndex() {
+    file.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<std::uint64_t>(file.tellg());
+    framesEnd = fileSize;
+    if (fileSize < headerSize + footerSize)
+        return;
+
+    std::uint8_t footer[footerSize];
+    file.seekg(fileSize - footerSize);
+    if (!file.read(reinterpret_cast<char*>(footer), footerSize) ||
+        !std::equal(indexMagic.begin(), indexMagic.end(), footer + 12))
+        return;
+    const auto keyframesNumber = getFixed<std::uint32_t>(footer);
+    const auto indexOffset = getFixed<std::uint64_t>(footer + 4);
+    if (indexOffset < headerSize || indexOffset + keyframesNumber * 12ull + footerSize != fileSize)
+        THROW_ARGOSEXCEPTION("Heatmap " << path << " has a damaged keyframe index");
+
+    std::vector<std::uint8_t> index(keyframesNumber * 12ull);
+    file.seekg(indexOffset);
+    file.read(reinterpret_cast<char*>(index.data()), index.size());
+    for (std::size_t i = 0; i < keyframesNumber; i++)
+        keyframes.push_back({getFixed<std::uint32_t>(&index[i * 12]), getFixed<std::uint64_t>(&index[i * 12 + 4])});
+    framesEnd = indexOffset;
+    indexed = true;
+}
+
+bool CoverageRecordingReader::readFrame(FrameType& type, std::uint32_t& frameStep) {
+    const auto position = static_cast<std::uint64_t>(file.tellg());
+    if (!file || position + frameHeaderSize > framesEnd)
+        return false;
+    std::uint8_t bytes[frameHeaderSize];
+    if (!file.read(reinterpret_cast<char*>(bytes), frameHeaderSize))
+        return false;
+    type = static_cast<FrameType>(bytes[0]);
+    frameStep = getFixed<std::uint32_t>(bytes + 1);
+    const auto payloadSize = getFixed<std::uint32_t>(bytes + 5);
+    if (position + frameHeaderSize + payloadSize > framesEnd)
+        return false;
+    payload.resize(payloadSize);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(payload.data()), payloadSize));
+}
+
+bool CoverageRecordingReader::next() {
+    FrameType type;
+    std::uint32_t frameStep;
+    if (!readFrame(type, frameStep))
+        return false;
+    applyFrame(type, frameStep);
+    return true;
+}
+
+void CoverageRecordingReader::applyFrame(FrameType type, std::uint32_t frameStep) {
+    if (type == FrameType::Key)
+        decodeKeyframe();
+    else if (type == FrameType::Delta)
+        decodeDeltaFrame();
+    else
+        THROW_ARGOSEXCEPTION("Heatmap " << path << " has a frame of unknown type " << static_cast<int>(type));
+    step = frameStep;
+}
+
+bool CoverageRecordingReader::seek(std::uint32_t target) {
+    std::uint64_t offset = headerSize;
+    if (indexed) {
+        auto keyframe = std::upper_bound(keyframes.begin(), keyframes.end(), target,
+                                         [](std::uint32_t s, const Keyframe& k) { return s < k.step; });
+        if (keyframe == keyframes.begin())
+            return false;
+        offset = std::prev(keyframe)->offset;
+    }
+    file.clear();
+    file.seekg(offset);
+
+    bool found = false;
+    while (true) {
+        const auto position = file.tellg();
+        FrameType type;
+        std::uint32_t frameStep;
+        if (!readFrame(type, frameStep))
+            break;
+        if (frameStep > target) {
+            file.clear();
+            file.seekg(position);
+            break;
+        }
+        applyFrame(type, frameStep);
+        found = true;
+    }
+    file.clear();
+    return found;
+}
+
+void CoverageRecordingReader::decodeKeyframe() {
+    const std::uint8_t* bytes = payload.data();
+    const std::uint8_t* end = bytes + payload.size();
+    std::size_t cell = 0;
+    while (bytes < end) {
+        std::uint64_t length, value;
+        if (!getVarint(bytes, end, length) || !getVarint(bytes, end, value) || cell + length > concentrations.size())
+            THROW_ARGOSEXCEPTION("Heatmap " << path << " has a damaged keyframe");
+        std::fill_n(concentrations.begin() + cell, length, unzigzag(static_cast<std::uint32_t>(value)));
+        cell += length;
+    }
+    if (cell != concentrations.size())
+        THROW_ARGOSEXCEPTION("Heatmap " << path << " has an incomplete keyframe");
+}
+
+void CoverageRecordingReader::decodeDeltaFrame() {
+    const std::uint8_t* bytes = payload.data();
+    const std::uint8_t* end = bytes + payload.size();
+    std::uint64_t runsNumber;
+    if (!getVarint(bytes, end, runsNumber))
+        THROW_ARGOSEXCEPTION("Heatmap " << path << " has a damaged delta frame");
+    std::size_t cell = 0;
+    for (std::uint64_t i = 0; i < runsNumber; i++) {
+        std::uint64_t gap, length, value;
+        if (!getVarint(bytes, end, gap) || !getVarint(bytes, end, length) || !getVarint(bytes, end, value) ||
+            cell + gap + length > concentrations.size())
+            THROW_ARGOSEXCEPTION("Heatmap " << path << " has a damaged delta frame");
+        cell += gap;
+        std::fill_n(concentrations.begin() + cell, length, unzigzag(static_cast<std::uint32_t>(value)));
+        cell += length;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoverageRecording.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+ * Replays a coverage heatmap recording. Concentrations are kept in a single
+ * vector indexed by x * height + y, the way the recorder numbers cells.
+ */
+class CoverageRecordingReader {
+public:
+    explicit CoverageRecordingReader(const std::string& path);
+
+    const CoverageRecording::Header& getHeader() const { return header; }
+    const std::vector<CoverageRecording::Keyframe>& getKeyframes() const { return keyframes; }
+    bool hasIndex() const { return indexed; }
+
+    /* Applies the next frame, false at the end of the recording */
+    bool next();
+    /* Moves to the last frame at or before the step */
+    bool seek(std::uint32_t step);
+
+    std::uint32_t getStep() const { return step; }
+    const std::vector<int>& getConcentrations() const { return concentrations; }
+
+private:
+    std::ifstream file;
+    std::string path;
+    CoverageRecording::Header header;
+    std::vector<CoverageRecording::Keyframe> keyframes;
+    bool indexed = false;
+    std::uint64_t framesEnd = 0;
+    std::vector<int> concentrations;
+    std::vector<std::uint8_t> payload;
+    std::uint32_t step = 0;
+
+    void readHeader();
+    void readIndex();
+    bool readFrame(CoverageRecording::FrameType& type, std::uint32_t& frameStep);
+    void applyFrame(CoverageRecording::FrameType type, std::uint32_t frameStep);
+    void decodeKeyframe();
+    void decodeDeltaFrame();
+};
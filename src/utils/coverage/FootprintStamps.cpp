@@ -0,0 +1,83 @@
+#include "FootprintStamps.h"
+#include <argos3/core/utility/math/angles.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace argos;
+
+void FootprintStamps::init(const std::vector<Trajectory::Point>& footprint, Real cellSize,
+                           unsigned headings, unsigned offsets) {
+    if (headings == 0 || offsets == 0)
+        THROW_ARGOSEXCEPTION("Footprint stamps need at least one heading and one offset");
+    this->headings = headings;
+    this->offsets = offsets;
+    stamps.clear();
+    stamps.reserve(headings * offsets * offsets);
+    for (unsigned h = 0; h < headings; h++) {
+        const double yaw = 2 * ARGOS_PI * h / headings;
+        /* Each stamp is sampled from the middle of its sub-cell */
+        for (unsigned ox = 0; ox < offsets; ox++)
+            for (unsigned oy = 0; oy < offsets; oy++)
+                stamps.push_back(sampleRays(footprint, cellSize, yaw,
+                                            (ox + 0.5) / offsets, (oy + 0.5) / offsets));
+    }
+}
+
+std::vector<FootprintStamps::Span> FootprintStamps::sampleRays(const std::vector<Trajectory::Point>& footprint,
+                                                               Real cellSize, double yaw,
+                                                               double startX, double startY) {
+    /* Same sampling as CoverageGrid::getCellsOnRays, every half cell back from the ray end */
+    const double cosYaw = std::cos(yaw);
+    const double sinYaw = std::sin(yaw);
+    std::vector<std::pair<int, int>> cells;
+    for (auto& point : footprint) {
+        const double endX = (point[0] * cosYaw - point[1] * sinYaw) / cellSize;
+        const double endY = (point[0] * sinYaw + point[1] * cosYaw) / cellSize;
+        const double length = std::sqrt(endX * endX + endY * endY);
+        for (double l = length; l > 0; l -= 0.5) {
+            const double scale = l / length;
+            cells.emplace_back(static_cast<int>(std::floor(startX + endX * scale)),
+                               static_cast<int>(std::floor(startY + endY * scale)));
+        }
+    }
+    std::sort(cells.begin(), cells.end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+    std::vector<Span> spans;
+    for (auto& cell : cells) {
+        if (!spans.empty() && spans.back().x == cell.first && spans.back().yEnd == cell.second)
+            spans.back().yEnd++;
+        else
+            spans.push_back({cell.first, cell.second, cell.second + 1});
+    }
+    return spans;
+}
+
+const std::vector<FootprintStamps::Span>& FootprintStamps::getStamp(double yaw, double cellX, double cellY) const {
+    const double turns = yaw / (2 * ARGOS_PI);
+    const unsigned heading = static_cast<unsigned>(std::lround((turns - std::floor(turns)) * headings)) % headings;
+    const unsigned ox = std::min(offsets - 1, static_cast<unsigned>((cellX - std::floor(cellX)) * offsets));
+    const unsigned oy = std::min(offsets - 1, static_cast<unsigned>((cellY - std::floor(cellY)) * offsets));
+    return stamps[(heading * offsets + ox) * offsets + oy];
+}
+
+void FootprintStamps::addSpans(const CoverageGrid& grid, const Trajectory::Pose& pose,
+                               std::vector<CoverageGrid::Span>& spans) const {
+    const int width = static_cast<int>(grid.getWidth());
+    const int height = static_cast<int>(grid.getHeight());
+    if (width == 0)
+        return;
+    const CVector2 coordinates = grid.getCellCoordinates(CVector3(pose.x, pose.y, 0));
+    const int x = static_cast<int>(std::floor(coordinates.GetX()));
+    const int y = static_cast<int>(std::floor(coordinates.GetY()));
+    for (auto& span : getStamp(pose.yaw, coordinates.GetX(), coordinates.GetY())) {
+        const int column = x + span.x;
+        if (column < 0 || column >= width)
+            continue;
+        const int yBegin = std::max(0, y + span.yBegin);
+        const int yEnd = std::min(height, y + span.yEnd);
+        if (yBegin < yEnd)
+            spans.push_back({static_cast<unsigned>(column), static_cast<unsigned>(yBegin),
+                             static_cast<unsigned>(yEnd)});
+    }
+}
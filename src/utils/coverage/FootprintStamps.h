@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoverageGrid.h"
+#include <utils/log/Trajectory.h>
+#include <vector>
+
+/*
+ * Cells covered by the coverage rays of a robot, precomputed for quantized
+ * headings and positions inside a cell.
+ *
+ * CoverageGrid::getCellsOnRays samples every ray back from its end, for every
+ * robot at every step. The covered cells only depend on the heading of the
+ * robot and on where it stands inside its cell, so the same sampling is done
+ * once per heading and sub-cell offset at init, and stored as spans of cells
+ * relative to the cell of the robot. A step then only looks up the closest
+ * stamp of each pose. Because of the quantization, stamps can differ from the
+ * ray sampling by one cell at the footprint boundary.
+ */
+class FootprintStamps {
+public:
+    static constexpr unsigned defaultHeadings = 64;
+    static constexpr unsigned defaultOffsets = 8;
+
+    /* Cells [yBegin, yEnd) of column x, relative to the cell of the robot */
+    struct Span {
+        int x;
+        int yBegin;
+        int yEnd;
+    };
+
+    /*
+     * footprint holds the ray ends in the robot frame, as in the trajectory header.
+     * offsets is the number of sub-cell positions along each axis.
+     */
+    void init(const std::vector<Trajectory::Point>& footprint, argos::Real cellSize,
+              unsigned headings = defaultHeadings, unsigned offsets = defaultOffsets);
+    bool empty() const { return stamps.empty(); }
+
+    /* Stamp of a robot with the given yaw, at the given position in cell units */
+    const std::vector<Span>& getStamp(double yaw, double cellX, double cellY) const;
+    /* Appends the spans of grid cells covered at the pose, clipped to the grid */
+    void addSpans(const CoverageGrid& grid, const Trajectory::Pose& pose,
+                  std::vector<CoverageGrid::Span>& spans) const;
+
+private:
+    unsigned headings = 0;
+    unsigned offsets = 0;
+    /* Indexed by (heading * offsets + offset on x) * offsets + offset on y */
+    std::vector<std::vector<Span>> stamps;
+
+    static std::vector<Span> sampleRays(const std::vector<Trajectory::Point>& footprint, argos::Real cellSize,
+                                        double yaw, double startX, double startY);
+};
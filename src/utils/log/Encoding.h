@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/* Little-endian and varint encoding shared by the binary recordings */
+namespace Encoding {
+
+inline std::uint32_t zigzag(std::int32_t value) {
+    return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+}
+
+inline std::int32_t unzigzag(std::uint32_t value) {
+    return static_cast<std::int32_t>(value >> 1) ^ -static_cast<std::int32_t>(value & 1);
+}
+
+inline void putVarint(std::vector<std::uint8_t>& bytes, std::uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+/* Returns false if the varint does not end before `end` */
+inline bool getVarint(const std::uint8_t*& bytes, const std::uint8_t* end, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; bytes < end && shift < 64; shift += 7) {
+        auto byte = *bytes++;
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+template <typename T>
+void putFixed(std::vector<std::uint8_t>& bytes, T value) {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    for (std::size_t i = 0; i < sizeof(T); i++)
+        bytes.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+}
+
+template <typename T>
+T getFixed(const std::uint8_t* bytes) {
+    std::uint64_t bits = 0;
+    for (std::size_t i = 0; i < sizeof(T); i++)
+        bits |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Binary run log format.
+ *
+ * The file starts with a header: the "CSRL" magic, a 16-bit format version
+ * and a 16-bit mask of the sections the JSON export has to contain. It is
+ * followed by records appended during the run:
+ *
+ *     uint32 payload size | uint32 step | uint8 event type | payload
+ *
+ * All numbers are little-endian, reals are IEEE 754 doubles. A run that was
+ * cut off leaves at most one incomplete record at the end, which readers skip.
+ */
+namespace RunLog {
+
+static constexpr std::array<char, 4> magic = {{'C', 'S', 'R', 'L'}};
+static constexpr std::uint16_t version = 1;
+static constexpr std::size_t headerSize = 8;
+static constexpr std::size_t recordHeaderSize = 9;
+/* Larger sizes can only come from a damaged file */
+static constexpr std::uint32_t maxPayloadSize = 1 << 20;
+
+enum class EventType : std::uint8_t {
+    Target = 1,          // int32 id, 3 x double position
+    Threshold = 2,       // double coverage [%]
+    ClosestDistance = 3  // double distance [m]
+};
+
+using Sections = std::uint16_t;
+
+inline Sections section(EventType type) {
+    return static_cast<Sections>(1u << static_cast<unsigned>(type));
+}
+
+struct Record {
+    std::uint32_t step;
+    EventType type;
+    std::vector<std::uint8_t> payload;
+};
+
+struct Target {
+    std::uint32_t step;
+    std::int32_t id;
+    std::array<double, 3> position;
+};
+
+struct Threshold {
+    std::uint32_t step;
+    double coverage;
+};
+
+struct ClosestDistance {
+    std::uint32_t step;
+    double distance;
+};
+
+}
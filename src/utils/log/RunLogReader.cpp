@@ -0,0 +1,161 @@
+#include "RunLogReader.h"
+#include <argos3/core/utility/configuration/argos_exception.h>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace RunLog;
+
+namespace {
+
+uint32_t getUInt32(const uint8_t* bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++)
+        value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+    return value;
+}
+
+double getDouble(const uint8_t* bytes) {
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++)
+        bits |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void checkPayloadSize(const Record& record, size_t size) {
+    if (record.payload.size() < size)
+        THROW_ARGOSEXCEPTION("Run log record of type " << static_cast<unsigned>(record.type)
+                             << " has " << record.payload.size() << " bytes, expected " << size);
+}
+
+}
+
+RunLogReader::RunLogReader(const string& path)
+    : file(path, ios::binary)
+    , path(path)
+{
+    if (!file)
+        THROW_ARGOSEXCEPTION("Cannot open run log " << path);
+    uint8_t header[headerSize];
+    if (!file.read(reinterpret_cast<char*>(header), headerSize) ||
+        !equal(magic.begin(), magic.end(), header))
+        THROW_ARGOSEXCEPTION(path << " is not a run log");
+    auto fileVersion = static_cast<uint16_t>(header[4] | header[5] << 8);
+    if (fileVersion != version)
+        THROW_ARGOSEXCEPTION("Run log " << path << " has unsupported version " << fileVersion);
+    sections = static_cast<Sections>(header[6] | header[7] << 8);
+}
+
+bool RunLogReader::next(Record& record) {
+    uint8_t header[recordHeaderSize];
+    if (!file.read(reinterpret_cast<char*>(header), recordHeaderSize))
+        return false;
+    auto payloadSize = getUInt32(header);
+    if (payloadSize > maxPayloadSize)
+        return false;
+    record.step = getUInt32(header + 4);
+    record.type = static_cast<EventType>(header[8]);
+    record.payload.resize(payloadSize);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(record.payload.data()), payloadSize));
+}
+
+Target RunLogReader::toTarget(const Record& record) {
+    checkPayloadSize(record, 4 + 3 * 8);
+    auto bytes = record.payload.data();
+    return {record.step,
+            static_cast<int32_t>(getUInt32(bytes)),
+            {{getDouble(bytes + 4), getDouble(bytes + 12), getDouble(bytes + 20)}}};
+}
+
+Threshold RunLogReader::toThreshold(const Record& record) {
+    checkPayloadSize(record, 8);
+    return {record.step, getDouble(record.payload.data())};
+}
+
+ClosestDistance RunLogReader::toClosestDistance(const Record& record) {
+    checkPayloadSize(record, 8);
+    return {record.step, getDouble(record.payload.data())};
+}
+
+RunLogData RunLogData::read(const string& path) {
+    RunLogReader reader(path);
+    RunLogData data;
+    data.sections = reader.getSections();
+    Record record;
+    while (reader.next(record)) {
+        switch (record.type) {
+            case EventType::Target:
+                data.targets.push_back(RunLogReader::toTarget(record));
+                break;
+            case EventType::Threshold:
+                data.thresholds.push_back(RunLogReader::toThreshold(record));
+                break;
+            case EventType::ClosestDistance:
+                data.closestDistances.push_back(RunLogReader::toClosestDistance(record));
+                break;
+            default:
+                /* Records of newer event types are skipped */
+                break;
+        }
+    }
+    return data;
+}
+
+void exportJson(const RunLogData& data, ostream& o) {
+    vector<string> arrays;
+
+    if (data.sections & section(EventType::ClosestDistance)) {
+        /* Only the last distance of a step was kept in the JSON logs */
+        stringstream s;
+        s << "\"closest\" : [";
+        bool first = true;
+        for (size_t i = 0; i < data.closestDistances.size(); i++) {
+            auto& d = data.closestDistances[i];
+            if (i + 1 < data.closestDistances.size() && data.closestDistances[i + 1].step == d.step)
+                continue;
+            s << (first ? "\n" : ",\n")
+              << "\t" "{ \"step\" : " << d.step << ", \"distance\" : " << d.distance << " }";
+            first = false;
+        }
+        s << "\n]";
+        arrays.push_back(s.str());
+    }
+
+    if (data.sections & section(EventType::Threshold)) {
+        stringstream s;
+        s << "\"thresholds\" : [";
+        for (size_t i = 0; i < data.thresholds.size(); i++)
+            s << (i == 0 ? "\n" : ",\n")
+              << "\t" "{ \"step\" : " << data.thresholds[i].step << ", \"coverage\" : "
+              << fixed << setprecision(2) << data.thresholds[i].coverage << " }";
+        s << "\n]";
+        arrays.push_back(s.str());
+    }
+
+    if (data.sections & section(EventType::Target)) {
+        auto targets = data.targets;
+        stable_sort(targets.begin(), targets.end(),
+                    [](const Target& a, const Target& b) { return a.id < b.id; });
+        targets.erase(unique(targets.begin(), targets.end(),
+                             [](const Target& a, const Target& b) { return a.id == b.id; }),
+                      targets.end());
+        stringstream s;
+        s << "\"targets\" : [";
+        for (size_t i = 0; i < targets.size(); i++)
+            s << (i == 0 ? "\n" : ",\n")
+              << "\t" "{ \"id\" : " << targets[i].id << ", \"step\" : " << targets[i].step
+              << ", \"position\" : [" << targets[i].position[0] << ","
+              << targets[i].position[1] << "," << targets[i].position[2] << "] }";
+        s << "\n]";
+        arrays.push_back(s.str());
+    }
+
+    o << "{\n";
+    for (size_t i = 0; i < arrays.size(); i++)
+        o << arrays[i] << (i + 1 < arrays.size() ? ",\n" : "\n");
+    o << "}";
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "RunLog.h"
+#include <fstream>
+#include <ostream>
+#include <string>
+
+/*
+ * Reads run log records one by one. An incomplete record at the end of the
+ * file, left by a run that was cut off, ends the log.
+ */
+class RunLogReader {
+public:
+    explicit RunLogReader(const std::string& path);
+
+    RunLog::Sections getSections() const { return sections; }
+    bool next(RunLog::Record& record);
+
+    static RunLog::Target toTarget(const RunLog::Record& record);
+    static RunLog::Threshold toThreshold(const RunLog::Record& record);
+    static RunLog::ClosestDistance toClosestDistance(const RunLog::Record& record);
+
+private:
+    std::ifstream file;
+    std::string path;
+    RunLog::Sections sections = 0;
+};
+
+/* All events of a run, grouped the way the JSON logs were */
+struct RunLogData {
+    RunLog::Sections sections = 0;
+    std::vector<RunLog::Target> targets;
+    std::vector<RunLog::Threshold> thresholds;
+    std::vector<RunLog::ClosestDistance> closestDistances;
+
+    static RunLogData read(const std::string& path);
+};
+
+/* Writes the JSON document the loop functions used to save at the end of a run */
+void exportJson(const RunLogData& data, std::ostream& o);
@@ -0,0 +1,212 @@
+#include "RunLogSummary.h"
+#include <argos3/core/utility/configuration/argos_exception.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+/*
+ * Columnar summary format, little-endian:
+ *
+ *     "CSSM" | uint16 version | uint16 columns | uint32 rows | columns...
+ *
+ * Every column starts with uint8 type and uint8 name length followed by the
+ * name. UInt32 and Double columns hold `rows` values. String columns hold a
+ * uint16 dictionary size, the entries as uint8 length and bytes, and `rows`
+ * uint16 dictionary codes.
+ */
+const std::array<char, 4> summaryMagic = {{'C', 'S', 'S', 'M'}};
+const uint16_t summaryVersion = 1;
+
+enum class ColumnType : uint8_t {
+    UInt32 = 1,
+    Double = 2,
+    String = 3
+};
+
+void put(ostream& o, uint8_t value) {
+    o.put(static_cast<char>(value));
+}
+
+void put(ostream& o, uint16_t value) {
+    put(o, static_cast<uint8_t>(value));
+    put(o, static_cast<uint8_t>(value >> 8));
+}
+
+void put(ostream& o, uint32_t value) {
+    for (int i = 0; i < 4; i++)
+        put(o, static_cast<uint8_t>(value >> (8 * i)));
+}
+
+void put(ostream& o, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; i++)
+        put(o, static_cast<uint8_t>(bits >> (8 * i)));
+}
+
+void putName(ostream& o, ColumnType type, const string& name) {
+    put(o, static_cast<uint8_t>(type));
+    put(o, static_cast<uint8_t>(name.size()));
+    o.write(name.data(), name.size());
+}
+
+template <typename Getter>
+void putUInt32Column(ostream& o, const string& name, const vector<RunLogSummary::Row>& rows, Getter get) {
+    putName(o, ColumnType::UInt32, name);
+    for (auto& row : rows)
+        put(o, static_cast<uint32_t>(get(row)));
+}
+
+template <typename Getter>
+void putDoubleColumn(ostream& o, const string& name, const vector<RunLogSummary::Row>& rows, Getter get) {
+    putName(o, ColumnType::Double, name);
+    for (auto& row : rows)
+        put(o, static_cast<double>(get(row)));
+}
+
+template <typename Getter>
+void putStringColumn(ostream& o, const string& name, const vector<RunLogSummary::Row>& rows, Getter get) {
+    vector<string> dictionary;
+    vector<uint16_t> codes;
+    codes.reserve(rows.size());
+    for (auto& row : rows) {
+        string value = get(row);
+        auto it = find(dictionary.begin(), dictionary.end(), value);
+        if (it == dictionary.end()) {
+            if (dictionary.size() == numeric_limits<uint16_t>::max())
+                THROW_ARGOSEXCEPTION("Too many distinct values in summary column " << name);
+            if (value.size() > numeric_limits<uint8_t>::max())
+                THROW_ARGOSEXCEPTION("Value " << value << " is too long for summary column " << name);
+            it = dictionary.insert(dictionary.end(), value);
+        }
+        codes.push_back(static_cast<uint16_t>(it - dictionary.begin()));
+    }
+    putName(o, ColumnType::String, name);
+    put(o, static_cast<uint16_t>(dictionary.size()));
+    for (auto& value : dictionary) {
+        put(o, static_cast<uint8_t>(value.size()));
+        o.write(value.data(), value.size());
+    }
+    for (auto code : codes)
+        put(o, code);
+}
+
+/* Linear interpolation between the closest ranks, as pandas does */
+double quantile(const vector<double>& sorted, double q) {
+    if (sorted.empty())
+        return numeric_limits<double>::quiet_NaN();
+    double position = q * (sorted.size() - 1);
+    auto lower = static_cast<size_t>(floor(position));
+    auto upper = min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * (position - lower);
+}
+
+}
+
+void RunLogSummary::add(const string& experiment, uint32_t robots, uint32_t targets, const RunLogData& run) {
+    auto& group = groups[Key(experiment, robots, targets)];
+    group.runs++;
+    runsNumber++;
+
+    vector<double> targetSteps;
+    for (auto& target : run.targets)
+        targetSteps.push_back(target.step);
+    sort(targetSteps.begin(), targetSteps.end());
+    for (size_t i = 0; i < targetSteps.size(); i++)
+        addSample(group.targets, i, targetSteps[i], i + 1);
+
+    for (size_t i = 0; i < run.thresholds.size(); i++)
+        addSample(group.thresholds, i, run.thresholds[i].step, run.thresholds[i].coverage);
+}
+
+void RunLogSummary::addSample(vector<Samples>& samples, size_t index, double step, double level) {
+    if (samples.size() <= index)
+        samples.resize(index + 1);
+    samples[index].steps.push_back(step);
+    samples[index].levelSum += level;
+}
+
+vector<RunLogSummary::Row> RunLogSummary::getRows() const {
+    vector<Row> rows;
+    for (auto& group : groups) {
+        for (size_t i = 0; i < group.second.targets.size(); i++)
+            rows.push_back(makeRow(group.first, group.second, Metric::Target, i, group.second.targets[i]));
+        for (size_t i = 0; i < group.second.thresholds.size(); i++)
+            rows.push_back(makeRow(group.first, group.second, Metric::Threshold, i, group.second.thresholds[i]));
+    }
+    return rows;
+}
+
+RunLogSummary::Row RunLogSummary::makeRow(const Key& key, const Group& group, Metric metric, size_t index,
+                                          const Samples& samples) {
+    auto steps = samples.steps;
+    sort(steps.begin(), steps.end());
+    const auto n = steps.size();
+
+    double mean = 0;
+    for (auto step : steps)
+        mean += step;
+    mean /= n;
+    double variance = 0;
+    for (auto step : steps)
+        variance += (step - mean) * (step - mean);
+    const double sem = n > 1 ? sqrt(variance / (n - 1) / n) : numeric_limits<double>::quiet_NaN();
+
+    return {get<0>(key), get<1>(key), get<2>(key), metric,
+            static_cast<uint32_t>(index + 1), samples.levelSum / n,
+            group.runs, static_cast<uint32_t>(n),
+            mean, sem, steps.front(), quantile(steps, 0.25), quantile(steps, 0.5), quantile(steps, 0.75), steps.back()};
+}
+
+const char* RunLogSummary::toString(Metric metric) {
+    switch (metric) {
+        case Metric::Target:
+            return "target";
+        case Metric::Threshold:
+            return "threshold";
+    }
+    return "unknown";
+}
+
+void RunLogSummary::writeCsv(ostream& o) const {
+    auto precision = o.precision(10);
+    o << "experiment,robots,targets,metric,index,level,runs,successes,mean,sem,min,q25,median,q75,max\n";
+    for (auto& row : getRows())
+        o << row.experiment << "," << row.robots << "," << row.targets << ","
+          << toString(row.metric) << "," << row.index << "," << row.level << ","
+          << row.runs << "," << row.successes << ","
+          << row.mean << "," << row.sem << "," << row.min << "," << row.q25 << ","
+          << row.median << "," << row.q75 << "," << row.max << "\n";
+    o.precision(precision);
+}
+
+void RunLogSummary::writeColumnar(ostream& o) const {
+    const auto rows = getRows();
+    const uint16_t columns = 15;
+    o.write(summaryMagic.data(), summaryMagic.size());
+    put(o, summaryVersion);
+    put(o, columns);
+    put(o, static_cast<uint32_t>(rows.size()));
+
+    putStringColumn(o, "experiment", rows, [](const Row& r) { return r.experiment; });
+    putUInt32Column(o, "robots", rows, [](const Row& r) { return r.robots; });
+    putUInt32Column(o, "targets", rows, [](const Row& r) { return r.targets; });
+    putStringColumn(o, "metric", rows, [](const Row& r) { return string(toString(r.metric)); });
+    putUInt32Column(o, "index", rows, [](const Row& r) { return r.index; });
+    putDoubleColumn(o, "level", rows, [](const Row& r) { return r.level; });
+    putUInt32Column(o, "runs", rows, [](const Row& r) { return r.runs; });
+    putUInt32Column(o, "successes", rows, [](const Row& r) { return r.successes; });
+    putDoubleColumn(o, "mean", rows, [](const Row& r) { return r.mean; });
+    putDoubleColumn(o, "sem", rows, [](const Row& r) { return r.sem; });
+    putDoubleColumn(o, "min", rows, [](const Row& r) { return r.min; });
+    putDoubleColumn(o, "q25", rows, [](const Row& r) { return r.q25; });
+    putDoubleColumn(o, "median", rows, [](const Row& r) { return r.median; });
+    putDoubleColumn(o, "q75", rows, [](const Row& r) { return r.q75; });
+    putDoubleColumn(o, "max", rows, [](const Row& r) { return r.max; });
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "RunLogReader.h"
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/*
+ * Statistics of many runs grouped by (experiment, robots, targets). For each
+ * group it keeps the step at which the n-th target was found and the step at
+ * which the n-th coverage threshold was reached in every run.
+ */
+class RunLogSummary {
+public:
+    enum class Metric : std::uint8_t {
+        Target = 1,
+        Threshold = 2
+    };
+
+    struct Row {
+        std::string experiment;
+        std::uint32_t robots;
+        std::uint32_t targets;
+        Metric metric;
+        std::uint32_t index;     // n-th target or threshold, counted from 1
+        double level;            // mean coverage for thresholds, index for targets
+        std::uint32_t runs;
+        std::uint32_t successes; // runs that reached this index
+        double mean;
+        double sem;
+        double min;
+        double q25;
+        double median;
+        double q75;
+        double max;
+    };
+
+    void add(const std::string& experiment, std::uint32_t robots, std::uint32_t targets, const RunLogData& run);
+
+    std::vector<Row> getRows() const;
+    std::size_t getRunsNumber() const { return runsNumber; }
+
+    void writeCsv(std::ostream& o) const;
+    void writeColumnar(std::ostream& o) const;
+
+    static const char* toString(Metric metric);
+
+private:
+    using Key = std::tuple<std::string, std::uint32_t, std::uint32_t>;
+
+    struct Samples {
+        std::vector<double> steps;
+        double levelSum = 0;
+    };
+
+    struct Group {
+        std::uint32_t runs = 0;
+        std::vector<Samples> targets;
+        std::vector<Samples> thresholds;
+    };
+
+    std::map<Key, Group> groups;
+    std::size_t runsNumber = 0;
+
+    static void addSample(std::vector<Samples>& samples, std::size_t index, double step, double level);
+    static Row makeRow(const Key& key, const Group& group, Metric metric, std::size_t index, const Samples& samples);
+};
@@ -0,0 +1,119 @@
+#include "RunLogWriter.h"
+#include <argos3/core/utility/configuration/argos_exception.h>
+#include <cerrno>
+#include <cstring>
+
+using namespace std;
+using namespace RunLog;
+
+RunLogWriter::~RunLogWriter() {
+    try {
+        close();
+    }
+    catch (argos::CARGoSException&) {
+        /* Nothing more can be saved at this point */
+    }
+}
+
+void RunLogWriter::open(const string& path, initializer_list<EventType> sections, uint32_t flushInterval) {
+    close();
+    this->path = path;
+    this->flushInterval = flushInterval;
+    lastFlushStep = 0;
+    file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        THROW_ARGOSEXCEPTION("Cannot open run log " << path << ": " << strerror(errno));
+    buffer.reserve(defaultBufferSize);
+
+    Sections mask = 0;
+    for (auto type : sections)
+        mask |= section(type);
+    buffer.insert(buffer.end(), magic.begin(), magic.end());
+    buffer.push_back(static_cast<uint8_t>(version));
+    buffer.push_back(static_cast<uint8_t>(version >> 8));
+    buffer.push_back(static_cast<uint8_t>(mask));
+    buffer.push_back(static_cast<uint8_t>(mask >> 8));
+    flushBuffer();
+}
+
+void RunLogWriter::close() {
+    if (file == nullptr)
+        return;
+    flushBuffer();
+    fclose(file);
+    file = nullptr;
+}
+
+void RunLogWriter::writeTarget(uint32_t step, int32_t id, double x, double y, double z) {
+    lock_guard<mutex> guard(writeMutex);
+    beginRecord(step, EventType::Target, sizeof(int32_t) + 3 * sizeof(double));
+    put(id);
+    put(x);
+    put(y);
+    put(z);
+    endRecord();
+}
+
+void RunLogWriter::writeThreshold(uint32_t step, double coverage) {
+    lock_guard<mutex> guard(writeMutex);
+    beginRecord(step, EventType::Threshold, sizeof(double));
+    put(coverage);
+    endRecord();
+}
+
+void RunLogWriter::writeClosestDistance(uint32_t step, double distance) {
+    lock_guard<mutex> guard(writeMutex);
+    beginRecord(step, EventType::ClosestDistance, sizeof(double));
+    put(distance);
+    endRecord();
+}
+
+void RunLogWriter::update(uint32_t step) {
+    if (step - lastFlushStep < flushInterval)
+        return;
+    lastFlushStep = step;
+    flush();
+}
+
+void RunLogWriter::flush() {
+    lock_guard<mutex> guard(writeMutex);
+    flushBuffer();
+}
+
+void RunLogWriter::beginRecord(uint32_t step, EventType type, uint32_t payloadSize) {
+    if (file == nullptr)
+        THROW_ARGOSEXCEPTION("Run log is not open!");
+    put(payloadSize);
+    put(step);
+    buffer.push_back(static_cast<uint8_t>(type));
+}
+
+void RunLogWriter::endRecord() {
+    if (buffer.size() >= defaultBufferSize)
+        flushBuffer();
+}
+
+void RunLogWriter::put(uint32_t value) {
+    for (int i = 0; i < 4; i++)
+        buffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+void RunLogWriter::put(int32_t value) {
+    put(static_cast<uint32_t>(value));
+}
+
+void RunLogWriter::put(double value) {
+    static_assert(sizeof(double) == sizeof(uint64_t), "Run log needs 64-bit doubles");
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; i++)
+        buffer.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+}
+
+void RunLogWriter::flushBuffer() {
+    if (file == nullptr || buffer.empty())
+        return;
+    if (fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size() || fflush(file) != 0)
+        THROW_ARGOSEXCEPTION("Cannot write run log " << path << ": " << strerror(errno));
+    buffer.clear();
+}
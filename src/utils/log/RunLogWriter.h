@@ -0,0 +1,51 @@
+#pragma once
+
+#include "RunLog.h"
+#include <cstdio>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+
+/*
+ * Appends run log records to a file. Records are buffered and written out
+ * when the buffer fills up, every flushInterval steps and on close, so a run
+ * that is cut off keeps everything up to the last flush.
+ */
+class RunLogWriter {
+public:
+    static constexpr std::size_t defaultBufferSize = 64 * 1024;
+    static constexpr std::uint32_t defaultFlushInterval = 100;
+
+    RunLogWriter() = default;
+    RunLogWriter(const RunLogWriter&) = delete;
+    RunLogWriter& operator=(const RunLogWriter&) = delete;
+    ~RunLogWriter();
+
+    void open(const std::string& path, std::initializer_list<RunLog::EventType> sections,
+              std::uint32_t flushInterval = defaultFlushInterval);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    void writeTarget(std::uint32_t step, std::int32_t id, double x, double y, double z);
+    void writeThreshold(std::uint32_t step, double coverage);
+    void writeClosestDistance(std::uint32_t step, double distance);
+
+    /* Flushes the buffer if flushInterval steps passed since the last flush */
+    void update(std::uint32_t step);
+    void flush();
+
+private:
+    std::FILE* file = nullptr;
+    std::string path;
+    std::vector<std::uint8_t> buffer;
+    std::uint32_t flushInterval = defaultFlushInterval;
+    std::uint32_t lastFlushStep = 0;
+    std::mutex writeMutex;
+
+    void beginRecord(std::uint32_t step, RunLog::EventType type, std::uint32_t payloadSize);
+    void endRecord();
+    void put(std::uint32_t value);
+    void put(std::int32_t value);
+    void put(double value);
+    void flushBuffer();
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * Robot trajectory recording format.
+ *
+ * Header:
+ *     "CSTJ" | uint16 version | uint16 reserved | double position resolution |
+ *     3 x double arena min | 3 x double arena max |
+ *     uint32 footprint size | footprint size x (3 x double) |
+ *     uint32 robots number | robots number x (uint8 id length | id)
+ *
+ * The footprint holds the ends of the coverage rays in the robot frame. It
+ * is followed by one frame per step:
+ *
+ *     uint32 step | uint32 payload size | payload
+ *
+ * The payload holds, for each robot in header order, the change of its
+ * quantized x, y and yaw since the previous frame as zigzag varints. Positions
+ * are quantized to the resolution from the header, yaw to 1/65536 of a turn.
+ * All numbers are little-endian.
+ */
+namespace Trajectory {
+
+static constexpr std::array<char, 4> magic = {{'C', 'S', 'T', 'J'}};
+static constexpr std::uint16_t version = 1;
+static constexpr std::size_t frameHeaderSize = 8;
+static constexpr double yawSteps = 65536;
+
+using Point = std::array<double, 3>;
+
+struct Pose {
+    double x;
+    double y;
+    double yaw;
+};
+
+struct Header {
+    double positionResolution;
+    Point arenaMin;
+    Point arenaMax;
+    std::vector<Point> footprint;
+    std::vector<std::string> robots;
+};
+
+}
@@ -0,0 +1,83 @@
+#include "TrajectoryReader.h"
+#include "Encoding.h"
+#include <argos3/core/utility/configuration/argos_exception.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace Encoding;
+using namespace Trajectory;
+
+TrajectoryReader::TrajectoryReader(const string& path)
+    : file(path, ios::binary)
+    , path(path)
+{
+    if (!file)
+        THROW_ARGOSEXCEPTION("Cannot open trajectory " << path);
+    char fileMagic[magic.size()];
+    read(fileMagic, sizeof(fileMagic));
+    if (!equal(magic.begin(), magic.end(), fileMagic))
+        THROW_ARGOSEXCEPTION(path << " is not a trajectory");
+    const auto fileVersion = readFixed<uint16_t>();
+    if (fileVersion != version)
+        THROW_ARGOSEXCEPTION("Trajectory " << path << " has unsupported version " << fileVersion);
+    readFixed<uint16_t>();
+
+    header.positionResolution = readFixed<double>();
+    for (auto& value : header.arenaMin)
+        value = readFixed<double>();
+    for (auto& value : header.arenaMax)
+        value = readFixed<double>();
+    header.footprint.resize(readFixed<uint32_t>());
+    for (auto& point : header.footprint)
+        for (auto& value : point)
+            value = readFixed<double>();
+    header.robots.resize(readFixed<uint32_t>());
+    for (auto& id : header.robots) {
+        id.resize(readFixed<uint8_t>());
+        read(&id[0], id.size());
+    }
+
+    quantized.assign(header.robots.size(), {{0, 0, 0}});
+    poses.assign(header.robots.size(), Pose{0, 0, 0});
+}
+
+void TrajectoryReader::read(void* bytes, size_t size) {
+    if (!file.read(static_cast<char*>(bytes), size))
+        THROW_ARGOSEXCEPTION("Trajectory " << path << " has an incomplete header");
+}
+
+template <typename T>
+T TrajectoryReader::readFixed() {
+    uint8_t bytes[sizeof(T)];
+    read(bytes, sizeof(T));
+    return getFixed<T>(bytes);
+}
+
+bool TrajectoryReader::next() {
+    uint8_t frameHeader[frameHeaderSize];
+    if (!file.read(reinterpret_cast<char*>(frameHeader), frameHeaderSize))
+        return false;
+    const auto frameStep = getFixed<uint32_t>(frameHeader);
+    payload.resize(getFixed<uint32_t>(frameHeader + 4));
+    if (!file.read(reinterpret_cast<char*>(payload.data()), payload.size()))
+        return false;
+
+    const uint8_t* bytes = payload.data();
+    const uint8_t* end = bytes + payload.size();
+    for (size_t i = 0; i < quantized.size(); i++) {
+        for (auto& value : quantized[i]) {
+            uint64_t delta;
+            if (!getVarint(bytes, end, delta))
+                THROW_ARGOSEXCEPTION("Trajectory " << path << " has a damaged frame at step " << frameStep);
+            value += unzigzag(static_cast<uint32_t>(delta));
+        }
+        quantized[i][2] &= 0xffff;
+        auto yaw = quantized[i][2] * 2 * M_PI / yawSteps;
+        poses[i] = {quantized[i][0] * header.positionResolution,
+                    quantized[i][1] * header.positionResolution,
+                    yaw > M_PI ? yaw - 2 * M_PI : yaw};
+    }
+    step = frameStep;
+    return true;
+}
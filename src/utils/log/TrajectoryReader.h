@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Trajectory.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+ * Reads a trajectory recording frame by frame. An incomplete frame at the end
+ * of the file, left by a run that was cut off, ends the trajectory.
+ */
+class TrajectoryReader {
+public:
+    explicit TrajectoryReader(const std::string& path);
+
+    const Trajectory::Header& getHeader() const { return header; }
+
+    bool next();
+    std::uint32_t getStep() const { return step; }
+    const std::vector<Trajectory::Pose>& getPoses() const { return poses; }
+
+private:
+    std::ifstream file;
+    std::string path;
+    Trajectory::Header header;
+    std::vector<std::array<std::int32_t, 3>> quantized;
+    std::vector<Trajectory::Pose> poses;
+    std::vector<std::uint8_t> payload;
+    std::uint32_t step = 0;
+
+    void read(void* bytes, std::size_t size);
+    template <typename T>
+    T readFixed();
+};
@@ -0,0 +1,112 @@
+#include "TrajectoryWriter.h"
+#include "Encoding.h"
+#include <argos3/core/utility/configuration/argos_exception.h>
+#include <cerrno>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+using namespace Encoding;
+using namespace Trajectory;
+
+namespace {
+
+int32_t quantizePosition(double value, double resolution) {
+    const auto quantized = llround(value / resolution);
+    if (quantized < numeric_limits<int32_t>::min() || quantized > numeric_limits<int32_t>::max())
+        THROW_ARGOSEXCEPTION("Position " << value << " does not fit the trajectory resolution " << resolution);
+    return static_cast<int32_t>(quantized);
+}
+
+int32_t quantizeYaw(double yaw) {
+    return static_cast<int32_t>(llround(yaw / (2 * M_PI) * yawSteps)) & 0xffff;
+}
+
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    try {
+        close();
+    }
+    catch (argos::CARGoSException&) {
+        /* Nothing more can be saved at this point */
+    }
+}
+
+void TrajectoryWriter::open(const string& path, const Header& header, uint32_t flushInterval) {
+    close();
+    if (header.positionResolution <= 0)
+        THROW_ARGOSEXCEPTION("Trajectory position resolution has to be positive");
+    this->path = path;
+    this->flushInterval = flushInterval;
+    positionResolution = header.positionResolution;
+    previous.assign(header.robots.size(), Quantized{{0, 0, 0}});
+    lastFlushStep = 0;
+    file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        THROW_ARGOSEXCEPTION("Cannot open trajectory " << path << ": " << strerror(errno));
+
+    buffer.assign(magic.begin(), magic.end());
+    putFixed(buffer, version);
+    putFixed(buffer, uint16_t(0));
+    putFixed(buffer, header.positionResolution);
+    for (auto value : header.arenaMin)
+        putFixed(buffer, value);
+    for (auto value : header.arenaMax)
+        putFixed(buffer, value);
+    putFixed(buffer, static_cast<uint32_t>(header.footprint.size()));
+    for (auto& point : header.footprint)
+        for (auto value : point)
+            putFixed(buffer, value);
+    putFixed(buffer, static_cast<uint32_t>(header.robots.size()));
+    for (auto& id : header.robots) {
+        if (id.size() > numeric_limits<uint8_t>::max())
+            THROW_ARGOSEXCEPTION("Robot id " << id << " is too long for a trajectory");
+        buffer.push_back(static_cast<uint8_t>(id.size()));
+        buffer.insert(buffer.end(), id.begin(), id.end());
+    }
+    flushBuffer();
+}
+
+void TrajectoryWriter::close() {
+    if (file == nullptr)
+        return;
+    flushBuffer();
+    fclose(file);
+    file = nullptr;
+}
+
+void TrajectoryWriter::writeFrame(uint32_t step, const vector<Pose>& poses) {
+    if (file == nullptr)
+        THROW_ARGOSEXCEPTION("Trajectory is not open!");
+    if (poses.size() != previous.size())
+        THROW_ARGOSEXCEPTION("Trajectory of " << previous.size() << " robots got " << poses.size() << " poses");
+
+    payload.clear();
+    for (size_t i = 0; i < poses.size(); i++) {
+        const Quantized current = {{quantizePosition(poses[i].x, positionResolution),
+                                    quantizePosition(poses[i].y, positionResolution),
+                                    quantizeYaw(poses[i].yaw)}};
+        putVarint(payload, zigzag(current[0] - previous[i][0]));
+        putVarint(payload, zigzag(current[1] - previous[i][1]));
+        /* The shortest way around the circle */
+        putVarint(payload, zigzag(static_cast<int16_t>(current[2] - previous[i][2])));
+        previous[i] = current;
+    }
+    putFixed(buffer, step);
+    putFixed(buffer, static_cast<uint32_t>(payload.size()));
+    buffer.insert(buffer.end(), payload.begin(), payload.end());
+
+    if (step - lastFlushStep >= flushInterval) {
+        lastFlushStep = step;
+        flushBuffer();
+    }
+}
+
+void TrajectoryWriter::flushBuffer() {
+    if (file == nullptr || buffer.empty())
+        return;
+    if (fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size() || fflush(file) != 0)
+        THROW_ARGOSEXCEPTION("Cannot write trajectory " << path << ": " << strerror(errno));
+    buffer.clear();
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Trajectory.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*
+ * Appends robot poses to a trajectory recording, one frame per step. Frames
+ * are buffered and flushed every flushInterval steps and on close.
+ */
+class TrajectoryWriter {
+public:
+    static constexpr double defaultPositionResolution = 1e-4;
+    static constexpr std::uint32_t defaultFlushInterval = 100;
+
+    TrajectoryWriter() = default;
+    TrajectoryWriter(const TrajectoryWriter&) = delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+    ~TrajectoryWriter();
+
+    void open(const std::string& path, const Trajectory::Header& header,
+              std::uint32_t flushInterval = defaultFlushInterval);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    /* Poses have to be given in the order of the header robots */
+    void writeFrame(std::uint32_t step, const std::vector<Trajectory::Pose>& poses);
+
+private:
+    using Quantized = std::array<std::int32_t, 3>;
+
+    std::FILE* file = nullptr;
+    std::string path;
+    double positionResolution = defaultPositionResolution;
+    std::vector<Quantized> previous;
+    std::vector<std::uint8_t> buffer;
+    std::vector<std::uint8_t> payload;
+    std::uint32_t flushInterval = defaultFlushInterval;
+    std::uint32_t lastFlushStep = 0;
+
+    void flushBuffer();
+};
@@ -1,5 +1,8 @@
 #include "liang-barsky.h"
 #include <cmath>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 double checkLimits(double x, double l1, double l2);
 
@@ -50,3 +53,168 @@ double checkLimits(double x, double l1, double l2) {
         newX = l2;
     return newX;
 }
+
+namespace {
+
+/* Operations of the batch kernel on one pack of doubles and on the matching comparison mask */
+struct ScalarLanes {
+    using Vector = double;
+    using Mask = bool;
+    static const std::size_t width = 1;
+
+    static Vector load(const double* p) { return *p; }
+    static void store(double* p, Vector v) { *p = v; }
+    static Vector set(double v) { return v; }
+    static Vector add(Vector a, Vector b) { return a + b; }
+    static Vector sub(Vector a, Vector b) { return a - b; }
+    static Vector mul(Vector a, Vector b) { return a * b; }
+    static Vector div(Vector a, Vector b) { return a / b; }
+    static Vector abs(Vector a) { return std::fabs(a); }
+    static Mask lessThan(Vector a, Vector b) { return a < b; }
+    static Mask greaterThan(Vector a, Vector b) { return a > b; }
+    static Mask equal(Vector a, Vector b) { return a == b; }
+    static Mask both(Mask a, Mask b) { return a && b; }
+    static Mask either(Mask a, Mask b) { return a || b; }
+    static Mask none() { return false; }
+    /* a where the mask is set, b elsewhere */
+    static Vector select(Mask m, Vector a, Vector b) { return m ? a : b; }
+    /* Bit i is set if lane i of the mask is */
+    static unsigned bits(Mask m) { return m ? 1 : 0; }
+};
+
+#if defined(__AVX__)
+struct AvxLanes {
+    using Vector = __m256d;
+    using Mask = __m256d;
+    static const std::size_t width = 4;
+
+    static Vector load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, Vector v) { _mm256_storeu_pd(p, v); }
+    static Vector set(double v) { return _mm256_set1_pd(v); }
+    static Vector add(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+    static Vector sub(Vector a, Vector b) { return _mm256_sub_pd(a, b); }
+    static Vector mul(Vector a, Vector b) { return _mm256_mul_pd(a, b); }
+    static Vector div(Vector a, Vector b) { return _mm256_div_pd(a, b); }
+    static Vector abs(Vector a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static Mask lessThan(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static Mask greaterThan(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static Mask equal(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static Mask both(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+    static Mask either(Mask a, Mask b) { return _mm256_or_pd(a, b); }
+    static Mask none() { return _mm256_setzero_pd(); }
+    static Vector select(Mask m, Vector a, Vector b) { return _mm256_blendv_pd(b, a, m); }
+    static unsigned bits(Mask m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+};
+#elif defined(__SSE2__)
+struct Sse2Lanes {
+    using Vector = __m128d;
+    using Mask = __m128d;
+    static const std::size_t width = 2;
+
+    static Vector load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, Vector v) { _mm_storeu_pd(p, v); }
+    static Vector set(double v) { return _mm_set1_pd(v); }
+    static Vector add(Vector a, Vector b) { return _mm_add_pd(a, b); }
+    static Vector sub(Vector a, Vector b) { return _mm_sub_pd(a, b); }
+    static Vector mul(Vector a, Vector b) { return _mm_mul_pd(a, b); }
+    static Vector div(Vector a, Vector b) { return _mm_div_pd(a, b); }
+    static Vector abs(Vector a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static Mask lessThan(Vector a, Vector b) { return _mm_cmplt_pd(a, b); }
+    static Mask greaterThan(Vector a, Vector b) { return _mm_cmpgt_pd(a, b); }
+    static Mask equal(Vector a, Vector b) { return _mm_cmpeq_pd(a, b); }
+    static Mask both(Mask a, Mask b) { return _mm_and_pd(a, b); }
+    static Mask either(Mask a, Mask b) { return _mm_or_pd(a, b); }
+    static Mask none() { return _mm_setzero_pd(); }
+    /* No blend before SSE4.1 */
+    static Vector select(Mask m, Vector a, Vector b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static unsigned bits(Mask m) { return static_cast<unsigned>(_mm_movemask_pd(m)); }
+};
+#endif
+
+struct Box {
+    double left, right, bottom, top;
+};
+
+/* The same as checkLimits, on every lane */
+template<class L>
+typename L::Vector checkLimitsLanes(typename L::Vector x, typename L::Vector l1, typename L::Vector l2) {
+    const auto epsilon = L::set(1e-10);
+    return L::select(L::lessThan(L::abs(L::sub(x, l1)), epsilon), l1,
+                     L::select(L::lessThan(L::abs(L::sub(x, l2)), epsilon), l2, x));
+}
+
+/*
+ * LiangBarsky on the L::width segments starting at index i. Instead of returning at the first rejecting edge, every
+ * edge is applied to every lane and the rejections are accumulated in a mask.
+ */
+template<class L>
+std::size_t clipLanes(const Box& box,
+                      const double* x0src, const double* y0src, const double* x1src, const double* y1src,
+                      double* x0clip, double* y0clip, double* x1clip, double* y1clip,
+                      std::uint8_t* accepted, std::size_t i) {
+    using Vector = typename L::Vector;
+    using Mask = typename L::Mask;
+
+    const Vector zero = L::set(0);
+    const Vector x0 = L::load(x0src + i), y0 = L::load(y0src + i);
+    const Vector xdelta = L::sub(L::load(x1src + i), x0);
+    const Vector ydelta = L::sub(L::load(y1src + i), y0);
+    const Vector left = L::set(box.left), right = L::set(box.right);
+    const Vector bottom = L::set(box.bottom), top = L::set(box.top);
+
+    /* Left, right, bottom, top edges */
+    const Vector p[4] = {L::sub(zero, xdelta), xdelta, L::sub(zero, ydelta), ydelta};
+    const Vector q[4] = {L::sub(x0, left), L::sub(right, x0), L::sub(y0, bottom), L::sub(top, y0)};
+
+    Vector t0 = zero, t1 = L::set(1);
+    Mask rejected = L::none();
+    for (int edge = 0; edge < 4; edge++) {
+        const Vector r = L::div(q[edge], p[edge]);
+        const Mask outside = L::both(L::equal(p[edge], zero), L::lessThan(q[edge], zero));
+        const Mask entering = L::lessThan(p[edge], zero);
+        const Mask leaving = L::greaterThan(p[edge], zero);
+        rejected = L::either(rejected, L::either(outside, L::either(L::both(entering, L::greaterThan(r, t1)),
+                                                                    L::both(leaving, L::lessThan(r, t0)))));
+        t0 = L::select(L::both(entering, L::greaterThan(r, t0)), r, t0);
+        t1 = L::select(L::both(leaving, L::lessThan(r, t1)), r, t1);
+    }
+
+    L::store(x0clip + i, checkLimitsLanes<L>(L::add(x0, L::mul(t0, xdelta)), left, right));
+    L::store(y0clip + i, checkLimitsLanes<L>(L::add(y0, L::mul(t0, ydelta)), bottom, top));
+    L::store(x1clip + i, checkLimitsLanes<L>(L::add(x0, L::mul(t1, xdelta)), left, right));
+    L::store(y1clip + i, checkLimitsLanes<L>(L::add(y0, L::mul(t1, ydelta)), bottom, top));
+
+    const unsigned rejectedBits = L::bits(rejected);
+    std::size_t acceptedNumber = 0;
+    for (std::size_t lane = 0; lane < L::width; lane++) {
+        accepted[i + lane] = (rejectedBits >> lane) & 1 ? 0 : 1;
+        acceptedNumber += accepted[i + lane];
+    }
+    return acceptedNumber;
+}
+
+}
+
+std::size_t LiangBarskyBatch (double edgeLeft, double edgeRight, double edgeBottom, double edgeTop,
+                              const double* x0src, const double* y0src, const double* x1src, const double* y1src,
+                              double* x0clip, double* y0clip, double* x1clip, double* y1clip,
+                              std::uint8_t* accepted, std::size_t segmentsNumber)
+{
+    const Box box{edgeLeft, edgeRight, edgeBottom, edgeTop};
+    std::size_t i = 0;
+    std::size_t acceptedNumber = 0;
+#if defined(__AVX__)
+    for (; i + AvxLanes::width <= segmentsNumber; i += AvxLanes::width)
+        acceptedNumber += clipLanes<AvxLanes>(box, x0src, y0src, x1src, y1src, x0clip, y0clip, x1clip, y1clip,
+                                              accepted, i);
+#elif defined(__SSE2__)
+    for (; i + Sse2Lanes::width <= segmentsNumber; i += Sse2Lanes::width)
+        acceptedNumber += clipLanes<Sse2Lanes>(box, x0src, y0src, x1src, y1src, x0clip, y0clip, x1clip, y1clip,
+                                               accepted, i);
+#endif
+    /* The segments that do not fill a whole pack */
+    for (; i < segmentsNumber; i++)
+        acceptedNumber += clipLanes<ScalarLanes>(box, x0src, y0src, x1src, y1src, x0clip, y0clip, x1clip, y1clip,
+                                                 accepted, i);
+    return acceptedNumber;
+}
@@ -1,5 +1,21 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 bool LiangBarsky (double edgeLeft, double edgeRight, double edgeBottom, double edgeTop,   // Define the x/y clipping values for the border.
                   double x0src, double y0src, double x1src, double y1src,                 // Define the start and end points of the line.
-                  double &x0clip, double &y0clip, double &x1clip, double &y1clip);        // The output values, so declare these outside.
\ No newline at end of file
+                  double &x0clip, double &y0clip, double &x1clip, double &y1clip);        // The output values, so declare these outside.
+
+/*
+ * Clips segmentsNumber segments at once, with the same results as LiangBarsky. The segments are given in
+ * structure-of-arrays layout: segment i goes from (x0src[i], y0src[i]) to (x1src[i], y1src[i]). The clipped ends are
+ * written to the clip arrays, which may be the source arrays themselves, and accepted[i] is set to 1 if segment i
+ * intersects the box, 0 otherwise (its clipped ends are then meaningless). Returns the number of accepted segments.
+ *
+ * Uses AVX lanes (4 segments) or SSE2 lanes (2 segments) when the compiler targets them, plain doubles otherwise.
+ */
+std::size_t LiangBarskyBatch (double edgeLeft, double edgeRight, double edgeBottom, double edgeTop,
+                              const double* x0src, const double* y0src, const double* x1src, const double* y1src,
+                              double* x0clip, double* y0clip, double* x1clip, double* y1clip,
+                              std::uint8_t* accepted, std::size_t segmentsNumber);
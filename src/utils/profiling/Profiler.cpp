@@ -0,0 +1,178 @@
+#include "Profiler.h"
+
+#ifdef COVERAGE_SEARCH_PROFILING
+
+#include <argos3/core/utility/configuration/argos_exception.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+namespace Profiler {
+
+namespace {
+
+struct Event {
+    uint64_t start;
+    uint64_t end;
+    PhaseId phase;
+};
+
+/*
+ * Only the owning thread writes the counters, so plain loads and stores are
+ * enough. They are atomic for the exports to read them without a data race.
+ */
+struct PhaseStats {
+    atomic<uint64_t> calls{0};
+    atomic<uint64_t> total{0};
+    atomic<uint64_t> max{0};
+    array<atomic<uint64_t>, histogramBuckets> buckets{};
+};
+
+struct ThreadBuffer {
+    explicit ThreadBuffer(uint32_t id) : id(id), events(eventsPerThread) {}
+
+    const uint32_t id;
+    vector<Event> events;
+    atomic<uint64_t> written{0};
+    array<PhaseStats, maxPhases> phases;
+};
+
+/* Locked only to register phases and threads, and by the exports */
+struct Registry {
+    mutex lock;
+    vector<string> phases;
+    vector<unique_ptr<ThreadBuffer>> threads;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+const auto epoch = chrono::steady_clock::now();
+thread_local ThreadBuffer* threadBuffer = nullptr;
+
+ThreadBuffer& getThreadBuffer() {
+    if (threadBuffer == nullptr) {
+        auto& r = registry();
+        lock_guard<mutex> guard(r.lock);
+        r.threads.emplace_back(new ThreadBuffer(static_cast<uint32_t>(r.threads.size())));
+        threadBuffer = r.threads.back().get();
+    }
+    return *threadBuffer;
+}
+
+void add(atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+size_t getBucket(uint64_t duration) {
+    uint64_t microseconds = duration / 1000;
+    size_t bucket = 0;
+    while (microseconds > 0 && bucket < histogramBuckets - 1) {
+        microseconds >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+}
+
+PhaseId registerPhase(const char* name) {
+    auto& r = registry();
+    lock_guard<mutex> guard(r.lock);
+    auto it = find(r.phases.begin(), r.phases.end(), name);
+    if (it != r.phases.end())
+        return static_cast<PhaseId>(it - r.phases.begin());
+    if (r.phases.size() == maxPhases)
+        THROW_ARGOSEXCEPTION("Profiler supports up to " << maxPhases << " phases, cannot add " << name);
+    r.phases.emplace_back(name);
+    return static_cast<PhaseId>(r.phases.size() - 1);
+}
+
+uint64_t now() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - epoch).count();
+}
+
+void record(PhaseId phase, uint64_t start, uint64_t end) {
+    auto& buffer = getThreadBuffer();
+    const auto written = buffer.written.load(memory_order_relaxed);
+    buffer.events[written % eventsPerThread] = {start, end, phase};
+    buffer.written.store(written + 1, memory_order_release);
+
+    const auto duration = end - start;
+    auto& stats = buffer.phases[phase];
+    add(stats.calls, 1);
+    add(stats.total, duration);
+    if (duration > stats.max.load(memory_order_relaxed))
+        stats.max.store(duration, memory_order_relaxed);
+    add(stats.buckets[getBucket(duration)], 1);
+}
+
+void exportTrace(const string& path) {
+    ofstream file(path);
+    if (!file)
+        THROW_ARGOSEXCEPTION("Cannot open profiler trace " << path);
+    auto& r = registry();
+    lock_guard<mutex> guard(r.lock);
+    file << fixed << setprecision(3) << "{\"traceEvents\":[";
+    const char* separator = "\n";
+    for (auto& thread : r.threads) {
+        file << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread->id
+             << ",\"args\":{\"name\":\"thread " << thread->id << "\"}}";
+        separator = ",\n";
+        /* Timestamps are in microseconds */
+        const auto written = thread->written.load(memory_order_acquire);
+        const auto kept = min<uint64_t>(written, eventsPerThread);
+        for (auto i = written - kept; i < written; i++) {
+            const auto& event = thread->events[i % eventsPerThread];
+            file << separator << "{\"name\":\"" << r.phases[event.phase] << "\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+                 << thread->id << ",\"ts\":" << event.start / 1e3 << ",\"dur\":" << (event.end - event.start) / 1e3
+                 << "}";
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void exportHistograms(const string& path) {
+    ofstream file(path);
+    if (!file)
+        THROW_ARGOSEXCEPTION("Cannot open profiler histograms " << path);
+    auto& r = registry();
+    lock_guard<mutex> guard(r.lock);
+    file << "phase,calls,total_us,mean_us,max_us";
+    for (size_t bucket = 0; bucket < histogramBuckets - 1; bucket++)
+        file << ",lt_" << (1ull << bucket) << "us";
+    file << ",ge_" << (1ull << (histogramBuckets - 2)) << "us\n";
+
+    file << fixed << setprecision(3);
+    for (size_t phase = 0; phase < r.phases.size(); phase++) {
+        uint64_t calls = 0, total = 0, max = 0;
+        array<uint64_t, histogramBuckets> buckets{};
+        for (auto& thread : r.threads) {
+            const auto& stats = thread->phases[phase];
+            calls += stats.calls.load(memory_order_relaxed);
+            total += stats.total.load(memory_order_relaxed);
+            max = std::max(max, stats.max.load(memory_order_relaxed));
+            for (size_t bucket = 0; bucket < histogramBuckets; bucket++)
+                buckets[bucket] += stats.buckets[bucket].load(memory_order_relaxed);
+        }
+        file << r.phases[phase] << "," << calls << "," << total / 1e3 << ","
+             << (calls > 0 ? total / 1e3 / calls : 0.0) << "," << max / 1e3;
+        for (auto count : buckets)
+            file << "," << count;
+        file << "\n";
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <string>
+
+/*
+ * Step-phase profiler.
+ *
+ * PROFILE_PHASE("name") times the rest of the enclosing scope. A finished
+ * scope is stored in a ring buffer of the calling thread, which no other
+ * thread writes to, and counted in a per-phase histogram with power-of-two
+ * microsecond buckets. The ring buffers keep the latest eventsPerThread
+ * scopes of each thread, the histograms count all of them.
+ *
+ * exportTrace writes the kept scopes as Chrome trace JSON (chrome://tracing,
+ * Perfetto), exportHistograms writes the histograms as CSV. Both have to be
+ * called when no thread is profiling anymore, e.g. from Destroy().
+ *
+ * The profiler is compiled in with COVERAGE_SEARCH_PROFILING only. Without it
+ * PROFILE_PHASE expands to nothing and the exports do nothing.
+ */
+namespace Profiler {
+
+#ifdef COVERAGE_SEARCH_PROFILING
+static constexpr bool enabled = true;
+#else
+static constexpr bool enabled = false;
+#endif
+
+/* Export paths, empty ones are skipped */
+struct Outputs {
+    std::string trace;
+    std::string histograms;
+};
+
+}
+
+#ifdef COVERAGE_SEARCH_PROFILING
+
+#include <cstdint>
+
+namespace Profiler {
+
+using PhaseId = std::uint16_t;
+
+static constexpr std::size_t maxPhases = 64;
+static constexpr std::size_t eventsPerThread = 1 << 16;
+/* Bucket 0 counts scopes under 1 us, bucket b > 0 scopes of [2^(b-1), 2^b) us */
+static constexpr std::size_t histogramBuckets = 26;
+
+/* Phases with equal names share the id */
+PhaseId registerPhase(const char* name);
+/* Nanoseconds since the profiler was loaded */
+std::uint64_t now();
+void record(PhaseId phase, std::uint64_t start, std::uint64_t end);
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(PhaseId phase) : phase(phase), start(now()) {}
+    ~ScopedTimer() { record(phase, start, now()); }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    PhaseId phase;
+    std::uint64_t start;
+};
+
+void exportTrace(const std::string& path);
+void exportHistograms(const std::string& path);
+
+}
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_PHASE(name) \
+    static const Profiler::PhaseId PROFILE_CONCAT(profilePhase, __LINE__) = Profiler::registerPhase(name); \
+    const Profiler::ScopedTimer PROFILE_CONCAT(profileTimer, __LINE__)(PROFILE_CONCAT(profilePhase, __LINE__))
+
+#else
+
+namespace Profiler {
+
+inline void exportTrace(const std::string&) {}
+inline void exportHistograms(const std::string&) {}
+
+}
+
+#define PROFILE_PHASE(name) do {} while (false)
+
+#endif
+
+namespace Profiler {
+
+inline void exportOutputs(const Outputs& outputs) {
+    if (!outputs.trace.empty())
+        exportTrace(outputs.trace);
+    if (!outputs.histograms.empty())
+        exportHistograms(outputs.histograms);
+}
+
+}
@@ -0,0 +1,19 @@
+#include "BehaviorTable.h"
+
+using namespace std;
+using namespace argos;
+
+BehaviorTable::BehaviorTable(Sensors s, Actuators a)
+    : idle(s, a)
+    , sweeper(s, a)
+    , leftExplorer(s, a)
+    , rightExplorer(s, a)
+    , behaviors{&idle, &sweeper, &leftExplorer, &rightExplorer}
+{}
+
+ControllerBehavior& BehaviorTable::get(Task::Behavior b) {
+    auto index = static_cast<size_t>(b);
+    if (index >= behaviors.size())
+        return idle;
+    return *behaviors[index];
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Task.h"
+#include "utils/task/behaviors/IdleBehavior.h"
+#include "utils/task/behaviors/LeftExplorerBehavior.h"
+#include "utils/task/behaviors/RightExplorerBehavior.h"
+#include "utils/task/behaviors/SweeperBehavior.h"
+#include <array>
+
+/*
+ * Owns one instance of every behavior, so switching a task does not allocate.
+ * Behaviors are prepared for reuse through their enter/exit hooks.
+ */
+class BehaviorTable {
+public:
+    BehaviorTable(Sensors s, Actuators a);
+    BehaviorTable(const BehaviorTable&) = delete;
+    BehaviorTable& operator=(const BehaviorTable&) = delete;
+
+    ControllerBehavior& get(Task::Behavior b);
+private:
+    static constexpr std::size_t behaviorsNumber = 4;
+
+    IdleBehavior idle;
+    SweeperBehavior sweeper;
+    LeftExplorerBehavior leftExplorer;
+    RightExplorerBehavior rightExplorer;
+    std::array<ControllerBehavior*, behaviorsNumber> behaviors;
+};
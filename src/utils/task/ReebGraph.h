@@ -17,6 +17,7 @@ public:
     ReebEdge& getEdge(std::size_t id) { return edges.at(id); }
     const ReebEdge& getEdge(std::size_t id) const { return edges.at(id); }
     TaskCell& getCell(std::size_t id) { return edges.at(id).getCell(); }
+    const TaskCell& getCell(std::size_t id) const { return edges.at(id).getCell(); }
 
     std::vector<int>& getNodes() { return nodes; }
     const std::vector<int>& getNodes() const { return nodes; }
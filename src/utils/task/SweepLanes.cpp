@@ -0,0 +1,187 @@
+#include "SweepLanes.h"
+#include <argos3/core/utility/logging/argos_log.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace argos;
+
+static const Real FOOTBOT_BODY_RADIUS = 0.085036758f;
+/* Lanes are at most one robot wide apart, so neighbouring passes touch */
+static const Real MAX_LANES_SPACING = 2 * FOOTBOT_BODY_RADIUS;
+/* Steps without getting closer to the goal after which the goal is skipped */
+static const unsigned MAX_STALLED_STEPS = 100;
+static const Real PROGRESS_EPSILON = 0.005f;
+
+
+SweepLanes::SweepLanes(size_t cellId, const CRange<CVector2>& limits)
+    : cellId(cellId)
+    , limits(limits)
+{
+    /* Both boundaries were already covered by the explorers, so only inner lanes are created */
+    auto width = limits.GetMax().GetX() - limits.GetMin().GetX();
+    auto lanesOnWidth = static_cast<size_t>(ceil(max(width, Real(0)) / MAX_LANES_SPACING));
+    lanesNumber = lanesOnWidth > 0 ? lanesOnWidth - 1 : 0;
+    lanesSpacing = width / (lanesNumber + 1);
+    if (lanesNumber > 0)
+        unassignedBlocks.push_back({0, lanesNumber});
+}
+
+Task SweepLanes::getLaneTask(size_t lane) const {
+    auto x = limits.GetMin().GetX() + (lane + 1) * lanesSpacing;
+    CVector2 top(x, limits.GetMax().GetY());
+    CVector2 bottom(x, limits.GetMin().GetY());
+    if (lane % 2 == 0)
+        return {top, bottom, Task::Behavior::Sweep, Task::Status::MoveToBegin};
+    return {bottom, top, Task::Behavior::Sweep, Task::Status::MoveToBegin};
+}
+
+SweepLanes::SpareLanes SweepLanes::findSpareLanes() const {
+    SpareLanes spare;
+    for (size_t i = 0; i < unassignedBlocks.size(); i++) {
+        auto size = unassignedBlocks[i].end - unassignedBlocks[i].first;
+        if (size > spare.size) {
+            spare.size = size;
+            spare.blockIndex = i;
+            spare.fromSweeper = false;
+        }
+    }
+    for (size_t i = 0; i < sweepers.size(); i++) {
+        /* Lanes after the current one are split, the current lane counts as half done */
+        auto& lanes = sweepers[i].lanes;
+        auto size = (lanes.end - lanes.first) / 2;
+        if (size > spare.size) {
+            spare.size = size;
+            spare.sweeperIndex = i;
+            spare.fromSweeper = true;
+        }
+    }
+    return spare;
+}
+
+size_t SweepLanes::getSpareLanesNumber() const {
+    return findSpareLanes().size;
+}
+
+Task SweepLanes::getSpareLanesTask() const {
+    auto spare = findSpareLanes();
+    if (spare.size == 0)
+        THROW_ARGOSEXCEPTION("Cell " << cellId << " has no spare lanes!");
+    if (spare.fromSweeper)
+        return getLaneTask(sweepers[spare.sweeperIndex].lanes.end - spare.size);
+    return getLaneTask(unassignedBlocks[spare.blockIndex].first);
+}
+
+bool SweepLanes::takeSpareLanes(LaneBlock& lanes) {
+    auto spare = findSpareLanes();
+    if (spare.size == 0)
+        return false;
+
+    if (spare.fromSweeper) {
+        auto& donor = sweepers[spare.sweeperIndex].lanes;
+        lanes = {donor.end - spare.size, donor.end};
+        donor.end = lanes.first;
+    }
+    else {
+        lanes = unassignedBlocks[spare.blockIndex];
+        unassignedBlocks.erase(unassignedBlocks.begin() + spare.blockIndex);
+    }
+    return true;
+}
+
+bool SweepLanes::hasSweeper(const TaskHandler& handler) const {
+    return any_of(sweepers.begin(), sweepers.end(),
+                  [&handler](const Sweeper& s) { return s.handler == &handler; });
+}
+
+vector<TaskHandler*> SweepLanes::getSweepers() const {
+    vector<TaskHandler*> handlers;
+    handlers.reserve(sweepers.size());
+    for (auto& s : sweepers)
+        handlers.push_back(s.handler);
+    return handlers;
+}
+
+void SweepLanes::addSweeper(TaskHandler& handler) {
+    Sweeper sweeper = {&handler, {0, 0}, 0, 0};
+    if (!takeSpareLanes(sweeper.lanes))
+        THROW_ARGOSEXCEPTION("Cell " << cellId << " has no spare lanes!");
+    startLane(sweeper);
+    sweepers.push_back(sweeper);
+}
+
+void SweepLanes::removeSweeper(TaskHandler& handler) {
+    auto sweeper = find_if(sweepers.begin(), sweepers.end(),
+                           [&handler](const Sweeper& s) { return s.handler == &handler; });
+    if (sweeper == sweepers.end())
+        return;
+    if (sweeper->lanes.first < sweeper->lanes.end)
+        unassignedBlocks.push_back(sweeper->lanes);
+    sweepers.erase(sweeper);
+}
+
+void SweepLanes::startLane(Sweeper& sweeper) {
+    auto task = getLaneTask(sweeper.lanes.first);
+    sweeper.goalDistance = (sweeper.handler->getPosition() - task.begin).Length();
+    sweeper.stalledSteps = 0;
+    sweeper.handler->update(task);
+}
+
+void SweepLanes::update() {
+    for (size_t i = 0; i < sweepers.size();) {
+        if (updateSweeper(sweepers[i]))
+            i++;
+        else
+            sweepers.erase(sweepers.begin() + i);
+    }
+}
+
+bool SweepLanes::updateSweeper(Sweeper& sweeper) {
+    auto task = sweeper.handler->getCurrentTask();
+    if (task.behavior != Task::Behavior::Sweep) {
+        /* The handler was given another task, its lanes go back to the cell */
+        if (sweeper.lanes.first < sweeper.lanes.end)
+            unassignedBlocks.push_back(sweeper.lanes);
+        return false;
+    }
+
+    if (task.status == Task::Status::MoveToBegin) {
+        if (isGoalReached(sweeper, task.begin)) {
+            task.status = Task::Status::Proceed;
+            sweeper.goalDistance = (sweeper.handler->getPosition() - task.end).Length();
+            sweeper.stalledSteps = 0;
+            sweeper.handler->update(task);
+        }
+        return true;
+    }
+
+    if (!isGoalReached(sweeper, task.end))
+        return true;
+
+    sweptLanesNumber++;
+    sweeper.lanes.first++;
+    if (sweeper.lanes.first < sweeper.lanes.end || takeSpareLanes(sweeper.lanes)) {
+        startLane(sweeper);
+        return true;
+    }
+
+//    LOG << "Sweeper finished lanes of cell " << cellId << endl;
+    sweeper.handler->update(Task());
+    return false;
+}
+
+bool SweepLanes::isGoalReached(Sweeper& sweeper, const CVector2& goal) {
+    Real minDistance = 0.001f;
+    auto squareDistance = (sweeper.handler->getPosition() - goal).SquareLength();
+    if (squareDistance < minDistance)
+        return true;
+
+    /* Goals behind obstacles would block the sweeper forever */
+    auto distance = sqrt(squareDistance);
+    if (distance < sweeper.goalDistance - PROGRESS_EPSILON) {
+        sweeper.goalDistance = distance;
+        sweeper.stalledSteps = 0;
+        return false;
+    }
+    return ++sweeper.stalledSteps > MAX_STALLED_STEPS;
+}
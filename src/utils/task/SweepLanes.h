@@ -0,0 +1,68 @@
+#pragma once
+
+#include "TaskHandler.h"
+#include <argos3/core/utility/math/range.h>
+#include <vector>
+
+/*
+ * Evenly spaced boustrophedon lanes of a finished cell. Lanes are parallel to
+ * the Y axis and are swept alternately downwards and upwards, so the end of
+ * one lane is next to the beginning of the following one. Every sweeper owns
+ * a block of consecutive lanes. A sweeper that runs out of lanes takes over
+ * a part of the largest block that is left.
+ */
+class SweepLanes {
+public:
+    SweepLanes(std::size_t cellId, const argos::CRange<argos::CVector2>& limits);
+
+    std::size_t getCellId() const { return cellId; }
+    std::size_t getLanesNumber() const { return lanesNumber; }
+    std::size_t getSweptLanesNumber() const { return sweptLanesNumber; }
+    std::size_t getSweepersNumber() const { return sweepers.size(); }
+    bool isSwept() const { return sweptLanesNumber == lanesNumber; }
+
+    std::size_t getSpareLanesNumber() const;
+    Task getSpareLanesTask() const;
+    bool hasSweeper(const TaskHandler& handler) const;
+    std::vector<TaskHandler*> getSweepers() const;
+
+    void addSweeper(TaskHandler& handler);
+    void removeSweeper(TaskHandler& handler);
+    void update();
+
+private:
+    struct LaneBlock {
+        std::size_t first;
+        std::size_t end;
+    };
+
+    struct Sweeper {
+        TaskHandler* handler;
+        LaneBlock lanes;
+        argos::Real goalDistance;
+        unsigned stalledSteps;
+    };
+
+    /* Lanes a new sweeper would get: a whole unassigned block or a part of a sweeper's block */
+    struct SpareLanes {
+        std::size_t size = 0;
+        std::size_t blockIndex = 0;
+        std::size_t sweeperIndex = 0;
+        bool fromSweeper = false;
+    };
+
+    std::size_t cellId;
+    argos::CRange<argos::CVector2> limits;
+    std::size_t lanesNumber;
+    std::size_t sweptLanesNumber = 0;
+    argos::Real lanesSpacing;
+    std::vector<LaneBlock> unassignedBlocks;
+    std::vector<Sweeper> sweepers;
+
+    Task getLaneTask(std::size_t lane) const;
+    SpareLanes findSpareLanes() const;
+    bool takeSpareLanes(LaneBlock& lanes);
+    void startLane(Sweeper& sweeper);
+    bool isGoalReached(Sweeper& sweeper, const argos::CVector2& goal);
+    bool updateSweeper(Sweeper& sweeper);
+};
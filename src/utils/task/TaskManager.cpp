@@ -27,8 +27,10 @@
  *              assign them as a sweepers
  *
  *      sweepers
- *          disperse evenly in the one line near edge
- *          move upwards/downwards
+ *          when the cell is finished split it into evenly spaced lanes
+ *          give every idle robot a block of lanes, closest first
+ *          sweep the lanes downwards/upwards
+ *          when a sweeper finishes early, split the largest block left
  *
  *
  */
@@ -54,6 +56,7 @@ void TaskManager::init(CRange<CVector2> limits) {
     initialLineWidth = 0;
     graph = ReebGraph();
     availableTasks.empty();
+    sweeps.clear();
 }
 
 void TaskManager::addNewCell(CVector2 beginning, int startNode)
@@ -81,6 +84,8 @@ void TaskManager::registerHandler(TaskHandler* handler) {
 void TaskManager::unregisterHandler(TaskHandler* handler) {
     lock_guard<mutex> guard(handlerAccessMutex);
     handlers.erase(remove(handlers.begin(), handlers.end(), handler));
+    for (auto& sweep : sweeps)
+        sweep.removeSweeper(*handler);
 }
 
 void TaskManager::assignTasks() {
@@ -90,8 +95,9 @@ void TaskManager::assignTasks() {
     updateCells();
 
 //    finishWaitingTasks();
-//    updateMovingHandlers();
+    updateSweeps();
     auto unassignedHandlers = getIdleWaitingHandlers();
+    releaseSweepers(unassignedHandlers);
 
 //    LOG << "TaskManager: ["
 //        << availableTasks.size() << " available tasks], ["
@@ -119,6 +125,7 @@ void TaskManager::assignTasks() {
         availableTasks.pop();
     }
 
+    assignSweepers(unassignedHandlers);
 //    LOG << "GRAPH: " << graph << endl;
 }
 
@@ -257,37 +264,74 @@ void TaskManager::initialize() {
     ready = true;
 }
 
-void TaskManager::updateMovingHandlers() {
-    for (auto handler : handlers) {
-        auto handlerTask = handler->getCurrentTask();
-        if (handlerTask.behavior == Task::Behavior::Sweep)
-            updateSweeperTask(*handler);
+void TaskManager::updateSweeps() {
+    for (size_t cellId = 0; cellId < graph.getCellsSize(); cellId++) {
+        auto& cell = graph.getCell(cellId);
+        if (cell.isFinished() && !hasSweepLanes(cellId))
+            sweeps.emplace_back(cellId, cell.getLimits());
     }
+
+    for (auto& sweep : sweeps)
+        sweep.update();
 }
 
-void TaskManager::updateSweeperTask(TaskHandler& handler) {
-    auto handlerTask = handler.getCurrentTask();
-    if (handlerTask.status == Task::Status::MoveToBegin) {
-        if (isNearGoal(handler, handlerTask.begin)) {
-            if (handlerTask.begin.GetY() == handlerTask.end.GetY())
-                handlerTask.begin.SetY(handlerTask.begin.GetY() - ROBOT_CLEARANCE_RADIUS);
-            else {
-                handlerTask.end.SetY(handlerTask.end.GetY() - ROBOT_CLEARANCE_RADIUS);
-                handlerTask.status = Task::Status::Proceed;
-            }
-            handler.update(handlerTask);
-        }
+bool TaskManager::hasSweepLanes(size_t cellId) const {
+    return any_of(sweeps.begin(), sweeps.end(),
+                  [cellId](const SweepLanes& s) { return s.getCellId() == cellId; });
+}
+
+size_t TaskManager::getWaitingExplorerTasksNumber() const {
+    size_t tasksNumber = 0;
+    auto tasks = availableTasks;
+    for (; !tasks.empty(); tasks.pop())
+        if (!graph.getCell(tasks.front().second).isFinished())
+            tasksNumber++;
+    return tasksNumber;
+}
+
+void TaskManager::releaseSweepers(HandlersList& unassignedHandlers) {
+    /* Exploration has priority, lanes of released sweepers are taken over later */
+    auto tasksNumber = getWaitingExplorerTasksNumber();
+    if (tasksNumber <= unassignedHandlers.size())
+        return;
+
+    HandlersList sweepers;
+    for (auto& sweep : sweeps)
+        for (auto handler : sweep.getSweepers())
+            sweepers.push_back(handler);
+
+    auto tasks = availableTasks;
+    for (auto missing = tasksNumber - unassignedHandlers.size(); missing > 0 && !sweepers.empty(); tasks.pop()) {
+        if (graph.getCell(tasks.front().second).isFinished())
+            continue;
+        auto closestSweeper = getClosestHandler(sweepers, tasks.front().first);
+        for (auto& sweep : sweeps)
+            sweep.removeSweeper(**closestSweeper);
+        (*closestSweeper)->update(Task());
+        unassignedHandlers.push_back(*closestSweeper);
+        sweepers.erase(closestSweeper);
+        missing--;
     }
-    else if (handlerTask.status == Task::Status::Proceed) {
-        if (isNearGoal(handler, handlerTask.end)) {
-            if (handlerTask.end.GetY() == handlerTask.begin.GetY())
-                handlerTask.end.SetY(handlerTask.end.GetY() - ROBOT_CLEARANCE_RADIUS);
-            else {
-                handlerTask.begin.SetY(handlerTask.begin.GetY() - ROBOT_CLEARANCE_RADIUS);
-                handlerTask.status = Task::Status::MoveToBegin;
+}
+
+void TaskManager::assignSweepers(HandlersList& unassignedHandlers) {
+    while (!unassignedHandlers.empty()) {
+        SweepLanes* largestSweep = nullptr;
+        size_t largestSpareLanes = 0;
+        for (auto& sweep : sweeps) {
+            auto spareLanes = sweep.getSpareLanesNumber();
+            if (spareLanes > largestSpareLanes) {
+                largestSweep = &sweep;
+                largestSpareLanes = spareLanes;
             }
-            handler.update(handlerTask);
         }
+        if (largestSweep == nullptr)
+            return;
+
+        auto closestHandler = getClosestHandler(unassignedHandlers, largestSweep->getSpareLanesTask());
+        largestSweep->addSweeper(**closestHandler);
+//        LOG << "Sweeper assigned to cell " << largestSweep->getCellId() << endl;
+        unassignedHandlers.erase(closestHandler);
     }
 }
 
@@ -300,11 +344,6 @@ TaskManager::HandlersList TaskManager::getIdleWaitingHandlers() const {
     return unassignedHandlers;
 }
 
-bool TaskManager::isNearGoal(TaskHandler& handler, const CVector2& goal) const {
-    Real minDistance = 0.001f;
-    return (handler.getPosition() - goal).SquareLength() < minDistance;
-}
-
 void TaskManager::finishWaitingTasks() {
     Task idleTask = {CVector2(), CVector2(), Task::Behavior::Idle, Task::Status::Wait};
     for(auto handler : handlers) {
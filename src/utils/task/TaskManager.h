@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ReebGraph.h"
+#include "SweepLanes.h"
 #include <argos3/core/utility/math/vector3.h>
 #include <argos3/core/utility/math/range.h>
 #include <queue>
@@ -14,6 +15,7 @@ public:
     void assignTasks();
 
     const auto getCells() const { return graph.getCells(); }
+    const std::vector<SweepLanes>& getSweeps() const { return sweeps; }
 private:
     using HandlersVector = std::vector<TaskHandler*>;
     using HandlersList = std::list<TaskHandler*>;
@@ -21,6 +23,7 @@ private:
     HandlersVector handlers;
     ReebGraph graph;
     std::queue<std::pair<Task, std::size_t>> availableTasks;
+    std::vector<SweepLanes> sweeps;
     argos::CRange<argos::CVector2> limits;
     argos::Real initialLineWidth = 0;
     bool ready = false;
@@ -32,10 +35,12 @@ private:
     void finishWaitingTasks();
 
     void updateCells();
-    void updateMovingHandlers();
-    void updateSweeperTask(TaskHandler& handler);
+    void updateSweeps();
+    bool hasSweepLanes(std::size_t cellId) const;
+    std::size_t getWaitingExplorerTasksNumber() const;
+    void releaseSweepers(HandlersList& unassignedHandlers);
+    void assignSweepers(HandlersList& unassignedHandlers);
 
-    bool isNearGoal(TaskHandler& handler, const argos::CVector2& goal) const;
     HandlersList getIdleWaitingHandlers() const;
     HandlersList::const_iterator getClosestHandler(const HandlersList& handlers, const Task& task) const;
 
@@ -1,7 +1,6 @@
 #include "AvoidObstacleBehavior.h"
+#include <argos3/core/utility/configuration/argos_exception.h>
 #include <limits>
-#include <numeric>
-#include <list>
 #include <algorithm>
 
 using namespace std;
@@ -10,18 +9,25 @@ using namespace argos;
 /* Footbot dimensions */
 static const Real BODY_RADIUS = 0.085036758f;
 
-AvoidObstacleBehavior::AvoidObstacleBehavior(Sensors s, Actuators a)
+AvoidObstacleBehavior::AvoidObstacleBehavior(Sensors s, Actuators a, CDegrees histogramAlpha)
     : ControllerBehavior(s, a)
-    , histogramAlpha(5)
-    , obstacleHistogram(static_cast<size_t>(CDegrees(360)/histogramAlpha), false)
+    , histogramAlpha(histogramAlpha)
+    , histogramSize(static_cast<size_t>(CDegrees(360)/histogramAlpha))
     , histogramThresholdHysteresis(0.12f, 0.2f)
-{}
+{
+    if (histogramSize == 0 || histogramSize > maxHistogramSize)
+        THROW_ARGOSEXCEPTION("Obstacle histogram resolution " << histogramAlpha
+                             << " gives " << histogramSize << " sectors (allowed 1-" << maxHistogramSize << ")");
+    for (size_t i = 0; i < histogramSize; i++)
+        sectorAngles[i] = (i * ToRadians(histogramAlpha)).GetValue();
+    obstacleHistogram.fill(false);
+}
 
 CVector2 AvoidObstacleBehavior::proceed() {
 //    LOG << "Avoid obstacle!" << endl;
     CDegrees closestFree(180);
-    for (size_t i = 0; i < obstacleHistogram.size(); i++) {
-        if (!obstacleHistogram.at(i)) {
+    for (size_t i = 0; i < histogramSize; i++) {
+        if (!obstacleHistogram[i]) {
             auto angleDiff = ((histogramAlpha * i) - CDegrees(0)).SignedNormalize();
             if (angleDiff.GetAbsoluteValue() < closestFree.GetAbsoluteValue())
                 closestFree = angleDiff;
@@ -41,76 +47,101 @@ bool AvoidObstacleBehavior::isRoadClear(CVector2 desiredVelocity) {
     CDegrees velocityAngle = ToDegrees(desiredVelocity.Angle()).UnsignedNormalize();
 
 //    LOG << "[";
-//    for (auto isObstacle : obstacleHistogram)
-//        LOG << (isObstacle ? "|" : ".");
+//    for (size_t i = 0; i < histogramSize; i++)
+//        LOG << (obstacleHistogram[i] ? "|" : ".");
 //    LOG << "] desired = " << velocityAngle << "\n";
 
 
     if (velocityAngle.GetValue() == 0)
         velocityAngle.SetValue(360);
-    for (size_t i = 0; i < obstacleHistogram.size(); i++) {
-        auto angle = histogramAlpha * i;
-        auto nextAngle = histogramAlpha * (i+1);
-        if (velocityAngle > angle && velocityAngle <= nextAngle) {
-            isObstacleAtDesiredAngle |= obstacleHistogram.at(i);
-            if (i + 1 < obstacleHistogram.size())
-                isObstacleAtDesiredAngle |= obstacleHistogram.at(i + 1);
-            else
-                isObstacleAtDesiredAngle |= obstacleHistogram.at(0);
-        }
+    auto i = getSectorOfAngle(velocityAngle);
+    if (i < histogramSize) {
+        isObstacleAtDesiredAngle |= obstacleHistogram[i];
+        if (i + 1 < histogramSize)
+            isObstacleAtDesiredAngle |= obstacleHistogram[i + 1];
+        else
+            isObstacleAtDesiredAngle |= obstacleHistogram[0];
     }
     return !isObstacleAtDesiredAngle;
 }
 
 void AvoidObstacleBehavior::updateObstacleHistogram() {
-    vector<list<Real>> magnitudeHistogramVariables(obstacleHistogram.size());
+    fill(magnitudeHistogram.begin(), magnitudeHistogram.begin() + histogramSize, 0);
 
-    for (auto r : sensors.proximity.GetReadings()) {
+    for (auto& r : sensors.proximity.GetReadings()) {
         auto distance = getObstacleDistanceFromFootbotProximityReading(r.Value);
         if (isinf(distance))
             continue;
 
-//        LOG << distance << ", ";
-
         const auto clearance = 0.01f;
         auto enlargementAngle = ASin((BODY_RADIUS + clearance) / distance);
+        if (isnan(enlargementAngle.GetValue())) // Obstacle closer than the robot's body radius
+            continue;
         auto lowerAngleBoundary = (r.Angle - enlargementAngle).UnsignedNormalize();
         auto upperAngleBoundary = (r.Angle + enlargementAngle).UnsignedNormalize();
-        auto isInBoundary = generateIsInBoundaryCheck(lowerAngleBoundary, upperAngleBoundary);
-
-        for (size_t i = 0; i < obstacleHistogram.size(); i++) {
-            auto angle = i * ToRadians(histogramAlpha);
-            if (isInBoundary(angle))
-                magnitudeHistogramVariables.at(i).push_back(r.Value * r.Value);
-        }
-    }
-//    LOG << "\n";
-
-    vector<Real> magnitudeHistogram(magnitudeHistogramVariables.size());
-    for (size_t i = 0; i < magnitudeHistogramVariables.size(); i++) {
-        auto& l = magnitudeHistogramVariables.at(i);
-        auto maxEl = max_element(l.begin(), l.end());
-        if (maxEl != l.end())
-            magnitudeHistogram.at(i) = *maxEl;
-//        LOG << magnitudeHistogram.at(i) << ", ";
+        addToMagnitudeHistogram(lowerAngleBoundary, upperAngleBoundary, r.Value * r.Value);
     }
-//    LOG << "\n";
-
-    fill(obstacleHistogram.begin(), obstacleHistogram.end(), false);
-    for (size_t i = 0; i < obstacleHistogram.size(); i++) {
-        if (magnitudeHistogram.at(i) > histogramThresholdHysteresis.GetMax())
-            obstacleHistogram.at(i) = true;
-        else if (magnitudeHistogram.at(i) < histogramThresholdHysteresis.GetMin())
-            obstacleHistogram.at(i) = false;
-        else if (i > 0)
-            obstacleHistogram.at(i) = obstacleHistogram.at(i - 1);
+
+    /* Hysteresis is evaluated from the first sector on, so it stays a sequential scan */
+    for (size_t i = 0; i < histogramSize; i++) {
+        if (magnitudeHistogram[i] > histogramThresholdHysteresis.GetMax())
+            obstacleHistogram[i] = true;
+        else if (magnitudeHistogram[i] < histogramThresholdHysteresis.GetMin())
+            obstacleHistogram[i] = false;
+        else
+            obstacleHistogram[i] = (i > 0) && obstacleHistogram[i - 1];
     }
 }
 
-function<bool(const CRadians&)> AvoidObstacleBehavior::generateIsInBoundaryCheck(const CRadians& lowerBoundary,
-                                                      const CRadians& upperBoundary) const {
+void AvoidObstacleBehavior::addToMagnitudeHistogram(const CRadians& lowerBoundary,
+                                                    const CRadians& upperBoundary,
+                                                    Real magnitude) {
+    auto first = getFirstSectorNotBelow(lowerBoundary);
+    auto end = getSectorsNumberNotAbove(upperBoundary);
     if (lowerBoundary < upperBoundary)
-        return [lowerBoundary, upperBoundary](const CRadians& a) { return a >= lowerBoundary && a <= upperBoundary; };
-    else
-        return [lowerBoundary, upperBoundary](const CRadians& a) { return a >= lowerBoundary || a <= upperBoundary; };
+        addToMagnitudeHistogram(first, end, magnitude);
+    else {
+        addToMagnitudeHistogram(first, histogramSize, magnitude);
+        addToMagnitudeHistogram(0, end, magnitude);
+    }
+}
+
+void AvoidObstacleBehavior::addToMagnitudeHistogram(size_t first, size_t end, Real magnitude) {
+    /* Branch-free max over a contiguous range, so the compiler can vectorize it */
+    Real* sectors = magnitudeHistogram.data();
+    for (size_t i = first; i < end; i++)
+        sectors[i] = sectors[i] < magnitude ? magnitude : sectors[i];
+}
+
+size_t AvoidObstacleBehavior::getSectorOfAngle(const CDegrees& angle) const {
+    auto estimate = ceil(angle / histogramAlpha) - 1;
+    auto i = min(static_cast<size_t>(max(estimate, Real(0))), histogramSize - 1);
+    while (i > 0 && histogramAlpha * i >= angle)
+        i--;
+    while (i < histogramSize && histogramAlpha * (i+1) < angle)
+        i++;
+    if (i < histogramSize && angle > histogramAlpha * i && angle <= histogramAlpha * (i+1))
+        return i;
+    return histogramSize;
+}
+
+size_t AvoidObstacleBehavior::getFirstSectorNotBelow(const CRadians& angle) const {
+    auto step = ToRadians(histogramAlpha).GetValue();
+    auto i = min(static_cast<size_t>(max(ceil(angle.GetValue() / step), Real(0))), histogramSize);
+    /* Correct the estimate against the exact sector angles used for comparison */
+    while (i > 0 && sectorAngles[i - 1] >= angle.GetValue())
+        i--;
+    while (i < histogramSize && sectorAngles[i] < angle.GetValue())
+        i++;
+    return i;
+}
+
+size_t AvoidObstacleBehavior::getSectorsNumberNotAbove(const CRadians& angle) const {
+    auto step = ToRadians(histogramAlpha).GetValue();
+    auto i = min(static_cast<size_t>(max(floor(angle.GetValue() / step) + 1, Real(0))), histogramSize);
+    while (i > 0 && sectorAngles[i - 1] > angle.GetValue())
+        i--;
+    while (i < histogramSize && sectorAngles[i] <= angle.GetValue())
+        i++;
+    return i;
 }
@@ -1,22 +1,36 @@
 #pragma once
 
 #include "ControllerBehavior.h"
+#include <array>
 
 class AvoidObstacleBehavior : public ControllerBehavior {
 public:
-    AvoidObstacleBehavior(Sensors s, Actuators a);
+    static constexpr std::size_t maxHistogramSize = 360;
+
+    AvoidObstacleBehavior(Sensors s, Actuators a, argos::CDegrees histogramAlpha = argos::CDegrees(5));
     argos::CVector2 proceed() override;
     argos::CVector2 prepare() override { return getDefaultVelocity(); };
     bool isRoadClear(argos::CVector2 desiredVelocity);
 
+    std::size_t getHistogramSize() const { return histogramSize; }
+    bool isObstacleInSector(std::size_t i) const { return obstacleHistogram.at(i); }
+
 private:
+    using SectorValues = std::array<argos::Real, maxHistogramSize>;
+    using SectorFlags = std::array<bool, maxHistogramSize>;
+
     const argos::CDegrees histogramAlpha;
-    std::vector<bool> obstacleHistogram;
+    const std::size_t histogramSize;
     const argos::CRange<argos::Real> histogramThresholdHysteresis;
+    SectorValues sectorAngles;
+    SectorValues magnitudeHistogram;
+    SectorFlags obstacleHistogram;
 
-    std::function<bool(const argos::CRadians&)> generateIsInBoundaryCheck(const argos::CRadians& lowerBoundary,
-                                                                          const argos::CRadians& upperBoundary) const;
     void updateObstacleHistogram();
+    void addToMagnitudeHistogram(const argos::CRadians& lowerBoundary, const argos::CRadians& upperBoundary,
+                                 argos::Real magnitude);
+    void addToMagnitudeHistogram(std::size_t first, std::size_t end, argos::Real magnitude);
+    std::size_t getSectorOfAngle(const argos::CDegrees& angle) const;
+    std::size_t getFirstSectorNotBelow(const argos::CRadians& angle) const;
+    std::size_t getSectorsNumberNotAbove(const argos::CRadians& angle) const;
 };
-
-
@@ -25,6 +25,10 @@ ControllerBehavior::ControllerBehavior(Sensors s, Actuators a)
     , actuators(a)
 {}
 
+void ControllerBehavior::enter() {
+    lastControl = lastRotation = CDegrees(0);
+}
+
 CVector2 ControllerBehavior::moveToBegin(const CVector2& beginning) {
     auto rotationAngle = myPositionToPointAngle(beginning);
     return move(rotationAngle);
@@ -76,6 +80,14 @@ void ControllerBehavior::rotate(Direction rotationDirection) {
         actuators.wheels.SetLinearVelocity(-rotationSpeed * .8, rotationSpeed);
 }
 
+void ControllerBehavior::enableBeacons() {
+    sensors.beacons.Enable();
+}
+
+void ControllerBehavior::disableBeacons() {
+    sensors.beacons.Disable();
+}
+
 CDegrees ControllerBehavior::myPositionToPointAngle(const CVector2& point) const {
     CVector2 currentPoint;
     sensors.position.GetReading().Position.ProjectOntoXY(currentPoint);
@@ -2,21 +2,18 @@
 
 #include <plugins/robots/generic/control_interface/ci_positioning_sensor.h>
 #include <plugins/robots/foot-bot/control_interface/ci_footbot_proximity_sensor.h>
-#include <argos3/plugins/robots/generic/control_interface/ci_colored_blob_perspective_camera_sensor.h>
+#include <robots/custom-foot-bot/control_interface/ci_colored_beacon_bearing_sensor.h>
 
 #include <plugins/robots/generic/control_interface/ci_differential_steering_actuator.h>
 #include <argos3/plugins/robots/generic/control_interface/ci_leds_actuator.h>
 
+#include "utils/task/Task.h"
+
 
 struct Sensors {
     argos::CCI_PositioningSensor& position;
     argos::CCI_FootBotProximitySensor& proximity;
-    struct Cameras {
-        argos::CCI_ColoredBlobPerspectiveCameraSensor& left;
-        argos::CCI_ColoredBlobPerspectiveCameraSensor& right;
-        argos::CCI_ColoredBlobPerspectiveCameraSensor& front;
-        argos::CCI_ColoredBlobPerspectiveCameraSensor& back;
-    } cameras;
+    argos::CCI_ColoredBeaconBearingSensor& beacons;
 };
 
 struct Actuators {
@@ -29,6 +26,10 @@ class ControllerBehavior {
 public:
     ControllerBehavior(Sensors s, Actuators a);
     virtual ~ControllerBehavior() = default;
+    virtual void enter();
+    virtual void exit() {}
+    virtual void updateSensors() {}
+    virtual void setTask(const Task&) {}
     virtual argos::CVector2 proceed() = 0;
     virtual argos::CVector2 prepare() = 0;
     virtual argos::CVector2 moveToBegin(const argos::CVector2& beginning);
@@ -52,6 +53,8 @@ protected:
     argos::CVector2 move(const argos::CDegrees& rotationAngle);
     void rotateForAnAngle(const argos::CDegrees& angle);
     void rotate(Direction rotationDirection);
+    void enableBeacons();
+    void disableBeacons();
     argos::CDegrees getControl(const argos::CDegrees& rotationAngle, argos::Real KP = 0.5, argos::Real KD = 0.25) const;
     Direction getRotationDirection(const argos::CDegrees& obstacleAngle) const;
 
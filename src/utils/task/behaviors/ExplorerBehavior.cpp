@@ -1,6 +1,4 @@
 #include "ExplorerBehavior.h"
-#include <list>
-#include <algorithm>
 
 
 using namespace std;
@@ -16,11 +14,21 @@ ExplorerBehavior::ExplorerBehavior(Sensors s, Actuators a,
     , fellowColor(fellowColor)
     , frontThreshold(frontThreshold)
     , frontAngleEpsilon(frontAngleEpsilon)
-{
-    sensors.cameras.left.Enable();
-    sensors.cameras.right.Enable();
-    sensors.cameras.front.Enable();
-    sensors.cameras.back.Enable();
+    , frame(s, fellowColor)
+{}
+
+void ExplorerBehavior::enter() {
+    ControllerBehavior::enter();
+    enableBeacons();
+}
+
+void ExplorerBehavior::exit() {
+    actuators.leds.Reset();
+    disableBeacons();
+}
+
+void ExplorerBehavior::updateSensors() {
+    frame.update();
 }
 
 void ExplorerBehavior::turnOnLeds() {
@@ -65,63 +73,26 @@ bool ExplorerBehavior::isConvexCP() const {
 
 bool ExplorerBehavior::isConcaveCP() const {
     return !isConvexCP() &&
-           getAccumulatedVector(getFrontProximityReadings(), frontThreshold).SquareLength() > 0 &&
+           getAccumulatedVector(SensorFrame::Sector::Front, frontThreshold).SquareLength() > 0 &&
            getFellowAngle().GetAbsoluteValue() <= frontAngleEpsilon;
 }
 
 bool ExplorerBehavior::isFellowVisible() const {
-    auto& leftBlobs = sensors.cameras.left.GetReadings().BlobList;
-    auto& frontBlobs = sensors.cameras.front.GetReadings().BlobList;
-    auto& rightBlobs = sensors.cameras.right.GetReadings().BlobList;
-    auto& backBlobs = sensors.cameras.back.GetReadings().BlobList;
-
-    auto allCameraBlobs = leftBlobs;
-    allCameraBlobs.insert(allCameraBlobs.end(), frontBlobs.begin(), frontBlobs.end());
-    allCameraBlobs.insert(allCameraBlobs.end(), rightBlobs.begin(), rightBlobs.end());
-    allCameraBlobs.insert(allCameraBlobs.end(), backBlobs.begin(), backBlobs.end());
-
-    for (auto& blob : allCameraBlobs)
-        if (blob->Color == fellowColor)
-            return true;
-    return false;
+    return frame.isFellowVisible();
 }
 
 CDegrees ExplorerBehavior::getFellowAngle() const {
-    CDegrees fellowAngle;
-    list <CDegrees> detectedFellowAngles = getFellowAngles();
-    for_each(detectedFellowAngles.begin(), detectedFellowAngles.end(), [&] (CDegrees& a) { fellowAngle += a; });
-    fellowAngle /= detectedFellowAngles.size();
-    return fellowAngle;
+    return frame.getFellowAngle();
 }
 
-list <CDegrees> ExplorerBehavior::getFellowAngles() const {
-    list<CDegrees> detectedFellowAngles;
-    for (auto& blob : sensors.cameras.left.GetReadings().BlobList)
-        if (blob->Color == fellowColor)
-            detectedFellowAngles.push_back(leftCameraOffset - CDegrees((blob->X / 10)));
-    for (auto& blob : sensors.cameras.front.GetReadings().BlobList)
-        if (blob->Color == fellowColor)
-            detectedFellowAngles.push_back(frontCameraOffset - CDegrees((blob->X / 10)));
-    for (auto& blob : sensors.cameras.right.GetReadings().BlobList)
-        if (blob->Color == fellowColor)
-            detectedFellowAngles.push_back(rightCameraOffset - CDegrees((blob->X / 10)));
-    for (auto& blob : sensors.cameras.back.GetReadings().BlobList)
-        if (blob->Color == fellowColor)
-            detectedFellowAngles.push_back((backCameraOffset - CDegrees((blob->X / 10))).SignedNormalize());
-    return detectedFellowAngles;
+const vector<CDegrees>& ExplorerBehavior::getFellowAngles() const {
+    return frame.getFellowAngles();
 }
 
-CCI_FootBotProximitySensor::TReadings ExplorerBehavior::getFrontProximityReadings() const {
-    const auto& readings = sensors.proximity.GetReadings();
-    CCI_FootBotProximitySensor::TReadings frontReadings(readings.begin() + 22, readings.end());
-    frontReadings.insert(frontReadings.end(), readings.begin(), readings.begin() + 2);
-    return frontReadings;
+ReadingsView ExplorerBehavior::getFrontProximityReadings() const {
+    return frame.getProximityReadings(SensorFrame::Sector::Front);
 }
 
-CVector2 ExplorerBehavior::getAccumulatedVector(const CCI_FootBotProximitySensor::TReadings& readings, Real threshold) const {
-    CVector2 accumulator;
-    for (auto& r : readings)
-        if (r.Value >= threshold)
-            accumulator += CVector2(r.Value, r.Angle);
-    return accumulator;
+CVector2 ExplorerBehavior::getAccumulatedVector(SensorFrame::Sector sector, Real threshold) const {
+    return frame.getAccumulatedVector(sector, threshold);
 }
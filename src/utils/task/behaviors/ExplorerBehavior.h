@@ -1,8 +1,8 @@
 #pragma once
 
 #include "ControllerBehavior.h"
+#include "SensorFrame.h"
 #include <core/utility/math/vector2.h>
-#include <list>
 
 
 class ExplorerBehavior : public ControllerBehavior {
@@ -14,6 +14,9 @@ public:
                      argos::Real frontAngleEpsilon = 2);
     virtual ~ExplorerBehavior() = default;
 
+    virtual void enter() override;
+    virtual void exit() override;
+    virtual void updateSensors() override;
     virtual argos::CVector2 proceed() override;
 
     virtual bool isCriticalPoint() const override;
@@ -27,22 +30,16 @@ protected:
     argos::CColor fellowColor;
     argos::Real frontThreshold;
     argos::Real frontAngleEpsilon;
+    SensorFrame frame;
 
     virtual argos::CDegrees getRotationAngle() const = 0;
 
     void turnOnLeds();
     bool isFellowVisible() const;
     argos::CDegrees getFellowAngle() const;
-    std::list<argos::CDegrees> getFellowAngles() const;
-    argos::CVector2 getAccumulatedVector(const argos::CCI_FootBotProximitySensor::TReadings& readings,
-                                         argos::Real threshold) const;
-    argos::CCI_FootBotProximitySensor::TReadings getFrontProximityReadings() const;
-
-private:
-    const argos::CDegrees leftCameraOffset = argos::CDegrees(135);
-    const argos::CDegrees frontCameraOffset = argos::CDegrees(45);
-    const argos::CDegrees rightCameraOffset = argos::CDegrees(-45);
-    const argos::CDegrees backCameraOffset = argos::CDegrees(-135);
+    const std::vector<argos::CDegrees>& getFellowAngles() const;
+    argos::CVector2 getAccumulatedVector(SensorFrame::Sector sector, argos::Real threshold) const;
+    ReadingsView getFrontProximityReadings() const;
 };
 
 
@@ -5,13 +5,10 @@
 class IdleBehavior : public ControllerBehavior {
 public:
     IdleBehavior(Sensors s, Actuators a) : ControllerBehavior(s, a) {}
-    void stop() override {
+    void enter() override {
+        ControllerBehavior::enter();
         actuators.leds.Reset();
-        sensors.cameras.left.Disable();
-        sensors.cameras.right.Disable();
-        sensors.cameras.front.Disable();
-        sensors.cameras.back.Disable();
-        ControllerBehavior::stop();
+        disableBeacons();
     }
     argos::CVector2 prepare() override { return argos::CVector2(); }
     argos::CVector2 proceed() override { return argos::CVector2(); }
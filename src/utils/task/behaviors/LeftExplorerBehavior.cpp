@@ -7,6 +7,11 @@ LeftExplorerBehavior::LeftExplorerBehavior(Sensors s, Actuators a)
     : ExplorerBehavior(s, a, CColor::GREEN, CColor::RED)
 {}
 
+void LeftExplorerBehavior::enter() {
+    ExplorerBehavior::enter();
+    hitWall = false;
+}
+
 CVector2 LeftExplorerBehavior::prepare() {
     ExplorerBehavior::turnOnLeds();
     
@@ -24,14 +29,14 @@ CVector2 LeftExplorerBehavior::prepare() {
         return getDefaultVelocity().Rotate(ToRadians(controlAngle));
     }
     else if (!hitWall) {
-        hitWall = getAccumulatedVector(getFrontProximityReadings(), frontThreshold).SquareLength() > 0;
+        hitWall = getAccumulatedVector(SensorFrame::Sector::Front, frontThreshold).SquareLength() > 0;
 //        LOG << "FLEFT move\n";
         return move(CDegrees(0));
     }
 }
 
 bool LeftExplorerBehavior::isForwardConvexCP() const {
-    auto angles = getFellowAngles();
+    const auto& angles = getFellowAngles();
     auto myAngle = getOrientationOnXY();
     auto threshold = 0.1f;
     for (auto& a : angles) {
@@ -40,7 +45,7 @@ bool LeftExplorerBehavior::isForwardConvexCP() const {
         if (realAngle < CDegrees(90) && realAngle > CDegrees(-90)) {
             const auto& readings = sensors.proximity.GetReadings();
             array<Real, 2> proximityValues = {-1, -1};
-            auto unsignedAngle = a.UnsignedNormalize();
+            auto unsignedAngle = CDegrees(a).UnsignedNormalize();
             for (size_t i = 0; i < readings.size(); i++) {
                 if (i+1 < readings.size())
                     if (unsignedAngle > ToDegrees(readings.at(i).Angle).UnsignedNormalize() &&
@@ -69,13 +74,13 @@ bool LeftExplorerBehavior::isForwardConvexCP() const {
 bool LeftExplorerBehavior::isReadyToProceed() const {
     if(!hitWall)
         return false;
-    return getAccumulatedVector(getLeftProximityReadings(), sideThreshold).SquareLength() > 0;
+    return getAccumulatedVector(SensorFrame::Sector::Left, sideThreshold).SquareLength() > 0;
 }
 
 CDegrees LeftExplorerBehavior::getRotationAngle() const {
-    auto accumulator = getAccumulatedVector(getFrontProximityReadings(), frontThreshold);
+    auto accumulator = getAccumulatedVector(SensorFrame::Sector::Front, frontThreshold);
     if (accumulator.SquareLength() == 0)
-        accumulator = getAccumulatedVector(getLeftProximityReadings(), sideThreshold);
+        accumulator = getAccumulatedVector(SensorFrame::Sector::Left, sideThreshold);
 
     size_t howManyRaysDetectObstacle = 0;
     for (auto& r : getLeftProximityReadings())
@@ -91,7 +96,6 @@ CDegrees LeftExplorerBehavior::getRotationAngle() const {
     }
 }
 
-CCI_FootBotProximitySensor::TReadings LeftExplorerBehavior::getLeftProximityReadings() const {
-    const auto& readings = sensors.proximity.GetReadings();
-    return CCI_FootBotProximitySensor::TReadings(readings.begin() + 4, readings.begin() + 8);
+ReadingsView LeftExplorerBehavior::getLeftProximityReadings() const {
+    return frame.getProximityReadings(SensorFrame::Sector::Left);
 }
@@ -7,13 +7,14 @@ class LeftExplorerBehavior : public ExplorerBehavior {
     const argos::Real sideThreshold = 0.1;
 public:
     LeftExplorerBehavior(Sensors s, Actuators a);
+    void enter() override;
     argos::CVector2 prepare() override;
     bool isForwardConvexCP() const override;
     bool isReadyToProceed() const override;
 
 protected:
     argos::CDegrees getRotationAngle() const;
-    argos::CCI_FootBotProximitySensor::TReadings getLeftProximityReadings() const;
+    ReadingsView getLeftProximityReadings() const;
 
 private:
     bool hitWall = false;
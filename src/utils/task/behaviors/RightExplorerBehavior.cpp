@@ -7,6 +7,11 @@ RightExplorerBehavior::RightExplorerBehavior(Sensors s, Actuators a)
     : ExplorerBehavior(s, a, CColor::RED, CColor::GREEN)
 {}
 
+void RightExplorerBehavior::enter() {
+    ExplorerBehavior::enter();
+    hitWall = false;
+}
+
 CVector2 RightExplorerBehavior::prepare() {
     ExplorerBehavior::turnOnLeds();
 
@@ -23,13 +28,13 @@ CVector2 RightExplorerBehavior::prepare() {
         return getDefaultVelocity().Rotate(ToRadians(controlAngle));
     }
     else if (!hitWall) {
-        hitWall = getAccumulatedVector(getFrontProximityReadings(), frontThreshold).SquareLength() > 0;
+        hitWall = getAccumulatedVector(SensorFrame::Sector::Front, frontThreshold).SquareLength() > 0;
         return move(CDegrees(0));
     }
 }
 
 bool RightExplorerBehavior::isForwardConvexCP() const {
-    auto angles = getFellowAngles();
+    const auto& angles = getFellowAngles();
     auto myAngle = getOrientationOnXY();
     auto threshold = 0.1f;
     for (auto& a : angles) {
@@ -38,7 +43,7 @@ bool RightExplorerBehavior::isForwardConvexCP() const {
         if (realAngle > CDegrees(90) || realAngle < CDegrees(-90)) {
             const auto& readings = sensors.proximity.GetReadings();
             array<Real, 2> proximityValues = {-1, -1};
-            auto unsignedAngle = a.UnsignedNormalize();
+            auto unsignedAngle = CDegrees(a).UnsignedNormalize();
             for (size_t i = 0; i < readings.size(); i++) {
                 if (i+1 < readings.size() &&
                     unsignedAngle > ToDegrees(readings.at(i).Angle).UnsignedNormalize() &&
@@ -61,13 +66,13 @@ bool RightExplorerBehavior::isForwardConvexCP() const {
 bool RightExplorerBehavior::isReadyToProceed() const {
     if(!hitWall)
         return false;
-    return getAccumulatedVector(getRightProximityReadings(), sideThreshold).SquareLength() > 0;
+    return getAccumulatedVector(SensorFrame::Sector::Right, sideThreshold).SquareLength() > 0;
 }
 
 CDegrees RightExplorerBehavior::getRotationAngle() const {
-    auto accumulator = getAccumulatedVector(getFrontProximityReadings(), frontThreshold);
+    auto accumulator = getAccumulatedVector(SensorFrame::Sector::Front, frontThreshold);
     if (accumulator.SquareLength() == 0)
-        accumulator = getAccumulatedVector(getRightProximityReadings(), sideThreshold);
+        accumulator = getAccumulatedVector(SensorFrame::Sector::Right, sideThreshold);
 
     size_t howManyRaysDetectObstacle = 0;
     for (auto& r : getRightProximityReadings())
@@ -83,7 +88,6 @@ CDegrees RightExplorerBehavior::getRotationAngle() const {
     }
 }
 
-CCI_FootBotProximitySensor::TReadings RightExplorerBehavior::getRightProximityReadings() const {
-    const auto& readings = sensors.proximity.GetReadings();
-    return CCI_FootBotProximitySensor::TReadings(readings.begin() + 16, readings.begin() + 20);
+ReadingsView RightExplorerBehavior::getRightProximityReadings() const {
+    return frame.getProximityReadings(SensorFrame::Sector::Right);
 }
@@ -7,13 +7,14 @@ class RightExplorerBehavior : public ExplorerBehavior {
     const argos::Real sideThreshold = 0.1;
 public:
     RightExplorerBehavior(Sensors s, Actuators a);
+    void enter() override;
     argos::CVector2 prepare() override;
     bool isForwardConvexCP() const override;
     bool isReadyToProceed() const override;
 
 protected:
     argos::CDegrees getRotationAngle() const;
-    argos::CCI_FootBotProximitySensor::TReadings getRightProximityReadings() const;
+    ReadingsView getRightProximityReadings() const;
 
 private:
     bool hitWall = false;
@@ -0,0 +1,62 @@
+#include "SensorFrame.h"
+
+using namespace std;
+using namespace argos;
+
+/* Proximity ring layout: first reading and number of readings for each sector */
+static const array<pair<size_t, size_t>, 3> SECTORS = {{
+    {22, 4}, // Front
+    {4, 4},  // Left
+    {16, 4}  // Right
+}};
+/* LEDs of a foot-bot */
+static const size_t FELLOW_ANGLES_CAPACITY = 16;
+
+SensorFrame::SensorFrame(Sensors sensors, CColor fellowColor)
+    : sensors(sensors)
+    , fellowColor(fellowColor)
+{
+    fellowAngles.reserve(FELLOW_ANGLES_CAPACITY);
+}
+
+void SensorFrame::update() {
+    fellowAngles.clear();
+    for (auto& beacon : sensors.beacons.GetReadings())
+        if (beacon.Color == fellowColor)
+            fellowAngles.push_back(ToDegrees(beacon.Bearing));
+
+    fellowAngle = CDegrees();
+    for (auto& a : fellowAngles)
+        fellowAngle += a;
+    fellowAngle /= fellowAngles.size();
+
+    sectorSumsNumber = 0;
+}
+
+const ReadingsView::Readings& SensorFrame::getProximityReadings() const {
+    return sensors.proximity.GetReadings();
+}
+
+ReadingsView SensorFrame::getProximityReadings(Sector sector) const {
+    auto& range = SECTORS.at(static_cast<size_t>(sector));
+    return ReadingsView(getProximityReadings(), range.first, range.second);
+}
+
+CVector2 SensorFrame::getAccumulatedVector(Sector sector, Real threshold) const {
+    for (size_t i = 0; i < sectorSumsNumber; i++)
+        if (sectorSums[i].sector == sector && sectorSums[i].threshold == threshold)
+            return sectorSums[i].sum;
+
+    auto sum = calculateAccumulatedVector(sector, threshold);
+    if (sectorSumsNumber < sectorSums.size())
+        sectorSums[sectorSumsNumber++] = {sector, threshold, sum};
+    return sum;
+}
+
+CVector2 SensorFrame::calculateAccumulatedVector(Sector sector, Real threshold) const {
+    CVector2 accumulator;
+    for (auto& r : getProximityReadings(sector))
+        if (r.Value >= threshold)
+            accumulator += CVector2(r.Value, r.Angle);
+    return accumulator;
+}
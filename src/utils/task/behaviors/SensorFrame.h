@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ControllerBehavior.h"
+#include <array>
+#include <vector>
+
+/*
+ * Non-owning view on consecutive proximity readings. The range may wrap
+ * around the end of the sensor ring.
+ */
+class ReadingsView {
+public:
+    using Readings = argos::CCI_FootBotProximitySensor::TReadings;
+    using Reading = argos::CCI_FootBotProximitySensor::SReading;
+
+    class Iterator {
+    public:
+        Iterator(const Readings& readings, std::size_t first, std::size_t offset)
+            : readings(&readings), first(first), offset(offset) {}
+        const Reading& operator*() const { return (*readings)[(first + offset) % readings->size()]; }
+        const Reading* operator->() const { return &**this; }
+        Iterator& operator++() { offset++; return *this; }
+        bool operator!=(const Iterator& other) const { return offset != other.offset; }
+    private:
+        const Readings* readings;
+        std::size_t first;
+        std::size_t offset;
+    };
+
+    ReadingsView(const Readings& readings, std::size_t first, std::size_t count)
+        : readings(readings), first(first), count(count) {}
+    Iterator begin() const { return Iterator(readings, first, 0); }
+    Iterator end() const { return Iterator(readings, first, count); }
+    std::size_t size() const { return count; }
+
+private:
+    const Readings& readings;
+    std::size_t first;
+    std::size_t count;
+};
+
+/*
+ * Sensor data derived once per control step and shared by all queries
+ * an explorer makes during that step.
+ */
+class SensorFrame {
+public:
+    enum class Sector { Front = 0, Left, Right };
+
+    SensorFrame(Sensors sensors, argos::CColor fellowColor);
+    void update();
+
+    bool isFellowVisible() const { return !fellowAngles.empty(); }
+    const std::vector<argos::CDegrees>& getFellowAngles() const { return fellowAngles; }
+    argos::CDegrees getFellowAngle() const { return fellowAngle; }
+
+    const ReadingsView::Readings& getProximityReadings() const;
+    ReadingsView getProximityReadings(Sector sector) const;
+    argos::CVector2 getAccumulatedVector(Sector sector, argos::Real threshold) const;
+
+private:
+    struct SectorSum {
+        Sector sector;
+        argos::Real threshold;
+        argos::CVector2 sum;
+    };
+    static constexpr std::size_t maxSectorSums = 8;
+
+    Sensors sensors;
+    const argos::CColor fellowColor;
+    std::vector<argos::CDegrees> fellowAngles;
+    argos::CDegrees fellowAngle;
+    mutable std::array<SectorSum, maxSectorSums> sectorSums;
+    mutable std::size_t sectorSumsNumber = 0;
+
+    argos::CVector2 calculateAccumulatedVector(Sector sector, argos::Real threshold) const;
+};
@@ -1 +1,18 @@
 #include "SweeperBehavior.h"
+
+using namespace std;
+using namespace argos;
+
+
+void SweeperBehavior::setTask(const Task& task) {
+    laneBeginning = task.begin;
+    laneEnd = task.end;
+}
+
+CVector2 SweeperBehavior::prepare() {
+    return move(myPositionToPointAngle(laneBeginning));
+}
+
+CVector2 SweeperBehavior::proceed() {
+    return move(myPositionToPointAngle(laneEnd));
+}
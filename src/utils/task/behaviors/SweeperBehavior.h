@@ -2,11 +2,16 @@
 
 #include "ControllerBehavior.h"
 
+/*
+ * Drives along a single lane, from the task beginning to its end.
+ */
 class SweeperBehavior : public ControllerBehavior {
 public:
     using ControllerBehavior::ControllerBehavior;
-    argos::CVector2 prepare() override { return argos::CVector2(); }
-    argos::CVector2 proceed() override { return argos::CVector2(); }
+    void setTask(const Task& task) override;
+    argos::CVector2 prepare() override;
+    argos::CVector2 proceed() override;
+private:
+    argos::CVector2 laneBeginning;
+    argos::CVector2 laneEnd;
 };
-
-
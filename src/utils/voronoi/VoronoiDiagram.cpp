@@ -1,5 +1,6 @@
 #include "VoronoiDiagram.h"
 #include <utils/math/liang-barsky.h>
+#include <utils/profiling/Profiler.h>
 #include <argos3/core/utility/logging/argos_log.h>
 
 #include "assert.h"
@@ -17,16 +18,18 @@ void VoronoiDiagram::calculate(map<string, CVector3> points) {
     updateVoronoiDiagram();
 }
 
-void VoronoiDiagram::calculate(map<string, CVector3> points, const vector<vector<CoverageCell>>& grid) {
+void VoronoiDiagram::calculate(map<string, CVector3> points, const CoverageGrid& grid) {
     calculate(move(points));
+    PROFILE_PHASE("ownership");
     for (auto& cell : cells)
-        for (int i = 0; i < grid.size(); i++)
-            for (int j = 0; j < grid.at(i).size(); j++)
-                if (cell.isInside(grid.at(i).at(j).center))
+        for (unsigned i = 0; i < grid.getWidth(); i++)
+            for (unsigned j = 0; j < grid.getHeight(); j++)
+                if (cell.isInside(grid.getCellCenter({i, j})))
                     cell.coverageCells.emplace_back(i, j);
 }
 
 void VoronoiDiagram::reset() {
+    generation++;
     seeds.clear();
     boostPoints.clear();
     cells.clear();
@@ -61,27 +64,27 @@ argos::CVector3 VoronoiDiagram::ToVector3(const Vertex& point) const {
 
 void VoronoiDiagram::updateEdges(const Diagram& diagram) {
     //LOG << "Boost voronoi has " << diagram.cells().size() << " cells\n";
+    vector<CRay3> edges;
+    vector<size_t> edgesCells;
     for (auto& cell : diagram.cells()) {
         assert(cell.contains_point()); // Cell should be created by point seed
         const voronoi_diagram<Real>::edge_type* edge = cell.incident_edge();
         assert(edge->is_linear()); // For points all edges should be linear
         assert(edge != nullptr);
         cells.emplace_back(seeds.at(cell.source_index()), diagramLiftOnZ);
-        auto& lastCell = cells.at(cells.size() - 1);
         do {
             if (edge->is_primary()) {
-                auto voronoiEdge = ToVoronoiEdge(*edge);
-                try {
-                    voronoiEdge = getRayBoundedToArena(voronoiEdge);
-                    lastCell.addEdge(move(voronoiEdge));
-                }
-                catch(EdgeNotInArea& e) {
-                    // Do not add this edge
-                }
+                edges.push_back(ToVoronoiEdge(*edge));
+                edgesCells.push_back(cells.size() - 1);
             }
             edge = edge->next();
         } while (edge != cell.incident_edge());
     }
+    /* Edges outside of the arena are not added */
+    auto accepted = boundEdgesToArena(edges);
+    for (size_t i = 0; i < edges.size(); i++)
+        if (accepted[i])
+            cells.at(edgesCells[i]).addEdge(move(edges[i]));
 }
 
 CRay3 VoronoiDiagram::ToVoronoiEdge(const Edge& edge) const {
@@ -130,22 +133,32 @@ CRay3 VoronoiDiagram::ToVoronoiEdge(const Edge& edge) const {
     return voronoiEdge;
 }
 
-CRay3 VoronoiDiagram::getRayBoundedToArena(const CRay3 &ray) const {
-    Real startX, startY, endX, endY;
-    bool edgeWasClipped = LiangBarsky(
-            arenaLimits.GetMin().GetX(),
-            arenaLimits.GetMax().GetX(),
-            arenaLimits.GetMin().GetY(),
-            arenaLimits.GetMax().GetY(),
-            ray.GetStart().GetX(), ray.GetStart().GetY(),
-            ray.GetEnd().GetX(), ray.GetEnd().GetY(),
-            startX, startY, endX, endY);
-
-    if (!edgeWasClipped)
-        throw EdgeNotInArea();
-    CRay3 boundedRay(CVector3(startX, startY, diagramLiftOnZ),
-                     CVector3(endX, endY, diagramLiftOnZ));\
-    return boundedRay;
+vector<uint8_t> VoronoiDiagram::boundEdgesToArena(vector<CRay3>& edges) const {
+    const size_t edgesNumber = edges.size();
+    vector<double> coordinates(4 * edgesNumber);
+    double* startX = coordinates.data();
+    double* startY = startX + edgesNumber;
+    double* endX = startY + edgesNumber;
+    double* endY = endX + edgesNumber;
+    for (size_t i = 0; i < edgesNumber; i++) {
+        startX[i] = edges[i].GetStart().GetX();
+        startY[i] = edges[i].GetStart().GetY();
+        endX[i] = edges[i].GetEnd().GetX();
+        endY[i] = edges[i].GetEnd().GetY();
+    }
+
+    vector<uint8_t> accepted(edgesNumber);
+    LiangBarskyBatch(arenaLimits.GetMin().GetX(), arenaLimits.GetMax().GetX(),
+                     arenaLimits.GetMin().GetY(), arenaLimits.GetMax().GetY(),
+                     startX, startY, endX, endY,
+                     startX, startY, endX, endY,
+                     accepted.data(), edgesNumber);
+
+    for (size_t i = 0; i < edgesNumber; i++)
+        if (accepted[i])
+            edges[i].Set(CVector3(startX[i], startY[i], diagramLiftOnZ),
+                         CVector3(endX[i], endY[i], diagramLiftOnZ));
+    return accepted;
 }
 
 void VoronoiDiagram::setArenaLimits(CRange<CVector3> limits) {
@@ -2,7 +2,8 @@
 
 #include <boost/polygon/point_data.hpp>
 #include <boost/polygon/voronoi.hpp>
-#include <utils/coverage/CoverageCell.h>
+#include <cstdint>
+#include <utils/coverage/CoverageGrid.h>
 #include "VoronoiCell.h"
 
 class VoronoiDiagram {
@@ -10,11 +11,13 @@ public:
     using Cell = VoronoiCell;
 
     void calculate(std::map<std::string, argos::CVector3> points);
-    void calculate(std::map<std::string, argos::CVector3> points, const std::vector<std::vector<CoverageCell>>& grid);
+    void calculate(std::map<std::string, argos::CVector3> points, const CoverageGrid& grid);
     void setArenaLimits(argos::CRange<argos::CVector3> limits);
     std::vector<argos::CVector3> getVertices() const;
     std::vector<argos::CRay3> getEdges() const;
     const std::vector<Cell>& getCells() const;
+    /* Changes every time the diagram is calculated */
+    std::size_t getGeneration() const { return generation; }
 
 private:
     using CoordinateType = argos::Real;
@@ -23,17 +26,13 @@ private:
     using Vertex = boost::polygon::voronoi_vertex<CoordinateType>;
     using Edge = boost::polygon::voronoi_edge<CoordinateType>;
 
-    class EdgeNotInArea : public std::logic_error {
-    public:
-        EdgeNotInArea() : std::logic_error("Edge not in area") {}
-    };
-
     const int scaleVectorToMilimeters = 100000;
     const argos::Real diagramLiftOnZ = 0.02f;
     argos::CRange<argos::CVector3> arenaLimits;
     std::vector<Cell::Seed> seeds;
     std::vector<Point> boostPoints;
     std::vector<Cell> cells;
+    std::size_t generation = 0;
 
     void reset();
     void updateVoronoiDiagram();
@@ -43,5 +42,6 @@ private:
     Point ToPoint(const argos::CVector3& vec) const;
     argos::CVector3 ToVector3(const Vertex& vertex) const;
     argos::CRay3 ToVoronoiEdge(const Edge& edge) const;
-    argos::CRay3 getRayBoundedToArena(const argos::CRay3 &ray) const;
+    /* Clips the edges to the arena in place, the returned flags tell which ones are at least partly inside it */
+    std::vector<std::uint8_t> boundEdgesToArena(std::vector<argos::CRay3>& edges) const;
 };